@@ -58,6 +58,7 @@ option(OSSIA_PROTOCOL_MINUIT "Enable Minuit protocol" ON)
 option(OSSIA_PROTOCOL_OSCQUERY "Enable OSCQuery protocol" ON)
 option(OSSIA_PROTOCOL_MQTT5 "Enable MQTT 5 protocol" ON)
 option(OSSIA_PROTOCOL_COAP "Enable CoAP protocol" ON)
+option(OSSIA_PROTOCOL_SHMEM "Enable shared memory protocol" ON) # POSIX only
 option(OSSIA_PROTOCOL_HTTP "Enable HTTP protocol" ON) # Requires Qt
 option(OSSIA_PROTOCOL_WEBSOCKETS "Enable WebSockets protocol" OFF) # Requires Qt
 option(OSSIA_PROTOCOL_SERIAL "Enable Serial port protocol" OFF) # Requires Qt
@@ -91,6 +92,7 @@ set(OSSIA_AVAILABLE_PROTOCOLS
   LIBMAPPER
   MQTT5
   COAP
+  SHMEM
 )
 
 set(CMAKE_MODULE_PATH "${CMAKE_MODULE_PATH};${PROJECT_SOURCE_DIR}/CMake;${PROJECT_SOURCE_DIR}/cmake/cmake-modules;")
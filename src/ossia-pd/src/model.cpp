@@ -149,6 +149,13 @@ void model::register_children()
     }
   }
 
+  // during a registration batch, the quarantine is only retried at the end
+  if(ossia_pd::instance().m_registration_batch > 0)
+  {
+    ossia_pd::instance().m_quarantine_retry = true;
+    return;
+  }
+
   for(auto param : parameter::quarantine().copy())
   {
     ossia_register(static_cast<ossia::pd::parameter*>(param));
@@ -194,8 +194,15 @@ void ossia_pd::register_nodes(void* x)
 {
   auto& inst = ossia_pd::instance();
   auto& map = inst.m_root_patcher;
+
+  // All the patchers loaded since the last call are registered at once
+  registration_batch batch;
   for(auto it = map.begin(); it != map.end(); it++)
   {
+    // objects created in an already loaded patcher register themselves
+    if(it->second.is_loadbanged)
+      continue;
+
     t_canvas* patcher = it->first;
     for(auto dev : inst.devices.reference())
     {
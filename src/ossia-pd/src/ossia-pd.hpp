@@ -140,6 +140,10 @@ public:
 
   RootMap m_root_patcher{};
   t_clock* m_reg_clock{};
+
+  // see registration_batch
+  int m_registration_batch{};
+  bool m_quarantine_retry{};
   static t_clock* browse_clock;
 
   bool m_testing{};
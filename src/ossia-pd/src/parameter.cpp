@@ -32,14 +32,7 @@ bool parameter::register_node(const std::vector<t_matcher>& matchers)
   {
     obj_dequarantining<parameter>(this);
 
-    for(auto remote : ossia::pd::remote::quarantine().copy())
-    {
-      ossia_register(remote);
-    }
-    for(auto attribute : ossia::pd::attribute::quarantine().copy())
-    {
-      ossia_register(attribute);
-    }
+    register_quarantinized_remotes();
 
     const auto& map = ossia_pd::instance().m_root_patcher;
     auto it = map.find(m_patcher_hierarchy.back());
@@ -157,14 +150,7 @@ bool parameter::unregister()
   m_node_selection.clear();
   m_matchers.clear();
 
-  for(auto remote : ossia::pd::remote::quarantine().copy())
-  {
-    ossia_register(remote);
-  }
-  for(auto attribute : ossia::pd::attribute::quarantine().copy())
-  {
-    ossia_register(attribute);
-  }
+  register_quarantinized_remotes();
 
   return true;
 }
@@ -94,8 +94,31 @@ std::string string_from_path(const std::vector<std::string>& vs)
   return {b.data(), b.size()};
 }
 
+static bool defer_quarantine_retry()
+{
+  auto& inst = ossia_pd::instance();
+  if(inst.m_registration_batch > 0)
+  {
+    inst.m_quarantine_retry = true;
+    return true;
+  }
+  return false;
+}
+
+static std::size_t quarantine_size()
+{
+  return ossia::pd::model::quarantine().size()
+         + ossia::pd::parameter::quarantine().size()
+         + ossia::pd::view::quarantine().size()
+         + ossia::pd::remote::quarantine().size()
+         + ossia::pd::attribute::quarantine().size();
+}
+
 void register_quarantinized()
 {
+  if(defer_quarantine_retry())
+    return;
+
   for(auto model : ossia::pd::model::quarantine().copy())
   {
     ossia_register<ossia::pd::model>(model);
@@ -114,6 +137,62 @@ void register_quarantinized()
   }
 }
 
+void register_quarantinized_remotes()
+{
+  if(defer_quarantine_retry())
+    return;
+
+  for(auto remote : ossia::pd::remote::quarantine().copy())
+  {
+    ossia_register(remote);
+  }
+  for(auto attribute : ossia::pd::attribute::quarantine().copy())
+  {
+    ossia_register(attribute);
+  }
+}
+
+registration_batch::registration_batch()
+{
+  ossia_pd::instance().m_registration_batch++;
+}
+
+registration_batch::~registration_batch()
+{
+  auto& inst = ossia_pd::instance();
+  if(inst.m_registration_batch > 1)
+  {
+    inst.m_registration_batch--;
+    return;
+  }
+
+  // Still batching here, so that these registrations do not retry the
+  // quarantine themselves. As registering an object may allow another one
+  // to register, go on as long as the quarantine shrinks.
+  while(inst.m_quarantine_retry)
+  {
+    inst.m_quarantine_retry = false;
+    const auto before = quarantine_size();
+
+    for(auto model : ossia::pd::model::quarantine().copy())
+      ossia_register<ossia::pd::model>(model);
+    for(auto param : ossia::pd::parameter::quarantine().copy())
+      ossia_register<ossia::pd::parameter>(param);
+    for(auto view : ossia::pd::view::quarantine().copy())
+      ossia_register<ossia::pd::view>(view);
+    for(auto remote : ossia::pd::remote::quarantine().copy())
+      ossia_register<ossia::pd::remote>(remote);
+    for(auto attribute : ossia::pd::attribute::quarantine().copy())
+      ossia_register<ossia::pd::attribute>(attribute);
+
+    if(quarantine_size() >= before)
+      break;
+  }
+
+  inst.m_quarantine_retry = false;
+  inst.m_registration_batch = 0;
+}
+
 std::string get_absolute_path(object_base* x)
 {
   std::vector<std::string> vs;
@@ -345,6 +345,26 @@ std::string string_from_path(const std::vector<std::string>& vs);
  */
 void register_quarantinized();
 
+/**
+ * @brief register_quarantinized_remotes Try to register the quarantinized
+ * remotes and attributes, which may be waiting for a newly created parameter
+ */
+void register_quarantinized_remotes();
+
+/**
+ * @brief While a registration_batch is alive, e.g. while the objects of
+ * a loaded patch are registered, the quarantinized objects are not
+ * registered again after each registration but only once, when the
+ * last batch ends.
+ */
+struct registration_batch
+{
+  registration_batch();
+  ~registration_batch();
+  registration_batch(const registration_batch&) = delete;
+  registration_batch& operator=(const registration_batch&) = delete;
+};
+
 template <typename T>
 std::vector<T*> get_objects(typename T::is_model* = nullptr)
 {
@@ -23,10 +23,12 @@ namespace py = pybind11;
 #include <ossia/network/osc/osc.hpp>
 #include <ossia/network/oscquery/oscquery_mirror.hpp>
 #include <ossia/network/oscquery/oscquery_server.hpp>
+#include <ossia/network/value/value_array.hpp>
 #include <ossia/preset/preset.hpp>
 #include <ossia/protocols/midi/midi.hpp>
 
 #include <pybind11/functional.h>
+#include <pybind11/numpy.h>
 #include <pybind11/operators.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
@@ -73,6 +75,65 @@ struct to_python_value
   py::object operator()() { return py::none{}; }
 };
 
+//! Makes a list out of a one-dimensional buffer of numbers, e.g. a NumPy array.
+//! Returns an invalid value for other buffers, e.g. bytes.
+static ossia::value from_python_buffer(PyObject* source)
+{
+  Py_buffer view;
+  if(PyObject_GetBuffer(source, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) != 0)
+  {
+    PyErr_Clear();
+    return {};
+  }
+
+  ossia::value res;
+  if(view.ndim == 1 && view.format && view.format[0] != '\0' && !view.format[1])
+  {
+    const auto n = view.len / view.itemsize;
+    auto make = [&](auto* data) {
+      using type = std::remove_cv_t<std::remove_pointer_t<decltype(data)>>;
+      if constexpr(std::is_same_v<type, int64_t>)
+      {
+        std::vector<ossia::value> vec;
+        vec.reserve(n);
+        for(Py_ssize_t i = 0; i < n; i++)
+          vec.emplace_back((int32_t)data[i]);
+        res = std::move(vec);
+      }
+      else
+      {
+        res = ossia::make_numeric_list(tcb::span<const type>(data, n));
+      }
+    };
+
+    switch(view.format[0])
+    {
+      case 'f':
+        make((const float*)view.buf);
+        break;
+      case 'd':
+        make((const double*)view.buf);
+        break;
+      case 'i':
+        if(view.itemsize == 4)
+          make((const int32_t*)view.buf);
+        break;
+      case 'l':
+      case 'q':
+        if(view.itemsize == 8)
+          make((const int64_t*)view.buf);
+        else if(view.itemsize == 4)
+          make((const int32_t*)view.buf);
+        break;
+      default:
+        break;
+    }
+  }
+
+  PyBuffer_Release(&view);
+  return res;
+}
+
 ossia::value from_python_value(PyObject* source)
 {
   ossia::value returned_value;
@@ -114,8 +175,15 @@ ossia::value from_python_value(PyObject* source)
 
     returned_value = std::move(vec);
   }
-  else if((tmp = PyByteArray_FromObject(source)))
-    returned_value = (std::string)PyByteArray_AsString(tmp);
+  else
+  {
+    // NumPy arrays and other buffers of numbers
+    if(PyObject_CheckBuffer(source) && !PyByteArray_Check(source))
+      returned_value = from_python_buffer(source);
+
+    if(!returned_value.valid() && (tmp = PyByteArray_FromObject(source)))
+      returned_value = (std::string)PyByteArray_AsString(tmp);
+  }
 
   if(tmp)
     Py_DECREF(tmp);
@@ -840,6 +908,17 @@ PYBIND11_MODULE(ossia_python, m)
           [](ossia::net::parameter_base& addr) -> py::object {
             return addr.fetch_value().apply(ossia::python::to_python_value{});
           })
+      .def(
+          "fetch_array",
+          [](ossia::net::parameter_base& addr) -> py::object {
+            // Numeric lists are returned as NumPy arrays of float32
+            std::vector<float> arr;
+            auto val = addr.fetch_value();
+            if(auto list = val.target<std::vector<ossia::value>>();
+               list && ossia::to_numeric_array(*list, arr))
+              return py::array_t<float>(arr.size(), arr.data());
+            return val.apply(ossia::python::to_python_value{});
+          })
       .def(
           "push_value",
           [](ossia::net::parameter_base& addr, const py::object& v) {
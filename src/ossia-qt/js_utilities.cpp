@@ -340,6 +340,43 @@ net::parameter_data make_parameter_data(const QJSValue& js)
   return dat;
 }
 
+js_codec read_codec(const QJSValue& js)
+{
+  js_codec res;
+  const QJSValue codec = js.property("codec");
+  if(!codec.isString() && !codec.isObject())
+    return res;
+
+  const bool binary = codec.isObject() && codec.property("binary").toBool();
+  auto make = [binary](const QJSValue& fmt) -> std::shared_ptr<const net::value_codec> {
+    if(!fmt.isString())
+      return {};
+    const auto str = fmt.toString().toStdString();
+    try
+    {
+      return std::make_shared<const net::value_codec>(
+          binary ? net::value_codec::binary(str) : net::value_codec::text(str));
+    }
+    catch(const std::exception& e)
+    {
+      qDebug() << "Invalid codec:" << fmt.toString() << e.what();
+      return {};
+    }
+  };
+
+  if(codec.isString())
+  {
+    res.write = make(codec);
+    res.read = res.write;
+  }
+  else
+  {
+    res.write = make(codec.property("write"));
+    res.read = make(codec.property("read"));
+  }
+  return res;
+}
+
 QJSValue js_value_outbound_visitor::to_enum(qml_val_type::val_type t) const
 {
   return engine.toScriptValue(QVariant::fromValue(t));
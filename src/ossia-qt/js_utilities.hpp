@@ -4,6 +4,7 @@
 #include <ossia/network/base/node.hpp>
 #include <ossia/network/base/parameter_data.hpp>
 #include <ossia/network/common/parameter_properties.hpp>
+#include <ossia/network/common/value_codec.hpp>
 #include <ossia/network/dataspace/dataspace_visitors.hpp>
 #include <ossia/network/generic/generic_node.hpp>
 #include <ossia/network/value/value.hpp>
@@ -426,6 +427,23 @@ std::optional<T> get_enum(const QJSValue& val)
 OSSIA_EXPORT
 ossia::net::parameter_data make_parameter_data(const QJSValue& js);
 
+//! Native codecs of a parameter, see ossia::net::value_codec
+struct js_codec
+{
+  std::shared_ptr<const ossia::net::value_codec> write;
+  std::shared_ptr<const ossia::net::value_codec> read;
+};
+
+/**
+ * @brief Reads the "codec" property of a parameter.
+ *
+ * Either a text template used both ways: codec: "SPD %f",
+ * or an object: codec: { write: "SET %d", read: "VAL %d", binary: false }.
+ * Invalid formats are reported and ignored.
+ */
+OSSIA_EXPORT
+js_codec read_codec(const QJSValue& js);
+
 void set_parameter_type(QMetaType::Type type, ossia::net::parameter_base& addr);
 
 /**
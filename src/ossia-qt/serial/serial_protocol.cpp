@@ -160,12 +160,26 @@ struct serial_protocol_object
   QJSValue m_onRead;
 
   ossia::qt::deferred_js_node<serial_parameter_data> nodes;
+  ossia::net::value_decoders decoders;
   std::shared_ptr<serial_wrapper> m_port;
 
   double m_coalesce{};
   bool m_osc{};
 };
 
+static void read_decoders(
+    const ossia::qt::deferred_js_node<serial_parameter_data>& node,
+    const std::string& address, ossia::net::value_decoders& decoders)
+{
+  for(const auto& child : node.children)
+  {
+    auto child_address = address + "/" + child.data.name;
+    if(child.data.codec.read)
+      decoders.decoders.push_back({child_address, child.data.codec.read});
+    read_decoders(child, child_address, decoders);
+  }
+}
+
 serial_protocol_object serial_protocol::load_serial_object_from_qml(
     serial_protocol& proto, const ossia::net::network_context_ptr& ctx,
     const ossia::net::serial_configuration& cfg)
@@ -186,6 +200,7 @@ serial_protocol_object serial_protocol::load_serial_object_from_qml(
   // or.... create the object in the other thread and just add it to the device in the main one.
   r.nodes = ossia::qt::create_device_nodes_deferred<serial_protocol>(
       createTree_ret.value<QJSValue>());
+  read_decoders(r.nodes, "", r.decoders);
 
   r.m_jsObj = m_engine->newQObject(r.m_object);
 
@@ -302,6 +317,7 @@ void serial_protocol::create_object(QQmlComponent::Status status)
     case QQmlComponent::Status::Ready: {
       // Any call to the QQmlEngine needs to be done in its thread.
       auto res = load_serial_object_from_qml(*this, m_context, m_cfg);
+      m_decoders = std::move(res.decoders);
 
       // Move the objects back to the main thread in one go
       ossia::qt::run_async(this, [this, res = std::move(res)]() mutable {
@@ -374,6 +390,18 @@ bool serial_protocol::pull(parameter_base&)
 
 void serial_protocol::on_read(const QString& txt, const QByteArray& a)
 {
+  // Messages matching a declared codec do not go through the JS engine
+  if(!m_decoders.empty())
+  {
+    ossia::value v;
+    if(auto param = m_decoders.decode(
+           m_device->get_root_node(), {a.data(), (std::size_t)a.size()}, v))
+    {
+      param->set_value(std::move(v));
+      return;
+    }
+  }
+
   QJSValueList lst;
   QJSValue arr;
   if(m_onTextMessage.isCallable())
@@ -552,6 +580,15 @@ void serial_protocol::do_write(
     return do_write_osc(ad, v);
   }
 
+  if(const auto& codec = data.codec.write)
+  {
+    static thread_local std::string str;
+    str.clear();
+    codec->encode(v, str);
+    m_port->on_write(str);
+    return;
+  }
+
   auto& engine = *m_engine;
   auto& port = *m_port;
   QJSValue& req = ad.data().request;
@@ -48,10 +48,13 @@ struct serial_parameter_data_base
 
     if(val.hasProperty("osc_address"))
       osc_address = val.property("osc_address").toString();
+
+    codec = ossia::qt::read_codec(val);
   }
 
   QJSValue request;
   QString osc_address;
+  ossia::qt::js_codec codec;
 };
 struct serial_parameter_data final
     : public parameter_data
@@ -77,7 +80,7 @@ struct serial_parameter_data final
 
   bool valid() const noexcept
   {
-    return request.isString() || request.isCallable() || type;
+    return request.isString() || request.isCallable() || codec.write || type;
   }
 };
 
@@ -200,6 +203,9 @@ private:
   std::shared_ptr<serial_wrapper> m_port;
   QByteArray m_code;
 
+  // Only used in the serial thread
+  ossia::net::value_decoders m_decoders;
+
   QObject* m_threadWorker{};
   QThread m_thread{};
 
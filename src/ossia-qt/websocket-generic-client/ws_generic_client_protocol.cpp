@@ -2,6 +2,9 @@
 // PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
 #include "ws_generic_client_protocol.hpp"
 
+#include <ossia/network/base/node_functions.hpp>
+#include <ossia/network/base/osc_address.hpp>
+
 #include <ossia-qt/js_utilities.hpp>
 #include <ossia-qt/qml_engine_functions.hpp>
 
@@ -83,7 +86,7 @@ bool ws_generic_client_protocol::push(
   assert(dynamic_cast<const ws_generic_client_parameter*>(&parameter_base));
   auto& addr = static_cast<const ws_generic_client_parameter&>(parameter_base);
 
-  if(!addr.data().request.isNull())
+  if(!addr.data().request.isNull() || addr.data().codec.write)
   {
     sig_push(&addr, v);
     return true;
@@ -128,6 +131,17 @@ void ws_generic_client_protocol::slot_push(
     const ws_generic_client_parameter* addr_p, const ossia::value& v)
 {
   auto& addr = *addr_p;
+  if(const auto& codec = addr.data().codec.write)
+  {
+    std::string str;
+    codec->encode(v, str);
+    if(codec->is_binary())
+      m_websocket->sendBinaryMessage(QByteArray(str.data(), str.size()));
+    else
+      m_websocket->sendTextMessage(QString::fromStdString(str));
+    return;
+  }
+
   auto dat = addr.data().request;
   if(dat.isCallable())
   {
@@ -166,6 +180,13 @@ void ws_generic_client_protocol::on_ready(const QString& host)
       ossia::net::device_base, ws_generic_client_node, ws_generic_client_protocol>(
       *m_device, ret.value<QJSValue>());
 
+  ossia::net::iterate_all_children(
+      &m_device->get_root_node(), [this](ossia::net::parameter_base& p) {
+    auto& param = static_cast<ws_generic_client_parameter&>(p);
+    if(auto& codec = param.data().codec.read)
+      m_decoders.decoders.push_back({ossia::net::osc_parameter_string(param), codec});
+  });
+
   // Websocket management
   m_websocket->open(host);
 
@@ -184,6 +205,9 @@ void ws_generic_client_protocol::on_ready(const QString& host)
   QObject::connect(
       m_websocket, &QWebSocket::binaryMessageReceived, this,
       [this](const QByteArray& arr) {
+    if(apply_decoders({arr.data(), (std::size_t)arr.size()}))
+      return;
+
     if(m_object->processFromJson())
     {
       auto str = arr.toStdString();
@@ -201,6 +225,13 @@ void ws_generic_client_protocol::on_ready(const QString& host)
 
   QObject::connect(
       m_websocket, &QWebSocket::textMessageReceived, this, [this](const QString& mess) {
+        if(!m_decoders.empty())
+        {
+          const auto utf8 = mess.toUtf8();
+          if(apply_decoders({utf8.data(), (std::size_t)utf8.size()}))
+            return;
+        }
+
         if(m_object->processFromJson())
         {
           auto str = mess.toStdString();
@@ -218,6 +249,22 @@ void ws_generic_client_protocol::on_ready(const QString& host)
   return;
 }
 
+bool ws_generic_client_protocol::apply_decoders(std::string_view message)
+{
+  // Messages matching a declared codec do not go through the JS engine
+  if(m_decoders.empty())
+    return false;
+
+  ossia::value v;
+  if(auto param = m_decoders.decode(m_device->get_root_node(), message, v))
+  {
+    // Not push_value: the value would be encoded and sent back to the server
+    param->set_value(std::move(v));
+    return true;
+  }
+  return false;
+}
+
 void ws_generic_client_protocol::apply_reply(QJSValue arr)
 {
   // should be an array of { address, value } objects
@@ -39,12 +39,14 @@ struct ws_generic_client_parameter_data_base
       : request{val.property("request")}
       , openListening{val.property("openListening")}
       , closeListening{val.property("closeListening")}
+      , codec{ossia::qt::read_codec(val)}
   {
   }
 
   QJSValue request;
   QJSValue openListening;
   QJSValue closeListening;
+  ossia::qt::js_codec codec;
 };
 
 struct ws_generic_client_parameter_data
@@ -71,7 +73,7 @@ struct ws_generic_client_parameter_data
   {
   }
 
-  bool valid() const noexcept { return !request.isNull() || type; }
+  bool valid() const noexcept { return !request.isNull() || codec.write || type; }
 };
 
 using ws_generic_client_parameter = wrapped_parameter<ws_generic_client_parameter_data>;
@@ -119,6 +121,7 @@ public:
 private:
   void on_ready(const QString& host);
   void apply_reply(QJSValue);
+  bool apply_decoders(std::string_view message);
 
   QQmlEngine* m_engine{};
   QQmlComponent* m_component{};
@@ -128,6 +131,7 @@ private:
 
   QByteArray m_code;
   ossia::net::device_base* m_device{};
+  ossia::net::value_decoders m_decoders;
   QList<std::pair<QNetworkReply*, const ws_generic_client_parameter*>> m_replies;
 };
 
@@ -0,0 +1,215 @@
+#include <ossia/audio/builtin_fft.hpp>
+#include <ossia/detail/math.hpp>
+
+#include <cmath>
+#include <utility>
+
+namespace ossia
+{
+builtin_fft_plan::builtin_fft_plan(std::size_t size)
+    : m_size{size}
+    , m_half{size / 2}
+    , m_pow2{size >= 2 && (size & (size - 1)) == 0}
+{
+  m_cos.resize(m_size);
+  m_sin.resize(m_size);
+  for(std::size_t k = 0; k < m_size; k++)
+  {
+    const double angle = 2. * ossia::pi * double(k) / double(m_size);
+    m_cos[k] = std::cos(angle);
+    m_sin[k] = -std::sin(angle);
+  }
+
+  if(!m_pow2)
+    return;
+
+  const std::size_t n = m_half;
+  int bits = 0;
+  while((std::size_t(1) << bits) < n)
+    bits++;
+
+  m_bitrev.resize(n);
+  for(std::size_t i = 0; i < n; i++)
+  {
+    std::size_t r = 0;
+    for(int b = 0; b < bits; b++)
+      if(i & (std::size_t(1) << b))
+        r |= std::size_t(1) << (bits - 1 - b);
+    m_bitrev[i] = r;
+  }
+
+  // The twiddles of the stage whose butterflies are h apart start at h - 1
+  m_stage_re.reserve(n);
+  m_stage_im.reserve(n);
+  for(std::size_t h = 1; h < n; h *= 2)
+  {
+    for(std::size_t j = 0; j < h; j++)
+    {
+      const double angle = ossia::pi * double(j) / double(h);
+      m_stage_re.push_back(std::cos(angle));
+      m_stage_im.push_back(-std::sin(angle));
+    }
+  }
+}
+
+void builtin_fft_plan::complex_fft(double* re, double* im, bool inverse) const noexcept
+{
+  const std::size_t n = m_half;
+  for(std::size_t i = 0; i < n; i++)
+  {
+    const std::size_t j = m_bitrev[i];
+    if(i < j)
+    {
+      std::swap(re[i], re[j]);
+      std::swap(im[i], im[j]);
+    }
+  }
+
+  const double sign = inverse ? -1. : 1.;
+  for(std::size_t h = 1; h < n; h *= 2)
+  {
+    const double* w_re = m_stage_re.data() + h - 1;
+    const double* w_im = m_stage_im.data() + h - 1;
+    for(std::size_t i = 0; i < n; i += 2 * h)
+    {
+      double* __restrict a_re = re + i;
+      double* __restrict a_im = im + i;
+      double* __restrict b_re = re + i + h;
+      double* __restrict b_im = im + i + h;
+      for(std::size_t j = 0; j < h; j++)
+      {
+        const double wr = w_re[j];
+        const double wi = sign * w_im[j];
+        const double tr = b_re[j] * wr - b_im[j] * wi;
+        const double ti = b_re[j] * wi + b_im[j] * wr;
+        b_re[j] = a_re[j] - tr;
+        b_im[j] = a_im[j] - ti;
+        a_re[j] += tr;
+        a_im[j] += ti;
+      }
+    }
+  }
+}
+
+void builtin_fft_plan::forward(
+    const double* in, double (*out)[2], double* temp) const noexcept
+{
+  if(!m_pow2)
+  {
+    dft(in, out);
+    return;
+  }
+
+  // The even and odd samples are the real and imaginary parts
+  // of a complex signal of half the size
+  const std::size_t n = m_half;
+  double* re = temp;
+  double* im = temp + n;
+  for(std::size_t i = 0; i < n; i++)
+  {
+    re[i] = in[2 * i];
+    im[i] = in[2 * i + 1];
+  }
+
+  complex_fft(re, im, false);
+
+  for(std::size_t k = 0; k <= n; k++)
+  {
+    const std::size_t k1 = k % n;
+    const std::size_t k2 = (n - k) % n;
+
+    // Spectra of the even and odd samples
+    const double even_re = (re[k1] + re[k2]) * 0.5;
+    const double even_im = (im[k1] - im[k2]) * 0.5;
+    const double odd_re = (im[k1] + im[k2]) * 0.5;
+    const double odd_im = (re[k2] - re[k1]) * 0.5;
+
+    const double wr = m_cos[k];
+    const double wi = m_sin[k];
+    out[k][0] = even_re + wr * odd_re - wi * odd_im;
+    out[k][1] = even_im + wr * odd_im + wi * odd_re;
+  }
+}
+
+void builtin_fft_plan::inverse(
+    const double (*in)[2], double* out, double* temp) const noexcept
+{
+  if(!m_pow2)
+  {
+    idft(in, out);
+    return;
+  }
+
+  const std::size_t n = m_half;
+  double* re = temp;
+  double* im = temp + n;
+  for(std::size_t k = 0; k < n; k++)
+  {
+    const double xr = in[k][0], xi = in[k][1];
+    const double cr = in[n - k][0], ci = -in[n - k][1];
+
+    // Twice the spectra of the even and odd samples, the latter rotated back
+    const double even_re = xr + cr;
+    const double even_im = xi + ci;
+    const double d_re = xr - cr;
+    const double d_im = xi - ci;
+    const double wr = m_cos[k];
+    const double wi = -m_sin[k];
+    const double odd_re = d_re * wr - d_im * wi;
+    const double odd_im = d_re * wi + d_im * wr;
+
+    re[k] = even_re - odd_im;
+    im[k] = even_im + odd_re;
+  }
+
+  complex_fft(re, im, true);
+
+  for(std::size_t i = 0; i < n; i++)
+  {
+    out[2 * i] = re[i];
+    out[2 * i + 1] = im[i];
+  }
+}
+
+void builtin_fft_plan::dft(const double* in, double (*out)[2]) const noexcept
+{
+  const std::size_t n = m_size;
+  for(std::size_t k = 0; k <= n / 2; k++)
+  {
+    double sum_re = 0., sum_im = 0.;
+    std::size_t idx = 0;
+    for(std::size_t i = 0; i < n; i++)
+    {
+      sum_re += in[i] * m_cos[idx];
+      sum_im += in[i] * m_sin[idx];
+      idx += k;
+      if(idx >= n)
+        idx -= n;
+    }
+    out[k][0] = sum_re;
+    out[k][1] = sum_im;
+  }
+}
+
+void builtin_fft_plan::idft(const double (*in)[2], double* out) const noexcept
+{
+  // The spectrum of a real signal is hermitian: only the first half is given
+  const std::size_t n = m_size;
+  const std::size_t last = (n % 2 == 0) ? n / 2 : n / 2 + 1;
+  for(std::size_t i = 0; i < n; i++)
+  {
+    double sum = n > 0 ? in[0][0] : 0.;
+    std::size_t idx = i;
+    for(std::size_t k = 1; k < last; k++)
+    {
+      if(idx >= n)
+        idx -= n;
+      sum += 2. * (in[k][0] * m_cos[idx] + in[k][1] * m_sin[idx]);
+      idx += i;
+    }
+    if(n % 2 == 0 && n > 0)
+      sum += in[n / 2][0] * ((i % 2) ? -1. : 1.);
+    out[i] = sum;
+  }
+}
+}
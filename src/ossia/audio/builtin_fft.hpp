@@ -0,0 +1,54 @@
+#pragma once
+#include <ossia/detail/config.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace ossia
+{
+/**
+ * @brief Portable real FFT, used when no FFT library is available.
+ *
+ * Power-of-two sizes use an iterative radix-2 transform of half the size,
+ * with the bit-reversal and twiddle tables computed once in the plan.
+ * The butterflies work on split real / imaginary arrays with contiguous twiddles,
+ * so that the compiler vectorizes them.
+ * Other sizes fall back to a direct DFT.
+ *
+ * Same conventions as FFTW: the forward transform of size n gives n / 2 + 1 bins,
+ * and neither direction is normalized.
+ * A plan is immutable and can be shared between threads.
+ */
+class OSSIA_EXPORT builtin_fft_plan
+{
+public:
+  explicit builtin_fft_plan(std::size_t size);
+
+  [[nodiscard]] std::size_t size() const noexcept { return m_size; }
+
+  //! Number of doubles of the scratch buffer expected by forward and inverse
+  [[nodiscard]] std::size_t temp_size() const noexcept { return m_size + 2; }
+
+  //! in: size() reals, out: size() / 2 + 1 complex numbers
+  void forward(const double* in, double (*out)[2], double* temp) const noexcept;
+
+  //! in: size() / 2 + 1 complex numbers, out: size() reals
+  void inverse(const double (*in)[2], double* out, double* temp) const noexcept;
+
+private:
+  void complex_fft(double* re, double* im, bool inverse) const noexcept;
+  void dft(const double* in, double (*out)[2]) const noexcept;
+  void idft(const double (*in)[2], double* out) const noexcept;
+
+  std::size_t m_size{};
+  std::size_t m_half{};
+  bool m_pow2{};
+
+  // Power-of-two sizes: tables of the complex transform of size m_half
+  std::vector<std::size_t> m_bitrev;
+  std::vector<double> m_stage_re, m_stage_im;
+
+  // exp(-2i * pi * k / m_size), for the real <-> complex passes and the DFT
+  std::vector<double> m_cos, m_sin;
+};
+}
@@ -1,8 +1,42 @@
 #include <ossia/audio/fft.hpp>
+#include <ossia/detail/hash_map.hpp>
 
 #include <algorithm>
+#include <mutex>
 #include <new>
 
+namespace ossia
+{
+namespace
+{
+// Plans are created once per size and direction and kept until the end of the
+// process: creating a FFTW plan with FFTW_MEASURE takes much longer than
+// running it, and the planner is not thread-safe.
+struct fft_plan_cache
+{
+  template <typename F>
+  fft_plan get(std::size_t size, bool inverse, F&& create)
+  {
+    std::lock_guard lock{m_mutex};
+    auto [it, inserted] = m_plans.try_emplace(size * 2 + inverse);
+    if(inserted)
+      it->second = create();
+    return it->second;
+  }
+
+private:
+  std::mutex m_mutex;
+  ossia::hash_map<std::size_t, fft_plan> m_plans;
+};
+
+fft_plan_cache& fft_plans()
+{
+  static fft_plan_cache cache;
+  return cache;
+}
+}
+}
+
 #if defined(OSSIA_FFT_FFTW)
 #include <fftw3.h>
 namespace ossia
@@ -62,20 +96,27 @@ auto run_plan_c2r(fft_plan, void*, void*)
 #endif
 }
 
+// The plans are only ever run with the new-array execute functions,
+// on buffers which have the same alignment as the ones they are created with.
 fft::fft(std::size_t newSize) noexcept
 {
   m_size = newSize;
   m_input = alloc_real(newSize);
   m_output = reinterpret_cast<fft_complex*>(alloc_complex(newSize / 2 + 1));
-  m_fw = create_plan_r2c(newSize, m_input, m_output, FFTW_DESTROY_INPUT | FFTW_MEASURE);
+  m_fw = fft_plans().get(newSize, false, [newSize] {
+    auto in = alloc_real(newSize);
+    auto out = alloc_complex(newSize / 2 + 1);
+    auto plan = create_plan_r2c(newSize, in, out, FFTW_DESTROY_INPUT | FFTW_MEASURE);
+    fft_free(in);
+    fft_free(out);
+    return plan;
+  });
 }
 
 fft::~fft()
 {
-  destroy_plan(m_fw);
   fft_free(m_input);
   fft_free(m_output);
-  //  cleanup();
 }
 
 void fft::reset(std::size_t newSize)
@@ -102,7 +143,7 @@ fft_complex* fft::execute(float* input, std::size_t sz) noexcept
   else
   {
     std::copy_n(input, sz, m_input);
-    for(int i = sz; sz < m_size; i++)
+    for(std::size_t i = sz; i < m_size; i++)
     {
       m_input[i] = 0.f;
     }
@@ -117,7 +158,7 @@ fft_complex* fft::execute(float* input, std::size_t sz) noexcept
   else
   {
     std::copy_n(input, sz, m_input);
-    for(int i = sz; sz < m_size; i++)
+    for(std::size_t i = sz; i < m_size; i++)
     {
       m_input[i] = 0.;
     }
@@ -140,15 +181,20 @@ rfft::rfft(std::size_t newSize) noexcept
   m_size = newSize;
   m_input = reinterpret_cast<fft_complex*>(alloc_complex(newSize / 2 + 1));
   m_output = alloc_real(newSize);
-  m_fw = create_plan_c2r(newSize, m_input, m_output, FFTW_DESTROY_INPUT | FFTW_MEASURE);
+  m_fw = fft_plans().get(newSize, true, [newSize] {
+    auto in = alloc_complex(newSize / 2 + 1);
+    auto out = alloc_real(newSize);
+    auto plan = create_plan_c2r(newSize, in, out, FFTW_DESTROY_INPUT | FFTW_MEASURE);
+    fft_free(in);
+    fft_free(out);
+    return plan;
+  });
 }
 
 rfft::~rfft()
 {
-  destroy_plan(m_fw);
   fft_free(m_input);
   fft_free(m_output);
-  //  cleanup();
 }
 
 void rfft::reset(std::size_t newSize)
@@ -201,7 +247,7 @@ static const constexpr struct
   }
 } fft_free;
 static const constexpr auto create_plan_r2c
-    = [](std::size_t sz, ...) { return new fftw_plan_s(sz); };
+    = [](std::size_t sz) -> fft_plan { return new fftw_plan_s(sz); };
 static const constexpr auto run_plan_r2c
     = [](void* plan, fft_real* real, fft_complex* cplx, auto& temp) {
   return ((fftw_plan_s*)plan)
@@ -213,26 +259,20 @@ static const constexpr auto run_plan_c2r
   return ((fftw_plan_s*)plan)
       ->execute((kfr::f64*)real, (kfr::c64*)cplx, temp.data(), kfr::cinvert_t{});
 };
-static const constexpr auto destroy_plan = [](auto&& p) { delete(fftw_plan_s*)p; };
-static const constexpr auto cleanup = [] {};
-static const constexpr auto alignment_of = [] {};
-static const constexpr auto FFTW_DESTROY_INPUT = 0;
-static const constexpr auto FFTW_MEASURE = 0;
 fft::fft(std::size_t newSize) noexcept
 {
   m_size = newSize;
   m_input = alloc_real(newSize);
   m_output = reinterpret_cast<fft_complex*>(alloc_complex(newSize / 2 + 1));
-  m_fw = create_plan_r2c(newSize, m_input, m_output, FFTW_DESTROY_INPUT | FFTW_MEASURE);
+  // The same real DFT plan is used in both directions
+  m_fw = fft_plans().get(newSize, false, [newSize] { return create_plan_r2c(newSize); });
   m_storage.resize(((fftw_plan_s*)m_fw)->temp_size);
 }
 
 fft::~fft()
 {
-  destroy_plan(m_fw);
   fft_free(m_input);
   fft_free(m_output);
-  //  cleanup();
 }
 
 void fft::reset(std::size_t newSize)
@@ -253,7 +293,7 @@ fft_complex* fft::execute(float* input, std::size_t sz) noexcept
   else
   {
     std::copy_n(input, sz, m_input);
-    for(int i = sz; sz < m_size; i++)
+    for(std::size_t i = sz; i < m_size; i++)
     {
       m_input[i] = 0.;
     }
@@ -275,16 +315,14 @@ rfft::rfft(std::size_t newSize) noexcept
   m_size = newSize;
   m_input = reinterpret_cast<fft_complex*>(alloc_complex(newSize / 2 + 1));
   m_output = alloc_real(newSize);
-  m_fw = create_plan_c2r(newSize, m_input, m_output, FFTW_DESTROY_INPUT | FFTW_MEASURE);
+  m_fw = fft_plans().get(newSize, false, [newSize] { return create_plan_c2r(newSize); });
   m_storage.resize(((fftw_plan_s*)m_fw)->temp_size);
 }
 
 rfft::~rfft()
 {
-  destroy_plan(m_fw);
   fft_free(m_input);
   fft_free(m_output);
-  //  cleanup();
 }
 
 void rfft::reset(std::size_t newSize)
@@ -309,66 +347,17 @@ fft_real* rfft::execute() noexcept
 }
 
 #else
-#include <ossia/detail/math.hpp>
-
-#include <complex>
+#include <ossia/audio/builtin_fft.hpp>
 
 namespace ossia
 {
-namespace
-{
-// Minimal implementation taken from
-// https://gist.github.com/lukicdarkoo/3f0d056e9244784f8b4a
-template <typename FP>
-static void fft_rec(std::complex<FP>* x, int N)
-{
-  using namespace std;
-  using cplx = std::complex<FP>;
-
-  // Check if it is splitted enough
-  if(N <= 1)
-  {
-    return;
-  }
-
-  // Split even and odd
-  auto* odd = (cplx*)alloca(sizeof(cplx) * N / 2);
-  auto* even = (cplx*)alloca(sizeof(cplx) * N / 2);
-  for(int i = 0; i < N / 2; i++)
-  {
-    even[i] = x[i * 2];
-    odd[i] = x[i * 2 + 1];
-  }
-
-  // Split on tasks
-  fft_rec(even, N / 2);
-  fft_rec(odd, N / 2);
-
-  // Calculate DFT
-  for(int k = 0; k < N / 2; k++)
-  {
-    cplx t = exp(cplx(0, -2 * ossia::pi * k / N)) * odd[k];
-    x[k] = even[k] + t;
-    x[N / 2 + k] = even[k] - t;
-  }
-}
-
-template <typename FP>
-static void do_fft(FP* x_in, std::complex<FP>* x_out, int N)
-{
-  for(int i = 0; i < N; i++)
-  {
-    x_out[i] = {x_in[i], 0};
-  }
-  fft_rec(x_out, N);
-}
-}
-
 fft::fft(std::size_t newSize) noexcept
 {
   m_size = newSize;
   m_input = (ossia::fft_real*)calloc(newSize + 1, sizeof(ossia::fft_real));
-  m_output = (ossia::fft_complex*)calloc(newSize + 1, sizeof(ossia::fft_complex));
+  m_output = (ossia::fft_complex*)calloc(newSize / 2 + 1, sizeof(ossia::fft_complex));
+  m_fw = fft_plans().get(newSize, false, [newSize] { return new builtin_fft_plan(newSize); });
+  m_storage.resize(m_fw->temp_size());
 }
 
 fft::~fft()
@@ -385,22 +374,33 @@ void fft::reset(std::size_t newSize)
 
 fft_complex* fft::execute(float* input, std::size_t sz) noexcept
 {
-  std::copy_n(input, m_size, m_input);
-  do_fft(m_input, reinterpret_cast<std::complex<double>*>(m_output), sz);
+  if(sz >= m_size)
+  {
+    std::copy_n(input, m_size, m_input);
+  }
+  else
+  {
+    std::copy_n(input, sz, m_input);
+    std::fill_n(m_input + sz, m_size - sz, 0.);
+  }
+  m_fw->forward(m_input, m_output, m_storage.data());
   return m_output;
 }
 
 fft_complex* fft::execute() noexcept
 {
-  do_fft(m_input, reinterpret_cast<std::complex<double>*>(m_output), m_size);
+  m_fw->forward(m_input, m_output, m_storage.data());
   return m_output;
 }
 
 rfft::rfft(std::size_t newSize) noexcept
 {
   m_size = newSize;
-  m_input = (ossia::fft_complex*)calloc(newSize + 1, sizeof(ossia::fft_complex));
+  m_input = (ossia::fft_complex*)calloc(newSize / 2 + 1, sizeof(ossia::fft_complex));
   m_output = (ossia::fft_real*)calloc(newSize + 1, sizeof(ossia::fft_real));
+  // The plan computes both directions
+  m_fw = fft_plans().get(newSize, false, [newSize] { return new builtin_fft_plan(newSize); });
+  m_storage.resize(m_fw->temp_size());
 }
 
 rfft::~rfft()
@@ -417,14 +417,39 @@ void rfft::reset(std::size_t newSize)
 
 fft_real* rfft::execute(fft_complex* input) noexcept
 {
-  // TODO
+  m_fw->inverse(input, m_output, m_storage.data());
   return m_output;
 }
 
 fft_real* rfft::execute() noexcept
 {
-  // TODO
+  m_fw->inverse(m_input, m_output, m_storage.data());
   return m_output;
 }
 }
 #endif
+
+namespace ossia
+{
+void fft::execute(
+    const float* const* inputs, fft_complex* const* outputs, std::size_t channels,
+    std::size_t sz) noexcept
+{
+  // Inputs are only read
+  for(std::size_t c = 0; c < channels; c++)
+  {
+    auto res = execute(const_cast<float*>(inputs[c]), sz);
+    std::copy_n(&res[0][0], 2 * (m_size / 2 + 1), &outputs[c][0][0]);
+  }
+}
+
+void rfft::execute(
+    fft_complex* const* inputs, fft_real* const* outputs, std::size_t channels) noexcept
+{
+  for(std::size_t c = 0; c < channels; c++)
+  {
+    auto res = execute(inputs[c]);
+    std::copy_n(res, m_size, outputs[c]);
+  }
+}
+}
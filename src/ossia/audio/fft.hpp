@@ -43,17 +43,22 @@ using fft_temp_storage = ossia::pod_vector<uint8_t>;
 #else
 namespace ossia
 {
-using fft_plan = void*;
+class builtin_fft_plan;
+using fft_plan = const builtin_fft_plan*;
 using fft_real = double;
 using fft_complex = double[2];
-struct fft_temp_storage
-{
-};
+using fft_temp_storage = ossia::pod_vector<double>;
 }
 #endif
 
 namespace ossia
 {
+/**
+ * The plans are shared by all the transforms of a given size and direction:
+ * creating a transform only allocates its buffers.
+ *
+ * Without FFTW nor KFR, a built-in implementation is used, see builtin_fft_plan.
+ */
 class OSSIA_EXPORT fft
 {
 public:
@@ -72,6 +77,17 @@ public:
   fft_complex* execute(float* input, std::size_t sz) noexcept;
   fft_complex* execute() noexcept;
 
+  /**
+   * @brief Transforms several channels of sz samples with the same plan.
+   *
+   * A convenience wrapper: the channels are transformed one after the other,
+   * each being copied to its output. Each output must have room for
+   * size / 2 + 1 bins.
+   */
+  void execute(
+      const float* const* inputs, fft_complex* const* outputs, std::size_t channels,
+      std::size_t sz) noexcept;
+
   [[nodiscard]] fft_real* input() const noexcept { return m_input; }
 
 private:
@@ -95,6 +111,12 @@ public:
   fft_real* execute(fft_complex* input) noexcept;
   fft_real* execute() noexcept;
 
+  //! Transforms several channels one after the other with the same plan,
+  //! as a convenience: each output must have room for size reals
+  void execute(
+      fft_complex* const* inputs, fft_real* const* outputs,
+      std::size_t channels) noexcept;
+
   [[nodiscard]] fft_complex* input() const noexcept { return m_input; }
 
 private:
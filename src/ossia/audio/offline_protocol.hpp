@@ -0,0 +1,217 @@
+#pragma once
+#include <ossia/audio/audio_engine.hpp>
+#include <ossia/audio/drwav_write_handle.hpp>
+#include <ossia/detail/pod_vector.hpp>
+#include <ossia/detail/thread.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ossia
+{
+struct offline_render_stats
+{
+  int64_t frames{};
+
+  //! Duration of the rendered audio, in seconds
+  double duration{};
+
+  //! Time taken by the render, in seconds
+  double elapsed{};
+
+  //! How many times faster than realtime the render ran
+  [[nodiscard]] double realtime_factor() const noexcept
+  {
+    return elapsed > 0. ? duration / elapsed : 0.;
+  }
+};
+
+/**
+ * @brief Audio engine which runs the tick as fast as the CPU allows.
+ *
+ * There is no device and no thread: render() calls the tick in a loop on the
+ * calling thread, and set_tick applies the new tick immediately.
+ * The transport position given to the tick is computed from the rendered frames
+ * instead of a clock, so that rendering the same score twice gives the same result.
+ *
+ * The inputs are silent.
+ */
+class offline_engine final : public audio_engine
+{
+public:
+  offline_engine(int rate, int bs, int inputs, int outputs)
+  {
+    effective_sample_rate = rate;
+    effective_buffer_size = std::max(bs, 1);
+    effective_inputs = std::max(inputs, 0);
+    effective_outputs = std::max(outputs, 0);
+
+    const std::size_t frames = effective_buffer_size;
+    m_samples.resize((effective_inputs + effective_outputs) * frames);
+    m_converted.resize(effective_outputs * frames);
+    for(int i = 0; i < effective_inputs + effective_outputs; i++)
+      m_channels.push_back(m_samples.data() + i * frames);
+    for(int i = 0; i < effective_outputs; i++)
+      m_converted_channels.push_back(m_converted.data() + i * frames);
+  }
+
+  bool running() const override { return true; }
+
+  // Nothing runs concurrently: the pending tick changes can be applied right away
+  void wait(int) override { load_audio_tick(); }
+
+  //! Number of frames rendered since the creation of the engine
+  [[nodiscard]] int64_t position() const noexcept { return m_position; }
+
+  /**
+   * @brief Runs the tick for the given number of frames.
+   *
+   * If a file is given, the outputs are written to it.
+   * Stops early if the engine is stopped from the tick.
+   */
+  offline_render_stats render(int64_t frames, drwav_write_handle* file = nullptr)
+  {
+    using clk = std::chrono::steady_clock;
+    const auto t0 = clk::now();
+
+    const int n_in = effective_inputs;
+    const int n_out = effective_outputs;
+    float** outputs = m_channels.data() + n_in;
+
+    int64_t done = 0;
+    while(done < frames)
+    {
+      const int64_t n = std::min(int64_t(effective_buffer_size), frames - done);
+
+      tick_start();
+      if(stop_processing)
+      {
+        tick_clear();
+        break;
+      }
+
+      for(int i = 0; i < n_out; i++)
+        std::fill_n(outputs[i], n, 0.f);
+
+      ossia::audio_tick_state ts{
+          m_channels.data(),
+          outputs,
+          n_in,
+          n_out,
+          uint64_t(n),
+          double(m_position) / effective_sample_rate,
+          uint64_t(m_position),
+          transport_status::playing};
+      audio_tick(ts);
+      tick_end();
+
+      if(file && file->is_open())
+      {
+        for(int i = 0; i < n_out; i++)
+          std::copy_n(outputs[i], n, m_converted_channels[i]);
+        file->write_pcm_frames(n, m_converted_channels.data());
+      }
+
+      m_position += n;
+      done += n;
+    }
+
+    offline_render_stats stats;
+    stats.frames = done;
+    stats.duration = double(done) / effective_sample_rate;
+    stats.elapsed = std::chrono::duration<double>(clk::now() - t0).count();
+    return stats;
+  }
+
+private:
+  ossia::pod_vector<float> m_samples;
+  std::vector<float*> m_channels;
+
+  ossia::pod_vector<double> m_converted;
+  std::vector<double*> m_converted_channels;
+
+  int64_t m_position{};
+};
+
+/**
+ * @brief A render done by render_offline, on its own engine and thread.
+ */
+struct offline_render_job
+{
+  int rate{48000};
+  int buffer_size{512};
+  int inputs{0};
+  int outputs{2};
+  int64_t frames{};
+
+  //! Given to setup, e.g. to seed the random generators of the nodes
+  uint64_t seed{};
+
+  //! Nothing is written if empty
+  std::string output_file;
+  int bits_per_sample{24};
+
+  /**
+   * Called on the render thread before the render:
+   * creates what the render needs (execution_state, graph, ...) and calls
+   * engine.set_tick. The returned object is kept alive until the render ends.
+   */
+  std::function<std::shared_ptr<void>(offline_engine&, const offline_render_job&)>
+      setup;
+
+  offline_render_stats stats;
+};
+
+//! Renders a job on the calling thread
+inline void render_offline(offline_render_job& job)
+{
+  offline_engine engine{job.rate, job.buffer_size, job.inputs, job.outputs};
+  std::shared_ptr<void> context;
+  if(job.setup)
+    context = job.setup(engine, job);
+
+  drwav_write_handle file;
+  if(!job.output_file.empty())
+    file.open(
+        job.output_file, engine.effective_outputs, engine.effective_sample_rate,
+        job.bits_per_sample);
+
+  job.stats = engine.render(job.frames, &file);
+  file.close();
+
+  // The ticks may reference the context
+  engine.audio_tick = audio_engine::fun_type{};
+  engine.gc();
+}
+
+/**
+ * @brief Renders independent jobs in parallel.
+ *
+ * Each job has its own engine; the jobs must not share their execution_state.
+ * At most `threads` jobs run at the same time.
+ */
+inline void render_offline(std::vector<offline_render_job>& jobs, int threads)
+{
+  threads = std::clamp(threads, 1, std::max(int(jobs.size()), 1));
+
+  std::atomic_size_t next{0};
+  auto worker = [&] {
+    ossia::set_thread_name("ossia offline");
+    for(std::size_t i = next++; i < jobs.size(); i = next++)
+      render_offline(jobs[i]);
+  };
+
+  std::vector<std::thread> pool;
+  for(int i = 0; i < threads; i++)
+    pool.emplace_back(worker);
+
+  for(auto& t : pool)
+    t.join();
+}
+}
@@ -303,7 +303,7 @@ static void filter_value(
 {
   // 1. Convert from source unit to destination unit
   auto src_unit = source_type.target<ossia::unit_t>();
-  auto tgt_unit = source_type.target<ossia::unit_t>();
+  auto tgt_unit = res_type.target<ossia::unit_t>();
   if(src_unit && tgt_unit && *src_unit != *tgt_unit)
   {
     source = ossia::convert(source, *src_unit, *tgt_unit);
@@ -15,7 +15,7 @@ struct clear_data
 {
   void operator()(value_port& p) const { p.clear(); }
 
-  void operator()(midi_port& p) const { p.messages.clear(); }
+  void operator()(midi_port& p) const { p.clear(); }
 
   void operator()(audio_port& p) const { p.set_channels(0); }
 
@@ -57,9 +57,9 @@ struct move_data
 
   void operator()(midi_port& out, midi_port& in)
   {
-    auto tmp = std::move(in.messages);
-    in.messages = std::move(out.messages);
-    out.messages = std::move(tmp);
+    std::swap(in.messages, out.messages);
+    std::swap(in.events, out.events);
+    in.normalize();
   }
 
   void operator()(geometry_port& out, geometry_port& in)
@@ -142,20 +142,21 @@ struct copy_data
   void operator()(const midi_port& out, midi_port& in)
   {
     // Called in init_node_visitor::copy, when copying from a node to another
-    operator()(out.messages, in);
+    in.append(out);
   }
 
   void operator()(const value_vector<libremidi::message>& out, midi_port& in)
   {
     // Called in copy_data_pos, when copying from a delay line to a port
     for(const auto& data : out)
-      in.messages.push_back(data);
+      in.push_back(data);
   }
 
   void operator()(const midi_port& out, midi_delay_line& in)
   {
     // Called in env_writer, when copying from a node to a delay line
-    in.messages.push_back(out.messages);
+    auto& vec = in.messages.emplace_back(out.messages);
+    out.events.append_to(vec);
   }
 
   /// Geometry ///
@@ -162,6 +162,8 @@ void direct_execution_state_policy::commit()
       auto proto = static_cast<ossia::net::midi::midi_protocol*>(&dst->get_protocol());
       for(const auto& v : src->messages)
         proto->push_value(v);
+      for(const auto& ev : src->events)
+        proto->push_value(src->events.to_message(ev));
     }
   }
 #endif
@@ -237,7 +239,7 @@ void direct_execution_state_policy::insert(
 void direct_execution_state_policy::insert(
     ossia::net::midi::midi_parameter& dest, const midi_port& v)
 {
-  if(!v.messages.empty())
+  if(!v.empty())
     m_midiQueue.enqueue(midi_msg{&v, &dest});
 }
 }
@@ -253,11 +253,12 @@ void local_state_execution_policy::insert(
     ossia::net::midi::midi_parameter& param, const midi_port& v)
 {
 #if defined(OSSIA_PROTOCOL_MIDI)
-  if(!v.messages.empty())
+  if(!v.empty())
   {
     OSSIA_EXEC_STATE_LOCK_WRITE(*this);
     auto& vec = m_midiState[&param];
     vec.insert(vec.end(), v.messages.begin(), v.messages.end());
+    v.events.append_to(vec);
   }
 #endif
 }
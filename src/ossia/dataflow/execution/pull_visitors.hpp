@@ -116,7 +116,7 @@ struct global_pull_visitor
     {
       for(const libremidi::message& v : it->second.messages)
       {
-        val.messages.push_back(v);
+        val.push_back(v);
       }
     }
 #endif
@@ -168,7 +168,7 @@ struct global_pull_node_visitor
       {
         for(const libremidi::message& v : it->second.messages)
         {
-          val.messages.push_back(v);
+          val.push_back(v);
         }
       }
       else
@@ -176,7 +176,7 @@ struct global_pull_node_visitor
         for(const libremidi::message& v : it->second.messages)
         {
           if(v.get_channel() == channel)
-            val.messages.push_back(v);
+            val.push_back(v);
         }
       }
     }
@@ -14,7 +14,7 @@
 #include <ossia/dataflow/execution/pull_visitors.hpp>
 #include <ossia/dataflow/port.hpp>
 #include <ossia/dataflow/token_request.hpp>
-#include <ossia/network/base/message_queue.hpp>
+#include <ossia/network/base/parameter_inbox.hpp>
 
 #include <libremidi/libremidi.hpp>
 namespace ossia
@@ -78,14 +78,14 @@ void execution_state::unregister_device(net::device_base* d)
   }
 }
 
-void execution_state::register_parameter(net::parameter_base& p)
+void execution_state::register_parameter(net::parameter_base& p, int inbox_size)
 {
   auto device = &p.get_node().get_device();
   for(auto& q : m_valueQueues)
   {
     if(&q.device == device)
     {
-      q.reg(p);
+      q.reg(p, inbox_size);
       break;
     }
   }
@@ -143,9 +143,11 @@ void execution_state::get_new_values()
 
   for(auto& mq : m_valueQueues)
   {
-    ossia::received_value recv;
-    while(mq.try_dequeue(recv))
-      m_receivedValues[recv.address].push_back(recv.value);
+    mq.drain([this](ossia::net::parameter_base& p, tcb::span<ossia::value> values) {
+      auto& vec = m_receivedValues[&p];
+      for(auto& v : values)
+        vec.push_back(std::move(v));
+    });
   }
 
   for(auto it = m_receivedMidi.begin(), end = m_receivedMidi.end(); it != end; ++it)
@@ -195,7 +197,7 @@ void execution_state::register_port(const inlet& port)
     {
       if(auto addr = port.address.target<ossia::net::parameter_base*>())
       {
-        register_parameter(**addr);
+        register_parameter(**addr, vp->inbox_size);
       }
       else if(auto p = port.address.target<ossia::traversal::path>())
       {
@@ -207,7 +209,7 @@ void execution_state::register_port(const inlet& port)
         ossia::traversal::apply(*p, roots);
         for(auto n : roots)
           if(auto param = n->get_parameter())
-            register_parameter(*param);
+            register_parameter(*param, vp->inbox_size);
       }
     }
   }
@@ -21,7 +21,7 @@ class midi_protocol;
 class midi_parameter;
 }
 class state;
-class message_queue;
+class parameter_inbox;
 class audio_parameter;
 struct typed_value;
 struct timed_value;
@@ -29,6 +29,7 @@ struct local_pull_visitor;
 struct global_pull_visitor;
 struct state_exec_visitor;
 struct execution_state_policy;
+class replay_recorder;
 struct OSSIA_EXPORT execution_state : public Nano::Observer
 {
   execution_state();
@@ -112,7 +113,7 @@ private:
   void init_midi_timings();
   void get_new_values();
 
-  void register_parameter(ossia::net::parameter_base& p);
+  void register_parameter(ossia::net::parameter_base& p, int inbox_size);
   void unregister_parameter(ossia::net::parameter_base& p);
   void register_midi_parameter(net::midi::midi_protocol& p);
   void unregister_midi_parameter(net::midi::midi_protocol& p);
@@ -129,7 +130,7 @@ private:
   };
   ossia::spsc_queue<device_operation> m_device_change_queue;
 
-  std::list<message_queue> m_valueQueues;
+  std::list<parameter_inbox> m_valueQueues;
 
   ossia::ptr_map<ossia::net::parameter_base*, value_vector<ossia::value>>
       m_receivedValues;
@@ -148,6 +149,7 @@ private:
   friend struct global_pull_visitor;
   friend struct global_pull_node_visitor;
   friend struct state_exec_visitor;
+  friend class replay_recorder;
 
   std::unique_ptr<execution_state_policy> m_policy;
 };
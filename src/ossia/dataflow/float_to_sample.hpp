@@ -4,6 +4,7 @@
 #include <ossia/detail/math.hpp>
 
 #include <cstdint>
+#include <cstring>
 #include <limits>
 
 namespace ossia
@@ -124,10 +125,10 @@ inline void interleave(
     for(int k = 0; k < bs; k++)
     {
       // Case packed 24-bit: we have to go through raw char*
+      // and only write the lower bytes of the little-endian sample
       char* out_raw = reinterpret_cast<char*>(out);
-      auto mem
-          = reinterpret_cast<SampleFormat*>(out_raw[(k * channels + c) * ByteIncrement]);
-      *mem = float_to_sample<SampleFormat, N>(in_channel[k]);
+      const SampleFormat sample = float_to_sample<SampleFormat, N>(in_channel[k]);
+      std::memcpy(out_raw + (k * channels + c) * ByteIncrement, &sample, ByteIncrement);
     }
   }
 }
@@ -239,8 +239,8 @@ smallfun::function<void(unsigned long, double), 128> make_tick(
     return ossia::buffer_tick{st, g, root, transport};
   else if(tick == tick_setup_options::Precise)
     return ossia::precise_score_tick{st, g, itv, transport};
-  // else if (tick == tick_setup_options::ScoreAccurate)
-  //   return ossia::split_score_tick{st, g, itv, transport};
+  else if(tick == tick_setup_options::ScoreAccurate)
+    return ossia::split_score_tick{st, g, root, transport};
   else
     return ossia::buffer_tick{st, g, root, transport};
 }
@@ -72,6 +72,9 @@ struct graph_setup_options
 
   bool parallel{};
   int parallel_threads = 8;
+
+  //! Parallel graphs: run the linear chains of nodes as a single task
+  bool fuse_chains{true};
   std::shared_ptr<ossia::logger_type> log{};
   std::shared_ptr<bench_map> bench{};
 };
@@ -1,5 +1,6 @@
 #pragma once
 #include <ossia/dataflow/graph_node.hpp>
+#include <ossia/dataflow/port.hpp>
 #include <ossia/detail/fmt.hpp>
 #include <ossia/detail/lockfree_queue.hpp>
 #include <ossia/detail/thread.hpp>
@@ -34,11 +35,13 @@ public:
       , m_dependencies{other.m_dependencies}
       , m_remaining_dependencies{other.m_remaining_dependencies.load()}
       , m_node{other.m_node}
+      , m_fused{std::move(other.m_fused)}
       , m_precedes{std::move(other.m_precedes)}
 #if defined(CHECK_FOLLOWS)
       , m_follows{std::move(other.m_follows)}
 #endif
   {
+    other.m_fused.clear();
     other.m_precedes.clear();
 #if defined(CHECK_FOLLOWS)
     other.m_follows.clear();
@@ -51,6 +54,8 @@ public:
     m_dependencies = other.m_dependencies;
     m_remaining_dependencies = other.m_remaining_dependencies.load();
     m_node = other.m_node;
+    m_fused = std::move(other.m_fused);
+    other.m_fused.clear();
     m_precedes = std::move(other.m_precedes);
     other.m_precedes.clear();
 #if defined(CHECK_FOLLOWS)
@@ -74,6 +79,19 @@ public:
     other.m_dependencies++;
   }
 
+  //! Number of nodes run by the task
+  [[nodiscard]] std::size_t size() const noexcept { return 1 + m_fused.size(); }
+
+  [[nodiscard]] bool enabled() const noexcept
+  {
+    if(m_node->enabled())
+      return true;
+    for(auto node : m_fused)
+      if(node->enabled())
+        return true;
+    return false;
+  }
+
 private:
   friend class taskflow;
   friend class executor;
@@ -84,6 +102,9 @@ private:
   std::atomic_bool m_executed{};
 
   ossia::graph_node* m_node{};
+
+  // Nodes of a linear chain starting at m_node, run after it in this order
+  ossia::small_pod_vector<ossia::graph_node*, 4> m_fused;
   ossia::small_pod_vector<int, 4> m_precedes;
 #if defined(CHECK_FOLLOWS)
   ossia::small_pod_vector<int, 4> m_follows;
@@ -105,6 +126,82 @@ public:
     return &last;
   }
 
+  [[nodiscard]] std::size_t size() const noexcept { return m_tasks.size(); }
+  [[nodiscard]] const task& operator[](std::size_t i) const noexcept
+  {
+    return m_tasks[i];
+  }
+
+  /**
+   * @brief Merges the linear chains of tasks into single tasks.
+   *
+   * In a -> b -> c, where a only precedes b, b only follows a, and so on,
+   * the three nodes are run one after the other by a single task:
+   * this saves the enqueuing and the synchronization of b and c.
+   * Only threadable nodes are fused, and a node with an inlet addressed to a
+   * parameter only starts a chain.
+   *
+   * The tasks must have been emplaced in topological order, and the task
+   * pointers given by emplace are invalidated.
+   */
+  void fuse_chains()
+  {
+    const int N = m_tasks.size();
+    auto fusable = [](const ossia::graph_node& node) { return !node.not_threadable(); };
+    auto addressed = [](const ossia::graph_node& node) {
+      for(auto in : node.root_inputs())
+        if(in->address)
+          return true;
+      return false;
+    };
+
+    // -1 for the tasks fused in a previous one
+    std::vector<int> ids(N);
+    int count = 0;
+    for(int i = 0; i < N; i++)
+    {
+      if(ids[i] < 0)
+        continue;
+      ids[i] = count++;
+
+      task& t = m_tasks[i];
+      if(!fusable(*t.m_node))
+        continue;
+
+      // As the order is topological, the next tasks were not visited yet
+      while(t.m_precedes.size() == 1)
+      {
+        const int next_id = t.m_precedes[0];
+        task& next = m_tasks[next_id];
+        if(next.m_dependencies != 1 || !fusable(*next.m_node)
+           || addressed(*next.m_node))
+          break;
+
+        t.m_fused.push_back(next.m_node);
+        t.m_precedes = std::move(next.m_precedes);
+        next.m_precedes.clear();
+        ids[next_id] = -1;
+      }
+    }
+
+    if(count == N)
+      return;
+
+    std::vector<task> tasks;
+    tasks.reserve(count);
+    for(int i = 0; i < N; i++)
+    {
+      if(ids[i] < 0)
+        continue;
+
+      auto& t = tasks.emplace_back(std::move(m_tasks[i]));
+      t.m_taskId = ids[i];
+      for(int& next : t.m_precedes)
+        next = ids[next];
+    }
+    m_tasks = std::move(tasks);
+  }
+
 private:
   friend class executor;
 
@@ -198,7 +295,7 @@ public:
       if(task.m_dependencies == 0)
       {
 #if defined(DISABLE_DONE_TASKS)
-        if(task.m_node->enabled())
+        if(task.enabled())
 #endif
         {
 #if defined(CHECK_EXEC_COUNTS)
@@ -271,7 +368,7 @@ private:
       if(rem == 0)
       {
 #if defined(DISABLE_DONE_TASKS)
-        if(nextTask.m_node->enabled())
+        if(nextTask.enabled())
 #endif
         {
 #if defined(CHECK_EXEC_COUNTS)
@@ -324,6 +421,8 @@ private:
       assert(m_checkVec[task.m_taskId] == 1);
 #endif
       m_func(*task.m_node);
+      for(auto node : task.m_fused)
+        m_func(*node);
 
 #if defined(CHECK_EXEC_COUNTS)
       assert(m_checkVec[task.m_taskId] == 1);
@@ -379,6 +478,7 @@ public:
   custom_parallel_update(Graph_T& g, const ossia::graph_setup_options& opt)
       : impl{g, opt}
       , executor{opt.parallel_threads}
+      , fuse_chains{opt.fuse_chains}
   {
   }
 
@@ -431,6 +531,12 @@ public:
       auto& receiver = flow_nodes[n1.get()];
       sender->precede(*receiver);
     }
+
+    if(fuse_chains)
+    {
+      flow_graph.fuse_chains();
+      flow_nodes.clear();
+    }
   }
 
   template <typename Graph_T, typename DevicesT>
@@ -449,6 +555,7 @@ private:
   ossia::taskflow flow_graph;
   ossia::executor executor;
   ossia::hash_map<graph_node*, ossia::task*> flow_nodes;
+  bool fuse_chains{};
 };
 
 struct custom_parallel_exec
@@ -0,0 +1,1023 @@
+#include <ossia/dataflow/connection.hpp>
+#include <ossia/dataflow/execution_state.hpp>
+#include <ossia/dataflow/graph/replay_capture.hpp>
+#include <ossia/dataflow/graph_edge.hpp>
+#include <ossia/dataflow/graph_node.hpp>
+#include <ossia/dataflow/port.hpp>
+#include <ossia/detail/algorithms.hpp>
+#include <ossia/network/base/node_functions.hpp>
+#include <ossia/network/base/osc_address.hpp>
+#include <ossia/network/base/protocol.hpp>
+#include <ossia/network/exceptions.hpp>
+#include <ossia/network/generic/generic_device.hpp>
+
+#if defined(OSSIA_PROTOCOL_MIDI)
+#include <ossia/protocols/midi/detail/midi_impl.hpp>
+#include <ossia/protocols/midi/midi_protocol.hpp>
+#endif
+
+#include <cstring>
+#include <istream>
+#include <ostream>
+
+namespace ossia
+{
+namespace
+{
+constexpr char replay_magic[8] = {'O', 'S', 'S', 'I', 'A', 'R', 'P', 'L'};
+constexpr uint32_t replay_version = 1;
+
+// What replay_recorder reads from a parameter at each tick
+enum : uint8_t
+{
+  parameter_received = 1 << 0,
+  parameter_polled = 1 << 1
+};
+
+struct capture_writer
+{
+  std::ostream& s;
+
+  void u8(uint8_t v) { s.put(char(v)); }
+  void u16(uint16_t v)
+  {
+    const char b[2] = {char(v & 0xFF), char(v >> 8)};
+    s.write(b, 2);
+  }
+  void u32(uint32_t v)
+  {
+    char b[4];
+    for(int i = 0; i < 4; i++)
+      b[i] = char((v >> (8 * i)) & 0xFF);
+    s.write(b, 4);
+  }
+  void u64(uint64_t v)
+  {
+    char b[8];
+    for(int i = 0; i < 8; i++)
+      b[i] = char((v >> (8 * i)) & 0xFF);
+    s.write(b, 8);
+  }
+  void i64(int64_t v) { u64(uint64_t(v)); }
+  void f32(float v)
+  {
+    uint32_t r;
+    std::memcpy(&r, &v, 4);
+    u32(r);
+  }
+  void f64(double v)
+  {
+    uint64_t r;
+    std::memcpy(&r, &v, 8);
+    u64(r);
+  }
+  void str(std::string_view v)
+  {
+    u32(v.size());
+    s.write(v.data(), v.size());
+  }
+
+  template <std::size_t N>
+  void vec(const std::array<float, N>& v)
+  {
+    for(float f : v)
+      f32(f);
+  }
+
+  void value(const ossia::value& v)
+  {
+    const auto t = v.get_type();
+    u8(uint8_t(t));
+    switch(t)
+    {
+      case ossia::val_type::FLOAT:
+        f32(v.get<float>());
+        break;
+      case ossia::val_type::INT:
+        u32(uint32_t(v.get<int>()));
+        break;
+      case ossia::val_type::VEC2F:
+        vec(v.get<ossia::vec2f>());
+        break;
+      case ossia::val_type::VEC3F:
+        vec(v.get<ossia::vec3f>());
+        break;
+      case ossia::val_type::VEC4F:
+        vec(v.get<ossia::vec4f>());
+        break;
+      case ossia::val_type::BOOL:
+        u8(v.get<bool>());
+        break;
+      case ossia::val_type::STRING:
+        str(v.get<std::string>());
+        break;
+      case ossia::val_type::LIST: {
+        auto& l = v.get<std::vector<ossia::value>>();
+        u32(l.size());
+        for(auto& e : l)
+          value(e);
+        break;
+      }
+      case ossia::val_type::MAP: {
+        auto& m = v.get<ossia::value_map_type>();
+        u32(m.size());
+        for(auto& [k, e] : m)
+        {
+          str(k);
+          value(e);
+        }
+        break;
+      }
+      default:
+        break;
+    }
+  }
+
+  void token(const ossia::token_request& t)
+  {
+    i64(t.prev_date.impl);
+    i64(t.date.impl);
+    i64(t.parent_duration.impl);
+    i64(t.offset.impl);
+    f64(t.speed);
+    f64(t.tempo);
+    u16(t.signature.upper);
+    u16(t.signature.lower);
+    f64(t.musical_start_last_signature);
+    f64(t.musical_start_last_bar);
+    f64(t.musical_start_position);
+    f64(t.musical_end_last_bar);
+    f64(t.musical_end_position);
+    u8(uint8_t(t.start_discontinuous) | (uint8_t(t.end_discontinuous) << 1));
+  }
+
+  void port(const replay_capture::port& p)
+  {
+    u8(p.type);
+    u8(p.is_event);
+    u32(p.parameter);
+    u32(p.midi_device);
+    u8(uint8_t(p.midi_channel));
+  }
+};
+
+struct capture_reader
+{
+  std::istream& s;
+
+  [[noreturn]] static void fail(const char* what)
+  {
+    throw ossia::parse_error(std::string("replay_capture: ") + what);
+  }
+
+  void read(char* b, std::size_t n)
+  {
+    if(!s.read(b, n))
+      fail("unexpected end of stream");
+  }
+
+  uint8_t u8()
+  {
+    char b;
+    read(&b, 1);
+    return uint8_t(b);
+  }
+  uint16_t u16()
+  {
+    unsigned char b[2];
+    read(reinterpret_cast<char*>(b), 2);
+    return uint16_t(b[0] | (b[1] << 8));
+  }
+  uint32_t u32()
+  {
+    unsigned char b[4];
+    read(reinterpret_cast<char*>(b), 4);
+    uint32_t v = 0;
+    for(int i = 0; i < 4; i++)
+      v |= uint32_t(b[i]) << (8 * i);
+    return v;
+  }
+  uint64_t u64()
+  {
+    unsigned char b[8];
+    read(reinterpret_cast<char*>(b), 8);
+    uint64_t v = 0;
+    for(int i = 0; i < 8; i++)
+      v |= uint64_t(b[i]) << (8 * i);
+    return v;
+  }
+  int64_t i64() { return int64_t(u64()); }
+  float f32()
+  {
+    const uint32_t r = u32();
+    float v;
+    std::memcpy(&v, &r, 4);
+    return v;
+  }
+  double f64()
+  {
+    const uint64_t r = u64();
+    double v;
+    std::memcpy(&v, &r, 8);
+    return v;
+  }
+
+  //! Element counts: the elements are read one by one, so a corrupted count
+  //! fails at the end of the stream instead of allocating
+  uint32_t count() { return u32(); }
+
+  std::string str()
+  {
+    std::string v;
+    const uint32_t n = u32();
+    char buf[256];
+    for(uint32_t done = 0; done < n;)
+    {
+      const uint32_t k = std::min<uint32_t>(n - done, sizeof(buf));
+      read(buf, k);
+      v.append(buf, k);
+      done += k;
+    }
+    return v;
+  }
+
+  template <std::size_t N>
+  std::array<float, N> vec()
+  {
+    std::array<float, N> v;
+    for(float& f : v)
+      f = f32();
+    return v;
+  }
+
+  //! Lists and maps nested deeper than this are considered corrupted
+  static constexpr int max_depth = 64;
+
+  ossia::value value(int depth = 0)
+  {
+    if(depth > max_depth)
+      fail("nesting too deep");
+
+    switch(ossia::val_type(u8()))
+    {
+      case ossia::val_type::FLOAT:
+        return f32();
+      case ossia::val_type::INT:
+        return int(u32());
+      case ossia::val_type::VEC2F:
+        return vec<2>();
+      case ossia::val_type::VEC3F:
+        return vec<3>();
+      case ossia::val_type::VEC4F:
+        return vec<4>();
+      case ossia::val_type::IMPULSE:
+        return ossia::impulse{};
+      case ossia::val_type::BOOL:
+        return bool(u8());
+      case ossia::val_type::STRING:
+        return str();
+      case ossia::val_type::LIST: {
+        std::vector<ossia::value> l;
+        for(uint32_t i = 0, n = count(); i < n; i++)
+          l.push_back(value(depth + 1));
+        return l;
+      }
+      case ossia::val_type::MAP: {
+        ossia::value_map_type m;
+        for(uint32_t i = 0, n = count(); i < n; i++)
+        {
+          auto k = str();
+          m.emplace_back(std::move(k), value(depth + 1));
+        }
+        return m;
+      }
+      case ossia::val_type::NONE:
+        return ossia::value{};
+      default:
+        fail("invalid value type");
+    }
+  }
+
+  ossia::token_request token()
+  {
+    ossia::token_request t;
+    t.prev_date.impl = i64();
+    t.date.impl = i64();
+    t.parent_duration.impl = i64();
+    t.offset.impl = i64();
+    t.speed = f64();
+    t.tempo = f64();
+    t.signature.upper = u16();
+    t.signature.lower = u16();
+    t.musical_start_last_signature = f64();
+    t.musical_start_last_bar = f64();
+    t.musical_start_position = f64();
+    t.musical_end_last_bar = f64();
+    t.musical_end_position = f64();
+    const uint8_t flags = u8();
+    t.start_discontinuous = flags & 1;
+    t.end_discontinuous = flags & 2;
+    return t;
+  }
+
+  replay_capture::port port()
+  {
+    replay_capture::port p;
+    p.type = u8();
+    p.is_event = u8();
+    p.parameter = u32();
+    p.midi_device = u32();
+    p.midi_channel = int8_t(u8());
+    return p;
+  }
+};
+
+//! Checks that the indices of a capture refer to existing elements
+void validate(const replay_capture& c)
+{
+  auto check = [](bool ok) {
+    if(!ok)
+      capture_reader::fail("invalid index");
+  };
+  auto check_port = [&](const replay_capture::port& p) {
+    check(p.parameter == replay_capture::none || p.parameter < c.parameters.size());
+    check(p.midi_device == replay_capture::none || p.midi_device < c.midi_devices.size());
+  };
+
+  for(auto& n : c.nodes)
+  {
+    for(auto& p : n.inlets)
+      check_port(p);
+    for(auto& p : n.outlets)
+      check_port(p);
+  }
+  for(auto& e : c.edges)
+  {
+    check(e.out_node < c.nodes.size() && e.in_node < c.nodes.size());
+    check(e.outlet < c.nodes[e.out_node].outlets.size());
+    check(e.inlet < c.nodes[e.in_node].inlets.size());
+  }
+  for(auto& t : c.ticks)
+  {
+    for(auto& tk : t.tokens)
+      check(tk.node < c.nodes.size());
+    for(auto& v : t.values)
+      check(v.parameter < c.parameters.size());
+    for(auto& m : t.midi)
+      check(m.device < c.midi_devices.size());
+  }
+}
+
+inline ossia::inlet* make_inlet(uint8_t type)
+{
+  switch(type)
+  {
+    case ossia::audio_port::which:
+      return new ossia::audio_inlet;
+    case ossia::midi_port::which:
+      return new ossia::midi_inlet;
+    case ossia::texture_port::which:
+      return new ossia::texture_inlet;
+    case ossia::geometry_port::which:
+      return new ossia::geometry_inlet;
+    default:
+      return new ossia::value_inlet;
+  }
+}
+
+inline ossia::outlet* make_outlet(uint8_t type)
+{
+  switch(type)
+  {
+    case ossia::audio_port::which:
+      return new ossia::audio_outlet;
+    case ossia::midi_port::which:
+      return new ossia::midi_outlet;
+    case ossia::texture_port::which:
+      return new ossia::texture_outlet;
+    case ossia::geometry_port::which:
+      return new ossia::geometry_outlet;
+    default:
+      return new ossia::value_outlet;
+  }
+}
+
+inline ossia::connection make_connection(uint8_t index)
+{
+  using c = ossia::connection;
+  switch(index)
+  {
+    case c::index_of<ossia::immediate_glutton_connection>().index():
+      return ossia::immediate_glutton_connection{};
+    case c::index_of<ossia::immediate_strict_connection>().index():
+      return ossia::immediate_strict_connection{};
+    case c::index_of<ossia::delayed_glutton_connection>().index():
+      return ossia::delayed_glutton_connection{};
+    case c::index_of<ossia::delayed_strict_connection>().index():
+      return ossia::delayed_strict_connection{};
+    case c::index_of<ossia::dependency_connection>().index():
+      return ossia::dependency_connection{};
+    default:
+      return ossia::immediate_glutton_connection{};
+  }
+}
+
+//! Stands for the nodes which the factory of the replay_player does not know
+class replay_node final : public ossia::graph_node
+{
+public:
+  explicit replay_node(const replay_capture::node& n)
+      : m_label{n.label}
+  {
+    for(auto& p : n.inlets)
+      m_inlets.push_back(make_inlet(p.type));
+    for(auto& p : n.outlets)
+      m_outlets.push_back(make_outlet(p.type));
+  }
+
+  std::string label() const noexcept override { return m_label; }
+
+private:
+  std::string m_label;
+};
+
+bool ports_match(const ossia::graph_node& n, const replay_capture::node& desc)
+{
+  auto& ins = n.root_inputs();
+  auto& outs = n.root_outputs();
+  if(ins.size() != desc.inlets.size() || outs.size() != desc.outlets.size())
+    return false;
+  for(std::size_t i = 0; i < ins.size(); i++)
+    if(ins[i]->which() != desc.inlets[i].type)
+      return false;
+  for(std::size_t i = 0; i < outs.size(); i++)
+    if(outs[i]->which() != desc.outlets[i].type)
+      return false;
+  return true;
+}
+}
+
+void replay_capture::clear()
+{
+  midi_devices.clear();
+  parameters.clear();
+  nodes.clear();
+  edges.clear();
+  ticks.clear();
+}
+
+void replay_capture::write(std::ostream& s) const
+{
+  capture_writer w{s};
+  s.write(replay_magic, sizeof(replay_magic));
+  w.u32(replay_version);
+  w.u32(uint32_t(sample_rate));
+
+  w.u32(midi_devices.size());
+  for(auto& d : midi_devices)
+    w.str(d);
+
+  w.u32(parameters.size());
+  for(auto& p : parameters)
+  {
+    w.str(p.address);
+    w.u8(uint8_t(p.type));
+  }
+
+  w.u32(nodes.size());
+  for(auto& n : nodes)
+  {
+    w.str(n.label);
+    w.u32(n.inlets.size());
+    for(auto& p : n.inlets)
+      w.port(p);
+    w.u32(n.outlets.size());
+    for(auto& p : n.outlets)
+      w.port(p);
+  }
+
+  w.u32(edges.size());
+  for(auto& e : edges)
+  {
+    w.u32(e.out_node);
+    w.u32(e.outlet);
+    w.u32(e.in_node);
+    w.u32(e.inlet);
+    w.u8(e.connection);
+  }
+
+  w.u32(ticks.size());
+  for(auto& t : ticks)
+  {
+    w.u32(t.frames);
+
+    w.u32(t.tokens.size());
+    for(auto& tk : t.tokens)
+    {
+      w.u32(tk.node);
+      w.token(tk.request);
+    }
+
+    w.u32(t.values.size());
+    for(auto& v : t.values)
+    {
+      w.u32(v.parameter);
+      w.u32(v.values.size());
+      for(auto& val : v.values)
+        w.value(val);
+    }
+
+    w.u32(t.midi.size());
+    for(auto& m : t.midi)
+    {
+      w.u32(m.device);
+      w.u32(m.messages.size());
+      for(auto& msg : m.messages)
+      {
+        w.f64(double(msg.timestamp));
+        w.u32(msg.bytes.size());
+        for(auto b : msg.bytes)
+          w.u8(b);
+      }
+    }
+  }
+}
+
+replay_capture replay_capture::read(std::istream& s)
+{
+  capture_reader r{s};
+  char magic[sizeof(replay_magic)];
+  r.read(magic, sizeof(magic));
+  if(std::memcmp(magic, replay_magic, sizeof(magic)) != 0)
+    r.fail("not a capture");
+  if(r.u32() != replay_version)
+    r.fail("unsupported version");
+
+  replay_capture c;
+  c.sample_rate = int(r.u32());
+
+  for(uint32_t i = 0, n = r.count(); i < n; i++)
+    c.midi_devices.push_back(r.str());
+
+  for(uint32_t i = 0, n = r.count(); i < n; i++)
+  {
+    auto& p = c.parameters.emplace_back();
+    p.address = r.str();
+    p.type = ossia::val_type(r.u8());
+  }
+
+  for(uint32_t i = 0, n = r.count(); i < n; i++)
+  {
+    auto& node = c.nodes.emplace_back();
+    node.label = r.str();
+    for(uint32_t k = 0, m = r.count(); k < m; k++)
+      node.inlets.push_back(r.port());
+    for(uint32_t k = 0, m = r.count(); k < m; k++)
+      node.outlets.push_back(r.port());
+  }
+
+  for(uint32_t i = 0, n = r.count(); i < n; i++)
+  {
+    auto& e = c.edges.emplace_back();
+    e.out_node = r.u32();
+    e.outlet = r.u32();
+    e.in_node = r.u32();
+    e.inlet = r.u32();
+    e.connection = r.u8();
+  }
+
+  for(uint32_t i = 0, n = r.count(); i < n; i++)
+  {
+    auto& t = c.ticks.emplace_back();
+    t.frames = r.u32();
+
+    for(uint32_t k = 0, m = r.count(); k < m; k++)
+    {
+      auto& tk = t.tokens.emplace_back();
+      tk.node = r.u32();
+      tk.request = r.token();
+    }
+
+    for(uint32_t k = 0, m = r.count(); k < m; k++)
+    {
+      auto& v = t.values.emplace_back();
+      v.parameter = r.u32();
+      for(uint32_t j = 0, vn = r.count(); j < vn; j++)
+        v.values.push_back(r.value());
+    }
+
+    for(uint32_t k = 0, m = r.count(); k < m; k++)
+    {
+      auto& midi = t.midi.emplace_back();
+      midi.device = r.u32();
+      for(uint32_t j = 0, mn = r.count(); j < mn; j++)
+      {
+        auto& msg = midi.messages.emplace_back();
+        msg.timestamp = decltype(msg.timestamp)(r.f64());
+        for(uint32_t b = 0, bn = r.count(); b < bn; b++)
+          msg.bytes.push_back(r.u8());
+      }
+    }
+  }
+
+  validate(c);
+  return c;
+}
+
+replay_recorder::replay_recorder(std::shared_ptr<graph_interface> graph)
+    : m_graph{std::move(graph)}
+{
+  pool = m_graph->pool;
+}
+
+replay_recorder::~replay_recorder() = default;
+
+void replay_recorder::start()
+{
+  m_topology_pending = true;
+  m_recording = true;
+}
+
+void replay_recorder::stop()
+{
+  m_recording = false;
+}
+
+void replay_recorder::add_node(ossia::node_ptr n)
+{
+  m_graph->add_node(std::move(n));
+}
+
+void replay_recorder::remove_node(const ossia::node_ptr& n)
+{
+  if(auto it = m_node_index.find(n.get()); it != m_node_index.end())
+  {
+    m_nodes[it->second] = nullptr;
+    m_node_index.erase(it);
+  }
+  m_graph->remove_node(n);
+}
+
+void replay_recorder::connect(ossia::edge_ptr e)
+{
+  m_graph->connect(std::move(e));
+}
+
+void replay_recorder::disconnect(const ossia::edge_ptr& e)
+{
+  m_graph->disconnect(e);
+}
+
+void replay_recorder::disconnect(ossia::graph_edge* e)
+{
+  m_graph->disconnect(e);
+}
+
+void replay_recorder::mark_dirty()
+{
+  m_graph->mark_dirty();
+}
+
+void replay_recorder::state(execution_state& e)
+{
+  if(m_recording)
+  {
+    if(m_topology_pending.exchange(false))
+      record_topology(e);
+    record_tick(e);
+  }
+  m_graph->state(e);
+}
+
+void replay_recorder::clear()
+{
+  m_nodes.clear();
+  m_node_index.clear();
+  m_graph->clear();
+}
+
+void replay_recorder::print(std::ostream& s)
+{
+  m_graph->print(s);
+}
+
+tcb::span<ossia::graph_node* const> replay_recorder::get_nodes() const noexcept
+{
+  return m_graph->get_nodes();
+}
+
+uint32_t replay_recorder::record_parameter(ossia::net::parameter_base& p)
+{
+  auto [it, inserted] = m_parameter_index.try_emplace(&p, m_parameters.size());
+  if(inserted)
+  {
+    m_parameters.push_back(&p);
+    // Empty so that the value of the polled parameters is in the first tick
+    m_last_values.emplace_back();
+    m_parameter_flags.push_back(0);
+    m_capture.parameters.push_back(
+        {ossia::net::address_string_from_node(p), p.get_value_type()});
+  }
+  return it->second;
+}
+
+replay_capture::port replay_recorder::record_port(
+    std::size_t which, const ossia::destination_t& address, bool is_event)
+{
+  replay_capture::port res;
+  res.type = uint8_t(which);
+  res.is_event = is_event;
+
+  auto record_midi_device = [&](ossia::net::device_base& dev) {
+    auto [it, inserted] = m_midi_index.try_emplace(
+        &dev.get_protocol(), uint32_t(m_capture.midi_devices.size()));
+    if(inserted)
+      m_capture.midi_devices.push_back(dev.get_name());
+    res.midi_device = it->second;
+  };
+
+  if(auto p = address.target<ossia::net::parameter_base*>())
+  {
+    if(which == ossia::value_port::which)
+    {
+      res.parameter = record_parameter(**p);
+    }
+    else if(which == ossia::midi_port::which)
+    {
+      record_midi_device((*p)->get_node().get_device());
+    }
+  }
+  else if(auto n = address.target<ossia::net::node_base*>())
+  {
+    if(which == ossia::midi_port::which)
+    {
+      auto& node = **n;
+      auto& dev = node.get_device();
+      record_midi_device(dev);
+#if defined(OSSIA_PROTOCOL_MIDI)
+      if(node.get_parent() == &dev.get_root_node())
+        res.midi_channel = int8_t(
+            static_cast<const ossia::net::midi::channel_node&>(node).channel);
+#endif
+    }
+  }
+  return res;
+}
+
+void replay_recorder::record_topology(const execution_state& e)
+{
+  m_capture.clear();
+  m_nodes.clear();
+  m_parameters.clear();
+  m_last_values.clear();
+  m_parameter_flags.clear();
+  m_node_index.clear();
+  m_parameter_index.clear();
+  m_midi_index.clear();
+
+  m_capture.sample_rate = e.sampleRate;
+
+  for(auto node : m_graph->get_nodes())
+  {
+    m_node_index[node] = m_nodes.size();
+    m_nodes.push_back(node);
+  }
+
+  for(auto node : m_nodes)
+  {
+    auto& desc = m_capture.nodes.emplace_back();
+    desc.label = node->label();
+
+    for(auto in : node->root_inputs())
+    {
+      bool is_event = false;
+      if(auto vp = in->target<ossia::value_port>())
+        is_event = vp->is_event;
+
+      auto p = record_port(in->which(), in->address, is_event);
+      if(p.parameter != replay_capture::none)
+        m_parameter_flags[p.parameter]
+            |= is_event ? parameter_received : parameter_polled;
+      desc.inlets.push_back(p);
+    }
+
+    for(auto out : node->root_outputs())
+      desc.outlets.push_back(record_port(out->which(), out->address, false));
+  }
+
+  for(std::size_t i = 0; i < m_nodes.size(); i++)
+  {
+    auto& outs = m_nodes[i]->root_outputs();
+    for(std::size_t k = 0; k < outs.size(); k++)
+    {
+      for(auto edge : outs[k]->targets)
+      {
+        auto it = m_node_index.find(edge->in_node.get());
+        if(it == m_node_index.end())
+          continue;
+
+        auto& ins = edge->in_node->root_inputs();
+        auto in_it = ossia::find(ins, edge->in);
+        if(in_it == ins.end())
+          continue;
+
+        m_capture.edges.push_back(
+            {uint32_t(i), uint32_t(k), it->second, uint32_t(in_it - ins.begin()),
+             uint8_t(edge->con.which().index())});
+      }
+    }
+  }
+}
+
+void replay_recorder::record_tick(const execution_state& e)
+{
+  auto& t = m_capture.ticks.emplace_back();
+  t.frames = e.bufferSize;
+
+  for(std::size_t i = 0; i < m_nodes.size(); i++)
+  {
+    if(auto node = m_nodes[i])
+      for(const auto& tk : node->requested_tokens)
+        t.tokens.push_back({uint32_t(i), tk});
+  }
+
+  for(const auto& [param, values] : e.m_receivedValues)
+  {
+    if(values.empty())
+      continue;
+    auto it = m_parameter_index.find(param);
+    if(it == m_parameter_index.end())
+      continue;
+
+    const uint32_t idx = it->second;
+    if(!(m_parameter_flags[idx] & parameter_received))
+      continue;
+
+    t.values.push_back({idx, {values.begin(), values.end()}});
+
+    // Replaying the received values also gives the current value
+    if(m_parameter_flags[idx] & parameter_polled)
+      m_last_values[idx] = param->value();
+  }
+
+  for(std::size_t i = 0; i < m_parameters.size(); i++)
+  {
+    if(!(m_parameter_flags[i] & parameter_polled))
+      continue;
+
+    auto v = m_parameters[i]->value();
+    if(v != m_last_values[i])
+    {
+      t.values.push_back({uint32_t(i), {v}});
+      m_last_values[i] = std::move(v);
+    }
+  }
+
+#if defined(OSSIA_PROTOCOL_MIDI)
+  for(const auto& [proto, midi] : e.m_receivedMidi)
+  {
+    if(midi.messages.empty())
+      continue;
+    auto it = m_midi_index.find(static_cast<const ossia::net::protocol_base*>(proto));
+    if(it == m_midi_index.end())
+      continue;
+
+    t.midi.push_back({it->second, {midi.messages.begin(), midi.messages.end()}});
+  }
+#endif
+}
+
+replay_player::replay_player(
+    replay_capture c, const graph_setup_options& opt, const node_factory& factory)
+    : m_capture{std::move(c)}
+    , m_state{std::make_unique<ossia::execution_state>()}
+    , m_graph{ossia::make_graph(opt)}
+{
+  const auto& capture = m_capture;
+  auto& st = *m_state;
+  st.sampleRate = capture.sample_rate;
+
+  // Parameters, on one device per device name of the capture
+  ossia::hash_map<std::string, ossia::net::device_base*> devices;
+  for(auto& p : capture.parameters)
+  {
+    std::string_view address = p.address;
+    std::string_view dev_name, path = address;
+    if(auto sep = address.find(':'); sep != std::string_view::npos)
+    {
+      dev_name = address.substr(0, sep);
+      path = address.substr(sep + 1);
+    }
+
+    auto& dev = devices[std::string(dev_name)];
+    if(!dev)
+    {
+      dev = m_devices
+                .emplace_back(
+                    std::make_unique<ossia::net::generic_device>(std::string(dev_name)))
+                .get();
+      st.register_device(dev);
+    }
+
+    auto& node = ossia::net::find_or_create_node(dev->get_root_node(), path);
+    auto param = node.get_parameter();
+    if(!param)
+      param = node.create_parameter(p.type);
+    m_parameters.push_back(param);
+  }
+  st.apply_device_changes();
+
+  // Nodes
+  m_midi_targets.resize(capture.midi_devices.size());
+  for(auto& desc : capture.nodes)
+  {
+    ossia::node_ptr n;
+    if(factory)
+      n = factory(desc, st);
+    if(!n || !ports_match(*n, desc))
+    {
+      n = std::make_shared<replay_node>(desc);
+      n->prepare(st);
+      m_placeholders++;
+    }
+
+    auto& ins = n->root_inputs();
+    for(std::size_t i = 0; i < ins.size(); i++)
+    {
+      auto& port = desc.inlets[i];
+      auto& in = *ins[i];
+      in.address = {};
+      if(port.parameter != replay_capture::none && m_parameters[port.parameter])
+      {
+        in.address = m_parameters[port.parameter];
+        st.register_port(in);
+      }
+      else if(port.midi_device != replay_capture::none)
+      {
+        if(auto mp = in.target<ossia::midi_port>())
+          m_midi_targets[port.midi_device].push_back({mp, port.midi_channel});
+      }
+    }
+
+    auto& outs = n->root_outputs();
+    for(std::size_t i = 0; i < outs.size(); i++)
+    {
+      auto& port = desc.outlets[i];
+      auto& out = *outs[i];
+      out.address = {};
+      if(port.parameter != replay_capture::none && m_parameters[port.parameter])
+        out.address = m_parameters[port.parameter];
+    }
+
+    m_graph->add_node(n);
+    m_nodes.push_back(std::move(n));
+  }
+
+  // Cables
+  for(auto& e : capture.edges)
+  {
+    auto& out_node = m_nodes[e.out_node];
+    auto& in_node = m_nodes[e.in_node];
+    m_graph->connect(m_graph->allocate_edge(
+        make_connection(e.connection), out_node->root_outputs()[e.outlet],
+        in_node->root_inputs()[e.inlet], out_node, in_node));
+  }
+}
+
+replay_player::~replay_player()
+{
+  m_graph->clear();
+  m_nodes.clear();
+}
+
+void replay_player::tick(std::size_t i)
+{
+  auto& t = m_capture.ticks[i];
+  auto& st = *m_state;
+
+  for(auto& v : t.values)
+    if(auto p = m_parameters[v.parameter])
+      for(auto& val : v.values)
+        p->push_value(val);
+
+  st.begin_tick();
+  st.samples_since_start += t.frames;
+  st.bufferSize = int(t.frames);
+
+  for(auto& m : t.midi)
+  {
+    for(auto& target : m_midi_targets[m.device])
+    {
+      for(auto& msg : m.messages)
+        if(target.channel == -1 || msg.get_channel() == target.channel)
+          target.port->push_back(msg);
+    }
+  }
+
+  for(auto& tk : t.tokens)
+    m_nodes[tk.node]->request(tk.request);
+
+  m_graph->state(st);
+  st.commit();
+}
+}
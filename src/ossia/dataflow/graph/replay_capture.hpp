@@ -0,0 +1,248 @@
+#pragma once
+#include <ossia/dataflow/graph/graph_interface.hpp>
+#include <ossia/dataflow/token_request.hpp>
+#include <ossia/detail/hash_map.hpp>
+#include <ossia/network/value/value.hpp>
+
+#include <libremidi/message.hpp>
+
+#include <atomic>
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ossia
+{
+namespace net
+{
+class device_base;
+class parameter_base;
+class protocol_base;
+}
+
+/**
+ * @brief Per-tick capture of the dataflow graph of a running session.
+ *
+ * Holds the topology of the graph when the capture started, and for each tick
+ * the token requests of the nodes and what the devices sent to the inlets:
+ * the values received by the parameters and the MIDI messages.
+ *
+ * replay_recorder fills it, replay_player rebuilds the graph and runs the ticks
+ * again, e.g. to measure the tick duration of a show across library versions.
+ *
+ * Only the inlets addressed to a parameter are captured: audio inputs,
+ * and inlets addressed to a node or a pattern, receive nothing on replay.
+ */
+struct OSSIA_EXPORT replay_capture
+{
+  static constexpr uint32_t none = UINT32_MAX;
+
+  struct port
+  {
+    //! audio_port::which, midi_port::which, ...
+    uint8_t type{};
+    bool is_event{};
+
+    //! For the inlets and outlets addressed to a parameter
+    uint32_t parameter{none};
+
+    //! For the inlets addressed to a MIDI device, and the channel for a
+    //! channel node
+    uint32_t midi_device{none};
+    int8_t midi_channel{-1};
+  };
+
+  struct node
+  {
+    std::string label;
+    std::vector<port> inlets;
+    std::vector<port> outlets;
+  };
+
+  struct edge
+  {
+    uint32_t out_node{};
+    uint32_t outlet{};
+    uint32_t in_node{};
+    uint32_t inlet{};
+
+    //! Index in the ossia::connection variant
+    uint8_t connection{};
+  };
+
+  struct parameter
+  {
+    //! device:/path
+    std::string address;
+    ossia::val_type type{ossia::val_type::NONE};
+  };
+
+  struct token
+  {
+    uint32_t node{};
+    ossia::token_request request;
+  };
+
+  struct received_values
+  {
+    uint32_t parameter{};
+    std::vector<ossia::value> values;
+  };
+
+  struct received_midi
+  {
+    uint32_t device{};
+    std::vector<libremidi::message> messages;
+  };
+
+  struct tick
+  {
+    uint32_t frames{};
+    std::vector<token> tokens;
+    std::vector<received_values> values;
+    std::vector<received_midi> midi;
+  };
+
+  int sample_rate{44100};
+  std::vector<std::string> midi_devices;
+  std::vector<parameter> parameters;
+  std::vector<node> nodes;
+  std::vector<edge> edges;
+  std::vector<tick> ticks;
+
+  void clear();
+
+  //! Binary format, independent of the endianness of the host
+  void write(std::ostream& s) const;
+
+  //! Throws ossia::parse_error if the stream is not a valid capture
+  static replay_capture read(std::istream& s);
+};
+
+/**
+ * @brief Graph which records a replay_capture of the graph it wraps.
+ *
+ * Replaces the graph given to the tick function of the engine;
+ * all the calls are forwarded to the wrapped graph.
+ * The topology is recorded at the first tick following start():
+ * nodes added afterwards are not part of the capture, and pure dependency
+ * edges are not recorded.
+ *
+ * Recording allocates in the execution thread: it is meant for capture
+ * sessions, not to be left enabled during a show.
+ */
+class OSSIA_EXPORT replay_recorder final : public graph_interface
+{
+public:
+  explicit replay_recorder(std::shared_ptr<graph_interface> graph);
+  ~replay_recorder() override;
+
+  [[nodiscard]] const std::shared_ptr<graph_interface>& graph() const noexcept
+  {
+    return m_graph;
+  }
+
+  //! Clears the previous capture
+  void start();
+  void stop();
+  [[nodiscard]] bool recording() const noexcept { return m_recording; }
+
+  //! To be accessed once stopped and after the end of the current tick
+  [[nodiscard]] replay_capture& capture() noexcept { return m_capture; }
+
+  void add_node(ossia::node_ptr) override;
+  void remove_node(const ossia::node_ptr&) override;
+  void connect(ossia::edge_ptr) override;
+  void disconnect(const ossia::edge_ptr&) override;
+  void disconnect(ossia::graph_edge*) override;
+  void mark_dirty() override;
+  void state(execution_state& e) override;
+  void clear() override;
+  void print(std::ostream&) override;
+  [[nodiscard]] tcb::span<ossia::graph_node* const> get_nodes() const noexcept override;
+
+private:
+  void record_topology(const execution_state& e);
+  void record_tick(const execution_state& e);
+  replay_capture::port record_port(
+      std::size_t which, const ossia::destination_t& address, bool is_event);
+  uint32_t record_parameter(ossia::net::parameter_base& p);
+
+  std::shared_ptr<graph_interface> m_graph;
+  replay_capture m_capture;
+
+  // Indexed like the tables of the capture
+  std::vector<ossia::graph_node*> m_nodes;
+  std::vector<ossia::net::parameter_base*> m_parameters;
+  std::vector<ossia::value> m_last_values;
+  std::vector<uint8_t> m_parameter_flags;
+
+  ossia::hash_map<const ossia::graph_node*, uint32_t> m_node_index;
+  ossia::hash_map<const ossia::net::parameter_base*, uint32_t> m_parameter_index;
+  ossia::hash_map<const ossia::net::protocol_base*, uint32_t> m_midi_index;
+
+  std::atomic_bool m_recording{};
+  std::atomic_bool m_topology_pending{};
+};
+
+/**
+ * @brief Rebuilds the graph of a replay_capture and runs its ticks.
+ *
+ * The nodes are created by the factory from their label;
+ * when it returns nothing, or a node whose ports do not match the capture,
+ * a node with the same ports which does nothing is used instead.
+ * The parameters are recreated on local devices with the same names,
+ * and the received values are pushed to them before each tick.
+ */
+class OSSIA_EXPORT replay_player
+{
+public:
+  using node_factory = std::function<ossia::node_ptr(
+      const replay_capture::node&, const ossia::execution_state&)>;
+
+  //! The capture is copied, so that a temporary, e.g. replay_capture::read(f),
+  //! can be given
+  replay_player(
+      replay_capture capture, const graph_setup_options& opt,
+      const node_factory& factory = {});
+  ~replay_player();
+
+  replay_player(const replay_player&) = delete;
+  replay_player(replay_player&&) = delete;
+  replay_player& operator=(const replay_player&) = delete;
+  replay_player& operator=(replay_player&&) = delete;
+
+  [[nodiscard]] std::size_t size() const noexcept { return m_capture.ticks.size(); }
+
+  //! Runs the i-th tick of the capture
+  void tick(std::size_t i);
+
+  [[nodiscard]] ossia::execution_state& state() noexcept { return *m_state; }
+  [[nodiscard]] ossia::graph_interface& graph() noexcept { return *m_graph; }
+  [[nodiscard]] const std::vector<ossia::node_ptr>& nodes() const noexcept
+  {
+    return m_nodes;
+  }
+
+  //! Number of nodes which the factory could not create
+  [[nodiscard]] std::size_t placeholders() const noexcept { return m_placeholders; }
+
+private:
+  struct midi_target
+  {
+    ossia::midi_port* port{};
+    int channel{-1};
+  };
+
+  replay_capture m_capture;
+  std::vector<std::unique_ptr<ossia::net::device_base>> m_devices;
+  std::vector<ossia::net::parameter_base*> m_parameters;
+  std::vector<std::vector<midi_target>> m_midi_targets;
+  std::unique_ptr<ossia::execution_state> m_state;
+  std::shared_ptr<ossia::graph_interface> m_graph;
+  std::vector<ossia::node_ptr> m_nodes;
+  std::size_t m_placeholders{};
+};
+}
@@ -9,6 +9,12 @@
 #include <ossia/editor/scenario/scenario.hpp>
 #include <ossia/editor/scenario/time_interval.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <optional>
+#include <vector>
+
 #if defined(SCORE_BENCHMARK)
 #if __has_include(<valgrind/callgrind.h>)
 #include <QFile>
@@ -214,125 +220,245 @@ struct precise_score_tick
   }
 };
 
-/*
+// 1 tick per buffer, split at the dates where the scenario starts, stops
+// or jumps a node: each sub-block executes the nodes active in it.
 struct split_score_tick
 {
-public:
-  split_score_tick(
-      ossia::execution_state& a, ossia::graph_interface& b,
-      ossia::time_interval& c)
-      : st{a}, g{b}, itv{c}
-  {
-  }
-
   ossia::execution_state& st;
   ossia::graph_interface& g;
-  ossia::time_interval& itv;
+  ossia::scenario& scenar;
   ossia::transport_info_fun transport;
 
-  static void do_cuts(
-      ossia::flat_set<int64_t>& cuts, token_request_vec& tokens,
-      time_value cur_date)
+  struct node_requests
   {
-    for (auto it = tokens.begin(); it != tokens.end(); ++it)
+    ossia::graph_node* node{};
+    ossia::token_request_vec tokens;
+  };
+
+  struct buffers
+  {
+    std::vector<node_requests> requests;
+    std::vector<int64_t> cuts;
+  };
+  std::shared_ptr<buffers> m_buffers = std::make_shared<buffers>();
+
+  //! Samples [start, end) of the buffer written by a token,
+  //! empty for the tokens which do not move forward
+  static std::pair<int64_t, int64_t>
+  physical_range(const ossia::token_request& tk, double ratio) noexcept
+  {
+    if(tk.speed > 0.)
     {
-      if (it->date > cur_date)
-      {
-        auto token_end_offset = it->offset + abs(it->date - cur_date);
-        auto start_it = cuts.upper_bound(it->offset);
-        while (start_it != cuts.end() && (*start_it) < token_end_offset)
-        {
-          auto cut = *start_it;
-          auto N = cut - it->offset;
-          auto inserted_token = *it;
-
-          // make first token shorter
-          it->date = cur_date + N;
-
-          // make next token
-          inserted_token.offset = cut;
-          it = tokens.insert(it, inserted_token);
-
-          ++start_it;
-        }
-      }
+      const int64_t start = tk.physical_start(ratio);
+      return {start, start + tk.physical_write_duration(ratio)};
+    }
+    else if(tk.speed < 0.)
+    {
+      const int64_t start = -tk.physical_start(ratio);
+      return {start, start};
+    }
+    return {0, 0};
+  }
 
-      cur_date = it->date;
+  //! Adds the start and end of each token strictly inside (0, frames)
+  static void add_cuts(
+      std::vector<int64_t>& cuts, const ossia::token_request_vec& tokens,
+      double ratio, int64_t frames)
+  {
+    for(const auto& tk : tokens)
+    {
+      auto [start, end] = physical_range(tk, ratio);
+      if(start > 0 && start < frames)
+        cuts.push_back(start);
+      if(end > 0 && end < frames)
+        cuts.push_back(end);
     }
   }
 
-  void cut(ossia::graph_interface& g)
+  /**
+   * @brief The part of a token which lies in the samples [a, b) of the buffer,
+   * with its offset relative to a.
+   *
+   * Tokens which do not move forward are kept whole in the sub-block
+   * where they start.
+   */
+  static std::optional<ossia::token_request> split_token(
+      const ossia::token_request& tk, int64_t a, int64_t b, double ratio) noexcept
   {
-    cuts.clear();
-    requests.clear();
-    for (const auto& node : g.get_nodes())
+    const auto [start, end] = physical_range(tk, ratio);
+
+    // Rounded up so that physical_start truncates back to the exact sample
+    const double to_model = std::abs(tk.speed) / ratio;
+    auto offset = [=](int64_t samples) {
+      return time_value{int64_t(std::ceil(samples * to_model))};
+    };
+
+    if(start == end)
     {
-      for (const auto& tk : node->requested_tokens)
-      {
-        cuts.insert(tk.offset.impl);
-        cuts.insert((tk.offset + abs(tk.date - tk.prev_date)).impl);
-      }
+      if(start < a || start >= b)
+        return std::nullopt;
+      ossia::token_request res = tk;
+      if(tk.speed != 0.)
+        res.offset = offset(start - a);
+      return res;
+    }
+
+    const int64_t from = std::max(start, a);
+    const int64_t to = std::min(end, b);
+    if(from >= to)
+      return std::nullopt;
+
+    ossia::token_request res = tk;
+    res.offset = offset(from - a);
+    if(from > start)
+    {
+      res.set_start_time(
+          tk.prev_date + time_value{int64_t(std::round((from - start) * to_model))});
+      res.start_discontinuous = false;
+    }
+    if(to < end)
+    {
+      res.set_end_time(
+          tk.prev_date + time_value{int64_t(std::round((to - start) * to_model))});
+      res.end_discontinuous = false;
+    }
+    return res;
+  }
+
+  void operator()(const ossia::audio_tick_state& st) { (*this)(st.frames, st.seconds); }
+
+  void operator()(unsigned long frameCount, double seconds)
+  {
+    auto& itv = **scenar.get_time_intervals().begin();
+    auto& bufs = *m_buffers;
+#if defined(OSSIA_EXECUTION_LOG)
+    auto log = g_exec_log.start_tick();
+#endif
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    st.begin_tick();
+    st.bufferSize = (int)frameCount;
+    st.cur_date = seconds * 1e9;
+
+    const auto flicks = frameCount * st.samplesToModelRatio;
+
+    ossia::token_request tok{};
+    tok.prev_date = scenar.last_date();
+    if(tok.prev_date == ossia::Infinite)
+      tok.prev_date = 0_tv;
+    tok.date = tok.prev_date + flicks;
+
+    if(transport.allocated())
+    {
+      transport(itv.current_transport_info());
+    }
+
+    // Temporal tick for the whole buffer: time syncs, interval starts and ends
+    // show up as the bounds of the tokens requested to the nodes.
+    {
+#if defined(OSSIA_EXECUTION_LOG)
+      auto log = g_exec_log.start_temporal();
+#endif
+
+      scenar.state_impl(tok);
+    }
+
+    const double ratio = st.modelToSamplesRatio;
+    const int64_t frames = frameCount;
+    bufs.cuts.clear();
+    for(ossia::graph_node* node : g.get_nodes())
+      add_cuts(bufs.cuts, node->requested_tokens, ratio, frames);
+
+    if(bufs.cuts.empty())
+    {
+      // Nothing happens inside the buffer: same as buffer_tick
+      st.samples_since_start += frameCount;
+      run_graph();
+      clear_scenario_tokens();
+      return;
     }
 
-    for (auto& node : g.get_nodes())
+    std::sort(bufs.cuts.begin(), bufs.cuts.end());
+    bufs.cuts.erase(std::unique(bufs.cuts.begin(), bufs.cuts.end()), bufs.cuts.end());
+    bufs.cuts.push_back(frames);
+
+    bufs.requests.resize(g.get_nodes().size());
+    std::size_t n_requests = 0;
+    for(ossia::graph_node* node : g.get_nodes())
     {
-      if (!node->requested_tokens.empty())
+      if(!node->requested_tokens.empty())
       {
-        do_cuts(
-            cuts, node->requested_tokens,
-            node->requested_tokens.front().prev_date);
-        auto it
-            = requests.insert({node, {std::move(node->requested_tokens), {}}});
-        it.first->second.second
-            = it.first->second.first
-                  .begin(); // set iterator to begin() of token requests
+        auto& req = bufs.requests[n_requests++];
+        req.node = node;
+        req.tokens.assign(node->requested_tokens.begin(), node->requested_tokens.end());
         node->requested_tokens.clear();
       }
     }
-    for (auto& cut : cuts)
+
+    int64_t start = 0;
+    for(int64_t end : bufs.cuts)
     {
-      st.begin_tick();
+      if(start > 0)
+      {
+        st.begin_tick();
+        st.cur_date = seconds * 1e9 + start * 1e9 / st.sampleRate;
+      }
 
-      for (auto& node : g.get_nodes())
+      // Only the nodes with something to do in [start, end) get enabled.
+      // The last sub-block also gets what ends exactly with the buffer.
+      const int64_t split_end = end == frames ? INT64_MAX : end;
+      for(std::size_t i = 0; i < n_requests; i++)
       {
-        auto& req = requests[node];
-        if (req.second != req.first.end() && req.second->offset == cut)
-        {
-          node->request(*req.second);
-          ++req.second;
-        }
+        auto& req = bufs.requests[i];
+        for(const auto& tk : req.tokens)
+          if(auto part = split_token(tk, start, split_end, ratio))
+            req.node->requested_tokens.push_back(*part);
       }
 
-      g.state(st);
-      (st.*Commit)();
+      st.bufferSize = int(end - start);
+      st.samples_since_start += end - start;
+      run_graph();
+
+      st.advance_tick(end - start);
+      start = end;
     }
+    st.bufferSize = (int)frameCount;
+    clear_scenario_tokens();
   }
 
-  void operator()(const ossia::audio_tick_state& st)
+private:
+  void clear_scenario_tokens()
   {
-    (*this)(st.frames, st.seconds);
+#if defined(OSSIA_SCENARIO_DATAFLOW)
+    // Same as buffer_tick: only once the graph has run
+    scenar.node->requested_tokens.clear();
+#endif
   }
 
-  void operator()(unsigned long frameCount, double seconds)
+  void run_graph()
   {
-    st.samples_since_start += frameCount;
-    st.bufferSize = (int)frameCount;
-    // we could run a syscall and call now() but that's a bit more costly.
-    st.cur_date = seconds * 1e9;
-    const ossia::token_request tok{};
-    itv.tick_offset(ossia::time_value{int64_t(frameCount)}, 0_tv, tok);
+    // Dataflow execution
+    {
+#if defined(OSSIA_EXECUTION_LOG)
+      auto log = g_exec_log.start_dataflow();
+#endif
 
-    cut(g);
-  }
+      g.state(st);
+    }
 
-private:
-  ossia::flat_set<int64_t> cuts;
-  ossia::hash_map<
-      const ossia::graph_node*,
-      std::pair<ossia::token_request_vec, ossia::token_request_vec::iterator>>
-      requests;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    // Apply messages
+    {
+#if defined(OSSIA_EXECUTION_LOG)
+      auto log = g_exec_log.start_commit();
+#endif
+
+      st.commit();
+    }
+  }
 };
-*/
+
 #if defined(SCORE_BENCHMARK)
 template <typename BaseTick>
 struct benchmark_score_tick
@@ -0,0 +1,201 @@
+#pragma once
+#include <ossia/dataflow/value_vector.hpp>
+#include <ossia/detail/span.hpp>
+
+#include <libremidi/message.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace ossia
+{
+
+/**
+ * @brief A MIDI event stored in a fixed-size record.
+ *
+ * Channel voice and system common / realtime messages are packed in a single
+ * MIDI 1.0 Universal MIDI Packet word:
+ * message type (4 bits) | group (4 bits) | status | data 1 | data 2.
+ *
+ * Other messages (sysex, malformed messages) are stored in the arena of the
+ * midi_event_buffer: \ref word is then the offset of their bytes and
+ * \ref size their size.
+ */
+struct midi_event
+{
+  int64_t timestamp{};
+  uint32_t word{};
+  uint32_t size{};
+
+  //! True if the message is stored in the arena of the buffer
+  [[nodiscard]] bool is_raw() const noexcept { return size != 0; }
+
+  [[nodiscard]] uint8_t status() const noexcept { return (word >> 16) & 0xFF; }
+  [[nodiscard]] uint8_t data1() const noexcept { return (word >> 8) & 0xFF; }
+  [[nodiscard]] uint8_t data2() const noexcept { return word & 0xFF; }
+  [[nodiscard]] int channel() const noexcept { return (status() & 0xF) + 1; }
+
+  static constexpr uint32_t ump_system = 0x1;
+  static constexpr uint32_t ump_channel_voice = 0x2;
+
+  //! Size in bytes of a MIDI 1.0 message with the given status, 0 if it has none
+  static constexpr int expected_size(uint8_t status) noexcept
+  {
+    if(status < 0x80)
+      return 0;
+    if(status < 0xF0)
+    {
+      const uint8_t type = status & 0xF0;
+      return (type == 0xC0 || type == 0xD0) ? 2 : 3;
+    }
+    switch(status)
+    {
+      case 0xF1:
+      case 0xF3:
+        return 2;
+      case 0xF2:
+        return 3;
+      case 0xF6:
+      case 0xF8:
+      case 0xFA:
+      case 0xFB:
+      case 0xFC:
+      case 0xFE:
+      case 0xFF:
+        return 1;
+      default:
+        return 0;
+    }
+  }
+};
+static_assert(std::is_trivially_copyable_v<midi_event>);
+static_assert(sizeof(midi_event) == 16);
+
+/**
+ * @brief Contiguous storage of MIDI events.
+ *
+ * Copying a buffer copies two flat arrays, instead of one byte container per
+ * message as with libremidi::message.
+ */
+class midi_event_buffer
+{
+public:
+  using iterator = std::vector<midi_event>::const_iterator;
+
+  [[nodiscard]] std::size_t size() const noexcept { return m_events.size(); }
+  [[nodiscard]] bool empty() const noexcept { return m_events.empty(); }
+  [[nodiscard]] iterator begin() const noexcept { return m_events.begin(); }
+  [[nodiscard]] iterator end() const noexcept { return m_events.end(); }
+  [[nodiscard]] const midi_event& operator[](std::size_t i) const noexcept
+  {
+    return m_events[i];
+  }
+
+  void reserve(std::size_t events) { m_events.reserve(events); }
+
+  void clear() noexcept
+  {
+    m_events.clear();
+    m_arena.clear();
+  }
+
+  //! Adds a message of up to three bytes, with a status given by the caller
+  void push_back(int64_t timestamp, uint8_t status, uint8_t d1 = 0, uint8_t d2 = 0)
+  {
+    const uint32_t type
+        = status < 0xF0 ? midi_event::ump_channel_voice : midi_event::ump_system;
+    m_events.push_back(
+        {timestamp, (type << 28) | (uint32_t(status) << 16) | (uint32_t(d1) << 8) | d2,
+         0});
+  }
+
+  //! Adds a message as-is, e.g. a sysex
+  void push_raw(int64_t timestamp, const uint8_t* bytes, std::size_t n)
+  {
+    if(n == 0)
+      return;
+    m_events.push_back({timestamp, uint32_t(m_arena.size()), uint32_t(n)});
+    m_arena.insert(m_arena.end(), bytes, bytes + n);
+  }
+
+  void push_back(const libremidi::message& m)
+  {
+    const auto n = m.bytes.size();
+    const auto ts = static_cast<int64_t>(m.timestamp);
+    if(n > 0 && int(n) == midi_event::expected_size(m.bytes[0]))
+      push_back(ts, m.bytes[0], n > 1 ? m.bytes[1] : 0, n > 2 ? m.bytes[2] : 0);
+    else
+      push_raw(ts, m.bytes.data(), n);
+  }
+
+  void append(const midi_event_buffer& other)
+  {
+    const auto offset = uint32_t(m_arena.size());
+    const auto first = m_events.size();
+    m_events.insert(m_events.end(), other.m_events.begin(), other.m_events.end());
+    if(!other.m_arena.empty())
+    {
+      m_arena.insert(m_arena.end(), other.m_arena.begin(), other.m_arena.end());
+      for(auto i = first; i < m_events.size(); i++)
+        if(m_events[i].is_raw())
+          m_events[i].word += offset;
+    }
+  }
+
+  void append(const value_vector<libremidi::message>& messages)
+  {
+    m_events.reserve(m_events.size() + messages.size());
+    for(const auto& m : messages)
+      push_back(m);
+  }
+
+  //! Orders the events by timestamp, keeping the order of simultaneous events
+  void sort()
+  {
+    constexpr auto cmp = [](const midi_event& lhs, const midi_event& rhs) {
+      return lhs.timestamp < rhs.timestamp;
+    };
+    if(!std::is_sorted(m_events.begin(), m_events.end(), cmp))
+      std::stable_sort(m_events.begin(), m_events.end(), cmp);
+  }
+
+  //! Bytes of an event stored in the arena, e.g. a sysex
+  [[nodiscard]] tcb::span<const uint8_t> raw(const midi_event& e) const noexcept
+  {
+    if(!e.is_raw())
+      return {};
+    return {m_arena.data() + e.word, e.size};
+  }
+
+  //! Adapter for the code which works with libremidi::message
+  [[nodiscard]] libremidi::message to_message(const midi_event& e) const
+  {
+    libremidi::message m;
+    m.timestamp = e.timestamp;
+    if(e.is_raw())
+    {
+      m.bytes.assign(m_arena.data() + e.word, m_arena.data() + e.word + e.size);
+    }
+    else
+    {
+      const uint8_t b[3]{e.status(), e.data1(), e.data2()};
+      m.bytes.assign(b, b + midi_event::expected_size(b[0]));
+    }
+    return m;
+  }
+
+  void append_to(value_vector<libremidi::message>& messages) const
+  {
+    messages.reserve(messages.size() + m_events.size());
+    for(const auto& e : m_events)
+      messages.push_back(to_message(e));
+  }
+
+private:
+  std::vector<midi_event> m_events;
+  std::vector<uint8_t> m_arena;
+};
+
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include <ossia/dataflow/midi_event_buffer.hpp>
 #include <ossia/dataflow/value_vector.hpp>
 
 #include <libremidi/message.hpp>
@@ -12,6 +13,79 @@ struct midi_port
 
   value_vector<libremidi::message> messages;
 
+  //! Compact storage, for the nodes which produce or consume many events
+  midi_event_buffer events;
+
+  //! Set by the nodes which read events instead of messages:
+  //! what the port receives is then stored in events.
+  bool compact{};
+
+  //! Adds a message where the reader of the port expects it
+  void push_back(const libremidi::message& m)
+  {
+    if(compact)
+      events.push_back(m);
+    else
+      messages.push_back(m);
+  }
+
+  //! Adds the content of another port where the reader of this port expects it.
+  //! When messages and events are combined, they are ordered by timestamp.
+  void append(const midi_port& other)
+  {
+    if(compact)
+    {
+      const bool merge
+          = !other.messages.empty() && !(events.empty() && other.events.empty());
+      events.append(other.messages);
+      events.append(other.events);
+      if(merge)
+        events.sort();
+    }
+    else
+    {
+      const bool merge
+          = !other.events.empty() && !(messages.empty() && other.messages.empty());
+      messages.insert(messages.end(), other.messages.begin(), other.messages.end());
+      other.events.append_to(messages);
+      if(merge)
+        sort_messages();
+    }
+  }
+
+  //! Moves the messages to events or conversely, depending on compact,
+  //! ordered by timestamp
+  void normalize()
+  {
+    if(compact)
+    {
+      if(!messages.empty())
+      {
+        const bool merge = !events.empty();
+        events.append(messages);
+        messages.clear();
+        if(merge)
+          events.sort();
+      }
+    }
+    else if(!events.empty())
+    {
+      const bool merge = !messages.empty();
+      events.append_to(messages);
+      events.clear();
+      if(merge)
+        sort_messages();
+    }
+  }
+
+  [[nodiscard]] bool empty() const noexcept { return messages.empty() && events.empty(); }
+
+  void clear() noexcept
+  {
+    messages.clear();
+    events.clear();
+  }
+
   using message = libremidi::message;
   using message_type = libremidi::message_type;
   using midi_bytes = libremidi::midi_bytes;
@@ -59,6 +133,15 @@ struct midi_port
   }
 
 private:
+  void sort_messages()
+  {
+    constexpr auto cmp = [](const message& lhs, const message& rhs) {
+      return lhs.timestamp < rhs.timestamp;
+    };
+    if(!std::is_sorted(messages.begin(), messages.end(), cmp))
+      std::stable_sort(messages.begin(), messages.end(), cmp);
+  }
+
   static uint8_t make_command(const message_type type, const int channel) noexcept
   {
     return (uint8_t)((uint8_t)type | std::clamp(channel, 0, channel - 1));
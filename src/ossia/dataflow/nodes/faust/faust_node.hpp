@@ -152,7 +152,9 @@ public:
       : m_dsp{std::move(dsp)}
   {
     m_inlets.push_back(new ossia::audio_inlet);
-    m_inlets.push_back(new ossia::midi_inlet);
+    auto midi_in = new ossia::midi_inlet;
+    (*midi_in)->compact = true;
+    m_inlets.push_back(midi_in);
     m_outlets.push_back(new ossia::audio_outlet);
     faust_exec_ui<faust_synth, true> ex{*this};
     m_dsp->buildUserInterface(&ex);
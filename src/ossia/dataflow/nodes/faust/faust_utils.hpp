@@ -7,6 +7,10 @@
 
 #include <faust/dsp/poly-llvm-dsp.h>
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 namespace ossia::nodes
 {
 
@@ -167,6 +171,12 @@ struct faust_exec_ui_clone final : UI
 
 struct faust_node_utils
 {
+  // Control changes closer than this are applied together,
+  // so that a dense automation does not split compute() into tiny blocks.
+  static constexpr int64_t min_sub_block = 16;
+
+  using sub_block_cuts = ossia::small_vector<int64_t, 8>;
+
   template <typename Node>
   static void copy_controls(Node& self)
   {
@@ -189,95 +199,137 @@ struct faust_node_utils
     }
   }
 
+  /// Sample-accurate controls ///
+
+  //! Ends of the sub-blocks of [st, st + d), one per timestamp of a control change
   template <typename Node>
-  static void copy_input(
-      Node& self, int64_t d, int64_t n_in, float* inputs_, float** input_n,
-      const ossia::audio_port& audio_in)
+  static void compute_cuts(Node& self, int64_t st, int64_t d, sub_block_cuts& cuts)
   {
-    // TODO offset !!!
-    for(int64_t i = 0; i < n_in; i++)
+    const int64_t end = st + d;
+    for(auto& ctrl : self.controls)
+      for(auto& v : ctrl.first->get_data())
+        if(v.timestamp > st && v.timestamp < end)
+          cuts.push_back(v.timestamp);
+
+    std::sort(cuts.begin(), cuts.end());
+
+    int64_t prev = st;
+    auto out = cuts.begin();
+    for(int64_t c : cuts)
     {
-      input_n[i] = inputs_ + i * d;
-      if(int64_t(audio_in.channels()) > i)
+      if(c - prev >= min_sub_block && end - c >= min_sub_block)
       {
-        auto num_samples = std::min((int64_t)d, (int64_t)audio_in.channel(i).size());
-        for(int64_t j = 0; j < num_samples; j++)
-        {
-          input_n[i][j] = (float)audio_in.channel(i)[j];
-        }
+        *out++ = c;
+        prev = c;
+      }
+    }
+    cuts.erase(out, cuts.end());
+    cuts.push_back(end);
+  }
 
-        if(d > int64_t(audio_in.channel(i).size()))
+  /**
+   * Calls compute(offset, length) for each sub-block of the tick,
+   * after apply(control index, value) for the controls which change at its start.
+   * Values timestamped outside of the tick are applied before the first sub-block.
+   */
+  template <typename Node, typename Apply, typename Compute>
+  static void exec_sub_blocks(
+      Node& self, int64_t st, int64_t d, Apply&& apply, Compute&& compute)
+  {
+    sub_block_cuts cuts;
+    compute_cuts(self, st, d, cuts);
+
+    int64_t start = st;
+    for(int64_t end : cuts)
+    {
+      for(std::size_t k = 0; k < self.controls.size(); k++)
+      {
+        auto& dat = self.controls[k].first->get_data();
+        const ossia::value* last{};
+        int64_t last_ts{};
+        for(auto& v : dat)
         {
-          for(int64_t j = audio_in.channel(i).size(); j < d; j++)
+          const int64_t ts
+              = (v.timestamp > st && v.timestamp < st + d) ? v.timestamp : st;
+          if(ts < end && ts >= last_ts)
           {
-            input_n[i][j] = 0.f;
+            last = &v.value;
+            last_ts = ts;
           }
         }
+
+        if(last && (start == st || last_ts >= start) && last->valid())
+          apply(k, *last);
       }
-      else
-      {
-        for(int64_t j = 0; j < d; j++)
-        {
-          input_n[i][j] = 0.f;
-        }
-      }
+
+      compute(start - st, end - start);
+      start = end;
     }
   }
-  template <typename Node>
-  static void copy_input_mono(
-      Node& self, int64_t d, int64_t i, float* input,
-      const ossia::audio_channel& audio_in)
+
+  /// Sample conversion ///
+
+  // The engine buffers are double: when Faust computes in float, each channel
+  // is converted once per tick, in a single pass that the compiler vectorizes.
+  static void read_channel(
+      const ossia::audio_channel& in, int64_t st, int64_t d, float* out) noexcept
   {
-    // TODO offset !!!
-    auto num_samples = std::min((int64_t)d, (int64_t)audio_in.size());
-    for(int64_t j = 0; j < num_samples; j++)
+    const int64_t n = std::clamp(int64_t(in.size()) - st, int64_t(0), d);
+    if(n > 0)
     {
-      input[j] = (float)audio_in[j];
+      const double* src = in.data() + st;
+      for(int64_t j = 0; j < n; j++)
+        out[j] = (float)src[j];
     }
+    std::fill_n(out + n, d - n, 0.f);
+  }
 
-    if(d > int64_t(audio_in.size()))
-    {
-      for(int64_t j = audio_in.size(); j < d; j++)
-      {
-        input[j] = 0.f;
-      }
-    }
+  static void write_channel(const float* in, int64_t d, double* out) noexcept
+  {
+    for(int64_t j = 0; j < d; j++)
+      out[j] = in[j];
   }
 
-  template <typename Node>
-  static void
-  init_output(Node& self, int64_t d, int64_t n_out, float* outputs_, float** output_n)
+  //! Also replaces NaN, infinities and denormals by zero
+  static void write_channel_flushed(const float* in, int64_t d, double* out) noexcept
   {
-    for(int64_t i = 0; i < n_out; i++)
+    for(int64_t j = 0; j < d; j++)
     {
-      output_n[i] = outputs_ + i * d;
-      for(int64_t j = 0; j < d; j++)
-      {
-        output_n[i][j] = 0.f;
-      }
+      const float a = std::abs(in[j]);
+      out[j] = (a >= std::numeric_limits<float>::min()
+                && a <= std::numeric_limits<float>::max())
+                   ? in[j]
+                   : 0.;
     }
   }
 
-  template <typename Node>
-  static void copy_output(
-      Node& self, int64_t d, int64_t n_out, float* outputs_, float** output_n,
-      ossia::audio_port& audio_out)
+  template <typename Node, typename Dsp>
+  static void
+  copy_midi(Node& self, Dsp& dsp, uint8_t status, uint8_t data1, uint8_t data2)
   {
-    audio_out.set_channels(n_out);
-    for(int64_t i = 0; i < n_out; i++)
+    switch(libremidi::message_type(status & 0xF0))
     {
-      audio_out.channel(i).resize(d);
-      for(int64_t j = 0; j < d; j++)
-      {
-        audio_out.channel(i)[j] = (double)output_n[i][j];
+      case libremidi::message_type::NOTE_ON: {
+        self.in_flight[data1]++;
+        dsp.keyOn(status, data1, data2);
+        break;
       }
-    }
-
-    // TODO handle multichannel cleanly
-    if(n_out == 1)
-    {
-      audio_out.set_channels(2);
-      audio_out.channel(1) = audio_out.channel(0);
+      case libremidi::message_type::NOTE_OFF: {
+        self.in_flight[data1]--;
+        dsp.keyOff(status, data1, data2);
+        break;
+      }
+      case libremidi::message_type::CONTROL_CHANGE: {
+        dsp.ctrlChange(status, data1, data2);
+        break;
+      }
+      case libremidi::message_type::PITCH_BEND: {
+        dsp.pitchWheel(status, data2 * 128 + data1);
+        break;
+      }
+      default:
+        break;
+        // TODO continue...
     }
   }
 
@@ -286,32 +338,16 @@ struct faust_node_utils
   {
     // TODO offset !!!
 
+    // Nodes whose inlet is compact receive events, the others messages
     for(const libremidi::message& mess : midi_in.messages)
     {
-      switch(mess.get_message_type())
-      {
-        case libremidi::message_type::NOTE_ON: {
-          self.in_flight[mess[1]]++;
-          dsp.keyOn(mess[0], mess[1], mess[2]);
-          break;
-        }
-        case libremidi::message_type::NOTE_OFF: {
-          self.in_flight[mess[1]]--;
-          dsp.keyOff(mess[0], mess[1], mess[2]);
-          break;
-        }
-        case libremidi::message_type::CONTROL_CHANGE: {
-          dsp.ctrlChange(mess[0], mess[1], mess[2]);
-          break;
-        }
-        case libremidi::message_type::PITCH_BEND: {
-          dsp.pitchWheel(mess[0], mess.bytes[2] * 128 + mess.bytes[1]);
-          break;
-        }
-        default:
-          break;
-          // TODO continue...
-      }
+      if(mess.bytes.size() == 3)
+        copy_midi(self, dsp, mess[0], mess[1], mess[2]);
+    }
+    for(const ossia::midi_event& ev : midi_in.events)
+    {
+      if(!ev.is_raw())
+        copy_midi(self, dsp, ev.status(), ev.data1(), ev.data2());
     }
   }
 
@@ -325,10 +361,14 @@ struct faust_node_utils
 
   /// Execution ///
 
-  template <typename Node, typename Dsp>
+  /**
+   * before_compute(first) is called before the computation of each sub-block,
+   * once its controls have been applied.
+   */
+  template <typename Node, typename Dsp, typename BeforeCompute>
   static void do_exec(
       Node& self, Dsp& dsp, const ossia::token_request& tk,
-      const ossia::exec_state_facade& e)
+      const ossia::exec_state_facade& e, BeforeCompute&& before_compute)
   {
     const auto [st, d] = e.timings(tk);
     ossia::audio_port& audio_in
@@ -341,46 +381,69 @@ struct faust_node_utils
     audio_in.set_channels(n_in);
     audio_out.set_channels(n_out);
 
+    FAUSTFLOAT** input_n = (FAUSTFLOAT**)alloca(sizeof(FAUSTFLOAT*) * n_in);
+    FAUSTFLOAT** output_n = (FAUSTFLOAT**)alloca(sizeof(FAUSTFLOAT*) * n_out);
+    FAUSTFLOAT** sub_input_n = (FAUSTFLOAT**)alloca(sizeof(FAUSTFLOAT*) * n_in);
+    FAUSTFLOAT** sub_output_n = (FAUSTFLOAT**)alloca(sizeof(FAUSTFLOAT*) * n_out);
+
     if constexpr(std::is_same_v<FAUSTFLOAT, float>)
     {
       float* inputs_ = (float*)alloca(n_in * d * sizeof(float));
       float* outputs_ = (float*)alloca(n_out * d * sizeof(float));
-
-      float** input_n = (float**)alloca(sizeof(float*) * n_in);
-      float** output_n = (float**)alloca(sizeof(float*) * n_out);
-
-      copy_input(self, d, n_in, inputs_, input_n, audio_in);
-      init_output(self, d, n_out, outputs_, output_n);
-      dsp.compute(d, input_n, output_n);
-      copy_output(self, d, n_out, outputs_, output_n, audio_out);
+      for(int64_t i = 0; i < n_in; i++)
+      {
+        input_n[i] = inputs_ + i * d;
+        read_channel(audio_in.channel(i), st, d, input_n[i]);
+      }
+      for(int64_t i = 0; i < n_out; i++)
+        output_n[i] = outputs_ + i * d;
     }
     else
     {
-      double** input_n = (double**)alloca(sizeof(double*) * n_in);
-      double** output_n = (double**)alloca(sizeof(double*) * n_out);
-      for(int i = 0; i < n_in; i++)
+      // Faust computes directly in the engine buffers
+      for(int64_t i = 0; i < n_in; i++)
       {
         audio_in.channel(i).resize(e.bufferSize());
         input_n[i] = audio_in.channel(i).data() + st;
       }
-      if(BOOST_LIKELY(st == 0 && d == e.bufferSize()))
+      for(int64_t i = 0; i < n_out; i++)
       {
-        for(int i = 0; i < n_out; i++)
-        {
+        if(BOOST_LIKELY(st == 0 && d == e.bufferSize()))
           audio_out.channel(i).resize(e.bufferSize(), boost::container::default_init);
-          output_n[i] = audio_out.channel(i).data() + st;
-        }
+        else
+          audio_out.channel(i).resize(e.bufferSize());
+        output_n[i] = audio_out.channel(i).data() + st;
       }
-      else
+    }
+
+    exec_sub_blocks(
+        self, st, d,
+        [&self](std::size_t k, const ossia::value& v) {
+      *self.controls[k].second = ossia::convert<float>(v);
+    }, [&](int64_t offset, int64_t length) {
+      before_compute(offset == 0);
+      for(int64_t i = 0; i < n_in; i++)
+        sub_input_n[i] = input_n[i] + offset;
+      for(int64_t i = 0; i < n_out; i++)
+        sub_output_n[i] = output_n[i] + offset;
+      dsp.compute(length, sub_input_n, sub_output_n);
+    });
+
+    if constexpr(std::is_same_v<FAUSTFLOAT, float>)
+    {
+      for(int64_t i = 0; i < n_out; i++)
       {
-        for(int i = 0; i < n_out; i++)
-        {
-          audio_out.channel(i).resize(e.bufferSize());
-          output_n[i] = audio_out.channel(i).data() + st;
-        }
+        auto& chan = audio_out.channel(i);
+        chan.resize(e.bufferSize());
+        write_channel(output_n[i], d, chan.data() + st);
       }
 
-      dsp.compute(d, input_n, output_n);
+      // TODO handle multichannel cleanly
+      if(n_out == 1)
+      {
+        audio_out.set_channels(2);
+        audio_out.channel(1) = audio_out.channel(0);
+      }
     }
   }
 
@@ -392,15 +455,21 @@ struct faust_node_utils
     if(tk.forward())
     {
       const auto [st, d] = e.timings(tk);
-      copy_controls(self);
-
       if(d == 0)
+      {
+        copy_controls(self);
         return;
-      do_exec(self, dsp, tk, e);
+      }
+
+      do_exec(self, dsp, tk, e, [](bool) {});
       copy_displays(self, st);
     }
   }
 
+  /**
+   * One clone of the effect per channel: each sub-block is computed for all the
+   * channels in a row, on contiguous buffers.
+   */
   template <typename Node, typename Dsp>
   static void do_exec_mono_fx(
       Node& self, Dsp& dsp, const ossia::token_request& tk,
@@ -422,69 +491,49 @@ struct faust_node_utils
       self.clones.emplace_back(dsp.clone(), self.clones[0]);
     }
 
+    FAUSTFLOAT* inputs_{};
+    FAUSTFLOAT* outputs_{};
+    if constexpr(std::is_same_v<FAUSTFLOAT, float>)
     {
-      for(int k = 0; k < self.controls.size(); ++k)
-      {
-        auto ctrl = self.controls[k];
-        auto& dat = ctrl.first->get_data();
-        if(!dat.empty())
-        {
-          if(dat.back().value.valid())
-            ossia::apply_nonnull([k,&self] (const auto& vv){ self.set_control(k, vv); }, dat.back().value.v);
-        }
-      }
+      inputs_ = (float*)alloca(n_in * d * sizeof(float));
+      outputs_ = (float*)alloca(n_in * d * sizeof(float));
+      for(int64_t i = 0; i < n_in; i++)
+        read_channel(audio_in.channel(i), st, d, inputs_ + i * d);
     }
 
-    if constexpr(std::is_same_v<FAUSTFLOAT, float>)
+    for(int64_t i = 0; i < n_in; i++)
     {
-      float* input = (float*)alloca(d * sizeof(float));
-      memset(input, 0, d * sizeof(float));
-      float* output = (float*)alloca(d * sizeof(float));
+      audio_in.channel(i).resize(e.bufferSize());
+      audio_out.channel(i).resize(e.bufferSize());
+    }
 
-      for(int i = 0; i < n_in; i++)
+    exec_sub_blocks(
+        self, st, d,
+        [&self](std::size_t k, const ossia::value& v) {
+      ossia::apply_nonnull([k, &self](const auto& vv) { self.set_control(k, vv); }, v.v);
+    }, [&](int64_t offset, int64_t length) {
+      for(int64_t i = 0; i < n_in; i++)
       {
-        auto& in_chan = audio_in.channel(i);
-        auto& out_chan = audio_out.channel(i);
-        auto& clone = self.clones[i];
-        in_chan.resize(e.bufferSize());
-        out_chan.resize(e.bufferSize());
-
-        copy_input_mono(self, d, n_in, input, in_chan);
-        memset(output, 0, d * sizeof(float));
-        for(int z = 0; z < d; z++)
-        {
-          assert(!std::isnan(input[z]));
-          assert(!std::isinf(input[z]));
-        }
-        clone.fx->compute(d, &input, &output);
-        for(int z = 0; z < d; z++)
+        FAUSTFLOAT* input{};
+        FAUSTFLOAT* output{};
+        if constexpr(std::is_same_v<FAUSTFLOAT, float>)
         {
-          if(std::fpclassify(output[z]) != FP_NORMAL)
-            output[z] = 0.f;
+          input = inputs_ + i * d + offset;
+          output = outputs_ + i * d + offset;
         }
-
-        std::copy_n(output, d, out_chan.data() + st);
-        for(int z = 0; z < e.bufferSize(); z++)
+        else
         {
-          assert(!std::isnan(out_chan[z]));
-          assert(!std::isinf(out_chan[z]));
+          input = audio_in.channel(i).data() + st + offset;
+          output = audio_out.channel(i).data() + st + offset;
         }
+        self.clones[i].fx->compute(length, &input, &output);
       }
-    }
-    else
-    {
-      for(int i = 0; i < n_in; i++)
-      {
-        auto& in_chan = audio_in.channel(i);
-        auto& out_chan = audio_out.channel(i);
-        in_chan.resize(e.bufferSize());
-        out_chan.resize(e.bufferSize());
-
-        double* input = in_chan.data() + st;
-        double* output = out_chan.data() + st;
+    });
 
-        self.clones[i].fx->compute(d, &input, &output);
-      }
+    if constexpr(std::is_same_v<FAUSTFLOAT, float>)
+    {
+      for(int64_t i = 0; i < n_in; i++)
+        write_channel_flushed(outputs_ + i * d, d, audio_out.channel(i).data() + st);
     }
   }
 
@@ -516,13 +565,20 @@ struct faust_node_utils
 
       auto& midi_in = self.root_inputs()[1]->template cast<ossia::midi_port>();
 
-      copy_controls(self);
-      dsp.updateAllZones();
-      copy_midi(self, dsp, midi_in);
-
       if(d == 0)
+      {
+        copy_controls(self);
+        dsp.updateAllZones();
+        copy_midi(self, dsp, midi_in);
         return;
-      do_exec(self, dsp, tk, e);
+      }
+
+      // The voices get the new control values before the notes of the tick start
+      do_exec(self, dsp, tk, e, [&](bool first) {
+        dsp.updateAllZones();
+        if(first)
+          copy_midi(self, dsp, midi_in);
+      });
       copy_displays(self, st);
     }
   }
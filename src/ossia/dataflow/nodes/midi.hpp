@@ -188,17 +188,10 @@ private:
 
     if(t.end_discontinuous)
     {
-      auto& mess = mp.messages;
       for(auto note : m_playing_notes)
-      {
-        mess.push_back(libremidi::channel_events::note_off(m_channel, note.pitch, 0));
-        mess.back().timestamp = 0;
-      }
+        write(mp, libremidi::channel_events::note_off(m_channel, note.pitch, 0), 0);
       for(auto note : m_to_stop)
-      {
-        mess.push_back(libremidi::channel_events::note_off(m_channel, note.pitch, 0));
-        mess.back().timestamp = 0;
-      }
+        write(mp, libremidi::channel_events::note_off(m_channel, note.pitch, 0), 0);
       m_playing_notes.clear();
       m_to_stop.clear();
       return;
@@ -206,9 +199,8 @@ private:
 
     for(const note_data& note : m_to_stop)
     {
-      mp.messages.push_back(
-          libremidi::channel_events::note_off(m_channel, note.pitch, 0));
-      mp.messages.back().timestamp = tick_start;
+      write(
+          mp, libremidi::channel_events::note_off(m_channel, note.pitch, 0), tick_start);
     }
     m_to_stop.clear();
 
@@ -216,9 +208,9 @@ private:
     {
       for(auto& note : m_playing_notes)
       {
-        mp.messages.push_back(
-            libremidi::channel_events::note_off(m_channel, note.pitch, 0));
-        mp.messages.back().timestamp = tick_start;
+        write(
+            mp, libremidi::channel_events::note_off(m_channel, note.pitch, 0),
+            tick_start);
       }
 
       m_notes = m_orig_notes;
@@ -237,9 +229,10 @@ private:
         while(it != m_notes.end() && it->start < t.date)
         {
           auto& note = *it;
-          mp.messages.push_back(
-              libremidi::channel_events::note_on(m_channel, note.pitch, note.velocity));
-          mp.messages.back().timestamp = tick_start;
+          write(
+              mp,
+              libremidi::channel_events::note_on(m_channel, note.pitch, note.velocity),
+              tick_start);
           m_playing_notes.insert(note);
           it = m_notes.erase(it);
         }
@@ -257,10 +250,9 @@ private:
 
           if(t.in_range({end_time}))
           {
-            mp.messages.push_back(
-                libremidi::channel_events::note_off(m_channel, note.pitch, 0));
-            mp.messages.back().timestamp
-                = t.to_physical_time_in_tick(end_time, samplesratio);
+            write(
+                mp, libremidi::channel_events::note_off(m_channel, note.pitch, 0),
+                t.to_physical_time_in_tick(end_time, samplesratio));
 
             it = m_playing_notes.erase(it);
           }
@@ -279,10 +271,11 @@ private:
           if(start_time >= t.prev_date && start_time < t.date)
           {
             // Send note_on
-            mp.messages.push_back(libremidi::channel_events::note_on(
-                m_channel, note.pitch, note.velocity));
-            mp.messages.back().timestamp
-                = t.to_physical_time_in_tick(start_time, samplesratio);
+            write(
+                mp,
+                libremidi::channel_events::note_on(
+                    m_channel, note.pitch, note.velocity),
+                t.to_physical_time_in_tick(start_time, samplesratio));
 
             m_playing_notes.insert(note);
             it = m_notes.erase(it);
@@ -298,6 +291,14 @@ private:
     }
   }
 
+  // Stored as compact events: they are only converted to messages for the
+  // inlets which read messages
+  static void write(ossia::midi_port& mp, libremidi::message m, int64_t timestamp)
+  {
+    m.timestamp = timestamp;
+    mp.events.push_back(m);
+  }
+
   note_set m_notes;
   note_set m_orig_notes;
   note_set m_playing_notes;
@@ -12,6 +12,13 @@ struct rand_float final : public ossia::nonowning_graph_node
 
 public:
   std::uniform_real_distribution<float> dist;
+#if !defined(OSSIA_FREESTANDING)
+  // Each node has its own generator so that the sequence does not depend
+  // on which thread runs the node
+  std::mt19937 gen;
+  void seed(uint64_t s) { gen.seed(s); }
+#endif
+
   rand_float(float min, float max)
       : dist{min, max}
   {
@@ -26,7 +33,6 @@ public:
 #if defined(OSSIA_FREESTANDING)
     out.write_value((rand() - dist.a()) / (dist.b() - dist.a()), tm.start_sample);
 #else
-    thread_local std::mt19937 gen;
     out.write_value(dist(gen), tm.start_sample);
 #endif
   }
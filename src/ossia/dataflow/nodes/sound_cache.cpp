@@ -0,0 +1,236 @@
+#include <ossia/dataflow/nodes/sound_cache.hpp>
+#include <ossia/detail/thread.hpp>
+
+namespace ossia
+{
+sound_cache::sound_cache(std::size_t budget)
+    : m_budget{budget}
+{
+}
+
+sound_cache::~sound_cache()
+{
+  {
+    std::lock_guard lock{m_mutex};
+    m_running = false;
+  }
+  m_jobsCondition.notify_all();
+
+  if(m_loader.joinable())
+    m_loader.join();
+}
+
+sound_cache& sound_cache::instance()
+{
+  static sound_cache cache;
+  return cache;
+}
+
+void sound_cache::set_memory_budget(std::size_t bytes)
+{
+  std::lock_guard lock{m_mutex};
+  m_budget = bytes;
+  enforce_budget();
+}
+
+std::size_t sound_cache::memory_budget() const noexcept
+{
+  std::lock_guard lock{m_mutex};
+  return m_budget;
+}
+
+std::size_t sound_cache::memory_usage() const noexcept
+{
+  std::lock_guard lock{m_mutex};
+  return m_usage;
+}
+
+std::size_t sound_cache::size_in_bytes(const audio_data& d) noexcept
+{
+  std::size_t sz = 0;
+  for(auto& chan : d.data)
+    sz += chan.size() * sizeof(audio_sample);
+  return sz;
+}
+
+static bool is_ready(const std::shared_future<audio_handle>& f)
+{
+  return f.valid() && f.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+audio_handle sound_cache::find(const sound_cache_key& key)
+{
+  std::lock_guard lock{m_mutex};
+  auto it = m_entries.find(key);
+  if(it == m_entries.end())
+    return {};
+
+  auto& e = it->second;
+  if(is_ready(e.data))
+  {
+    e.last_use = ++m_useCount;
+    return e.data.get();
+  }
+  else if(!e.data.valid())
+  {
+    // Released from the cache but still used by a node: take it back
+    if(auto d = e.weak.lock())
+    {
+      std::promise<audio_handle> p;
+      p.set_value(d);
+      e.data = p.get_future().share();
+      e.last_use = ++m_useCount;
+      m_usage += e.bytes;
+      enforce_budget();
+      return d;
+    }
+  }
+  return {};
+}
+
+audio_handle sound_cache::get(const sound_cache_key& key, const loader& load)
+{
+  if(auto d = find(key))
+    return d;
+
+  std::promise<audio_handle> promise;
+  std::shared_future<audio_handle> pending;
+  {
+    std::lock_guard lock{m_mutex};
+    auto& e = m_entries[key];
+    e.last_use = ++m_useCount;
+    if(e.data.valid())
+    {
+      // Another thread is decoding this file
+      pending = e.data;
+    }
+    else
+    {
+      e.data = promise.get_future().share();
+    }
+  }
+
+  if(pending.valid())
+    return pending.get();
+
+  audio_handle res;
+  try
+  {
+    res = load(key);
+  }
+  catch(...)
+  {
+  }
+  promise.set_value(res);
+
+  std::lock_guard lock{m_mutex};
+  if(auto it = m_entries.find(key); it != m_entries.end())
+  {
+    if(res)
+    {
+      auto& e = it->second;
+      e.weak = res;
+      e.bytes = size_in_bytes(*res);
+      m_usage += e.bytes;
+      enforce_budget();
+    }
+    else
+    {
+      // Allow trying again later
+      m_entries.erase(it);
+    }
+  }
+  return res;
+}
+
+void sound_cache::request(const sound_cache_key& key, loader load, callback on_loaded)
+{
+  if(auto d = find(key))
+  {
+    on_loaded(std::move(d));
+    return;
+  }
+
+  {
+    std::lock_guard lock{m_mutex};
+    m_jobs.push_back(
+        [this, key, load = std::move(load), on_loaded = std::move(on_loaded)] {
+      on_loaded(get(key, load));
+    });
+
+    if(!m_loader.joinable())
+      m_loader = std::thread{[this] { loader_thread(); }};
+  }
+  m_jobsCondition.notify_one();
+}
+
+void sound_cache::loader_thread()
+{
+  ossia::set_thread_name("ossia sndcache");
+
+  std::unique_lock lock{m_mutex};
+  for(;;)
+  {
+    m_jobsCondition.wait(lock, [this] { return !m_running || !m_jobs.empty(); });
+    if(!m_running)
+      return;
+
+    auto jobs = std::move(m_jobs);
+    m_jobs.clear();
+    lock.unlock();
+
+    for(auto& job : jobs)
+    {
+      try
+      {
+        job();
+      }
+      catch(...)
+      {
+      }
+    }
+
+    lock.lock();
+  }
+}
+
+void sound_cache::clear_unused()
+{
+  std::lock_guard lock{m_mutex};
+  const auto budget = m_budget;
+  m_budget = 0;
+  enforce_budget();
+  m_budget = budget;
+}
+
+void sound_cache::enforce_budget()
+{
+  while(m_usage > m_budget)
+  {
+    // Find the least recently used entry that no node uses anymore
+    entry* lru{};
+    for(auto& [key, e] : m_entries)
+    {
+      if(!is_ready(e.data) || !e.data.get() || e.data.get().use_count() > 1)
+        continue;
+      if(!lru || e.last_use < lru->last_use)
+        lru = &e;
+    }
+
+    if(!lru)
+      break;
+
+    lru->data = {};
+    m_usage -= lru->bytes;
+  }
+
+  // Forget about the data which is not referenced anywhere anymore
+  for(auto it = m_entries.begin(); it != m_entries.end();)
+  {
+    if(!it->second.data.valid() && it->second.weak.expired())
+      it = m_entries.erase(it);
+    else
+      ++it;
+  }
+}
+}
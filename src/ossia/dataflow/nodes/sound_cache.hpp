@@ -0,0 +1,128 @@
+#pragma once
+#include <ossia/dataflow/nodes/media.hpp>
+#include <ossia/detail/hash_map.hpp>
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ossia
+{
+//! Identifies one decoded version of a sound file
+struct sound_cache_key
+{
+  std::string path;
+
+  //! Sample rate at which the file is decoded, 0 if it is the file's rate
+  int sample_rate{};
+
+  //! Any decoder option which changes the decoded data
+  std::string decoder;
+
+  bool operator==(const sound_cache_key&) const noexcept = default;
+};
+
+struct sound_cache_key_hash
+{
+  std::size_t operator()(const sound_cache_key& k) const noexcept
+  {
+    std::size_t seed = 0;
+    ossia::hash_combine(seed, k.path);
+    ossia::hash_combine(seed, k.sample_rate);
+    ossia::hash_combine(seed, k.decoder);
+    return seed;
+  }
+};
+
+/**
+ * @brief Process-wide cache of decoded sound files
+ *
+ * Sound nodes referencing the same file with the same decoding parameters
+ * share a single immutable audio_data.
+ * Nodes keep a reference to the data they play, so the audio thread never
+ * has to access the cache.
+ *
+ * The cache also keeps files which are not used by any node anymore, until
+ * the memory budget is exceeded: the least recently requested ones are then
+ * released first. Files used by a node are never released.
+ */
+class OSSIA_EXPORT sound_cache
+{
+public:
+  using loader = std::function<audio_handle(const sound_cache_key&)>;
+  using callback = std::function<void(audio_handle)>;
+
+  static constexpr std::size_t default_budget = 2ull * 1024 * 1024 * 1024;
+
+  explicit sound_cache(std::size_t budget = default_budget);
+  ~sound_cache();
+  sound_cache(const sound_cache&) = delete;
+  sound_cache(sound_cache&&) = delete;
+  sound_cache& operator=(const sound_cache&) = delete;
+  sound_cache& operator=(sound_cache&&) = delete;
+
+  static sound_cache& instance();
+
+  void set_memory_budget(std::size_t bytes);
+  std::size_t memory_budget() const noexcept;
+
+  //! Size of the decoded data currently referenced by the cache, in bytes
+  std::size_t memory_usage() const noexcept;
+
+  /**
+   * @brief Returns the decoded data for a key.
+   *
+   * If it is not in the cache, the loader is called on the calling thread.
+   * Concurrent calls with the same key only decode once.
+   */
+  audio_handle get(const sound_cache_key& key, const loader& load);
+
+  /**
+   * @brief Returns the decoded data if it is in the cache, without decoding.
+   */
+  audio_handle find(const sound_cache_key& key);
+
+  /**
+   * @brief Decodes a file on the cache's loader thread.
+   *
+   * The callback is called on the loader thread, or immediately if the data is
+   * already in the cache.
+   */
+  void request(const sound_cache_key& key, loader load, callback on_loaded);
+
+  //! Releases all the data not used by any node
+  void clear_unused();
+
+private:
+  struct entry
+  {
+    // Held while the entry is in the memory budget
+    std::shared_future<audio_handle> data;
+
+    // Still valid as long as a node uses the data
+    std::weak_ptr<audio_data> weak;
+
+    std::size_t bytes{};
+    uint64_t last_use{};
+  };
+
+  static std::size_t size_in_bytes(const audio_data& d) noexcept;
+  void enforce_budget();
+  void loader_thread();
+
+  ossia::hash_map<sound_cache_key, entry, sound_cache_key_hash> m_entries;
+  mutable std::mutex m_mutex;
+  std::size_t m_budget{};
+  std::size_t m_usage{};
+  uint64_t m_useCount{};
+
+  std::vector<std::function<void()>> m_jobs;
+  std::condition_variable m_jobsCondition;
+  std::thread m_loader;
+  bool m_running{true};
+};
+}
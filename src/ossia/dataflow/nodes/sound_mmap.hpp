@@ -6,6 +6,7 @@
 #include <ossia/dataflow/nodes/media.hpp>
 #include <ossia/dataflow/nodes/sound.hpp>
 #include <ossia/dataflow/port.hpp>
+#include <ossia/dataflow/sample_conversion.hpp>
 #include <ossia/detail/pod_vector.hpp>
 
 #include <type_traits>
@@ -28,8 +29,8 @@ public:
 
   void set_sound(drwav_handle hdl)
   {
-    using namespace snd;
     m_handle = std::move(hdl);
+    m_converter = nullptr;
     if(m_handle)
     {
       switch(m_handle.translatedFormatTag())
@@ -38,16 +39,16 @@ public:
           switch(m_handle.bitsPerSample())
           {
             case 8:
-              m_converter = read_u8;
+              m_converter = get_deinterleaver(sample_format::u8);
               break;
             case 16:
-              m_converter = read_s16;
+              m_converter = get_deinterleaver(sample_format::s16);
               break;
             case 24:
-              m_converter = read_s24;
+              m_converter = get_deinterleaver(sample_format::s24);
               break;
             case 32:
-              m_converter = read_s32;
+              m_converter = get_deinterleaver(sample_format::s32);
               break;
           }
           break;
@@ -56,16 +57,15 @@ public:
           switch(m_handle.bitsPerSample())
           {
             case 32:
-              m_converter = read_f32;
+              m_converter = get_deinterleaver(sample_format::f32);
               break;
             case 64:
-              m_converter = read_f64;
+              m_converter = get_deinterleaver(sample_format::f64);
               break;
           }
           break;
         }
         default:
-          m_converter = nullptr;
           break;
       }
     }
@@ -80,12 +80,8 @@ public:
       int64_t start, int64_t samples_to_write, double** audio_array_base) noexcept
   {
     const int channels = this->channels();
-    const int file_duration = this->duration();
 
     m_resampleBuffer.resize(channels);
-    for(auto& buf : m_resampleBuffer)
-      buf.resize(samples_to_write);
-
     float** audio_array = (float**)alloca(sizeof(float*) * channels);
     for(int i = 0; i < channels; i++)
     {
@@ -93,85 +89,7 @@ public:
       audio_array[i] = m_resampleBuffer[i].data();
     }
 
-    ossia::mutable_audio_span<float> source(channels);
-
-    double* frame_data{};
-    if(samples_to_write * channels > 10000)
-    {
-      m_safetyBuffer.resize(samples_to_write * channels);
-      frame_data = m_safetyBuffer.data();
-      // TODO detect if we happen to be in this case often, and if so, garbage
-      // collect at some point
-    }
-    else
-    {
-      frame_data = (double*)alloca(sizeof(double) * samples_to_write * channels);
-    }
-
-    if(m_loops)
-    {
-      for(int k = 0; k < samples_to_write; k++)
-      {
-        // TODO add a special case if [0; samples_to_write] don't loop around
-        int pos = this->m_start_offset_samples
-                  + ((start + k) % this->m_loop_duration_samples);
-        if(pos >= file_duration)
-        {
-          for(int i = 0; i < channels; i++)
-            audio_array[i][k] = 0;
-          continue;
-        }
-
-        const bool ok = this->m_handle.seek_to_pcm_frame(pos);
-        if(!ok)
-        {
-          for(int i = 0; i < channels; i++)
-            audio_array[i][k] = 0;
-          continue;
-        }
-
-        const int max = 1;
-        const auto count = this->m_handle.read_pcm_frames(max, frame_data);
-        if(count >= 0)
-        {
-          for(int i = 0; i < channels; i++)
-            source[i] = tcb::span(audio_array[i] + k, count);
-          m_converter(source, frame_data, count);
-        }
-        else
-        {
-          for(int i = 0; i < channels; i++)
-            audio_array[i][k] = 0;
-        }
-      }
-    }
-    else
-    {
-      for(int i = 0; i < channels; i++)
-      {
-        source[i] = tcb::span(audio_array[i], samples_to_write);
-      }
-
-      bool ok = start + m_start_offset_samples < file_duration;
-      if(ok)
-        ok = ok && this->m_handle.seek_to_pcm_frame(start + m_start_offset_samples);
-
-      if(ok)
-      {
-        const auto count = this->m_handle.read_pcm_frames(samples_to_write, frame_data);
-        m_converter(source, frame_data, count);
-        for(int i = 0; i < channels; i++)
-          for(int k = count; k < samples_to_write; k++)
-            audio_array[i][k] = 0;
-      }
-      else
-      {
-        for(int i = 0; i < channels; i++)
-          for(int k = 0; k < samples_to_write; k++)
-            audio_array[i][k] = 0;
-        return;
-      }
-    }
+    fetch_audio(start, samples_to_write, audio_array);
 
     for(int i = 0; i < channels; i++)
       std::copy_n(audio_array[i], samples_to_write, audio_array_base[i]);
@@ -180,9 +98,6 @@ public:
   void fetch_audio(int64_t start, int64_t samples_to_write, float** audio_array) noexcept
   {
     const int channels = this->channels();
-    const int file_duration = this->duration();
-
-    ossia::mutable_audio_span<float> source(channels);
 
     double* frame_data{};
     if(samples_to_write * channels > 10000)
@@ -199,62 +114,21 @@ public:
 
     if(m_loops)
     {
-      for(int k = 0; k < samples_to_write; k++)
+      // Read the contiguous parts between the loop points at once
+      for(int64_t k = 0; k < samples_to_write;)
       {
-        // TODO add a special case if [0; samples_to_write] don't loop around
-        int pos = this->m_start_offset_samples
-                  + ((start + k) % this->m_loop_duration_samples);
-        if(pos >= file_duration)
-        {
-          for(int i = 0; i < channels; i++)
-            audio_array[i][k] = 0;
-          continue;
-        }
-
-        const bool ok = this->m_handle.seek_to_pcm_frame(pos);
-        if(!ok)
-        {
-          for(int i = 0; i < channels; i++)
-            audio_array[i][k] = 0;
-          continue;
-        }
-
-        const int max = 1;
-        const auto count = this->m_handle.read_pcm_frames(max, frame_data);
-        if(count >= 0)
-        {
-          for(int i = 0; i < channels; i++)
-            source[i] = tcb::span(audio_array[i] + k, count);
-          m_converter(source, frame_data, count);
-        }
-        else
-        {
-          for(int i = 0; i < channels; i++)
-            audio_array[i][k] = 0;
-        }
+        const int64_t loop_pos = (start + k) % this->m_loop_duration_samples;
+        const int64_t count = std::min(
+            samples_to_write - k, this->m_loop_duration_samples - loop_pos);
+        read_frames(
+            this->m_start_offset_samples + loop_pos, count, frame_data, audio_array, k);
+        k += count;
       }
     }
     else
     {
-      for(int i = 0; i < channels; i++)
-      {
-        source[i] = tcb::span(audio_array[i], samples_to_write);
-      }
-
-      const bool ok = this->m_handle.seek_to_pcm_frame(start + m_start_offset_samples);
-      if(!ok)
-      {
-        for(int i = 0; i < channels; i++)
-          for(int k = 0; k < samples_to_write; k++)
-            audio_array[i][k] = 0;
-        return;
-      }
-
-      const auto count = this->m_handle.read_pcm_frames(samples_to_write, frame_data);
-      m_converter(source, frame_data, count);
-      for(int i = 0; i < channels; i++)
-        for(int k = count; k < samples_to_write; k++)
-          audio_array[i][k] = 0;
+      read_frames(
+          start + m_start_offset_samples, samples_to_write, frame_data, audio_array, 0);
     }
   }
 
@@ -345,6 +219,29 @@ public:
   }
 
 private:
+  // Reads count frames from pos in the file, at offset in the output buffers.
+  // What cannot be read is set to zero.
+  void read_frames(
+      int64_t pos, int64_t count, void* frame_data, float** audio_array,
+      int64_t offset) noexcept
+  {
+    const int channels = this->channels();
+
+    int64_t read = 0;
+    if(pos < (int64_t)this->duration() && this->m_handle.seek_to_pcm_frame(pos))
+    {
+      read = this->m_handle.read_pcm_frames(count, frame_data);
+
+      float** out = (float**)alloca(sizeof(float*) * channels);
+      for(int i = 0; i < channels; i++)
+        out[i] = audio_array[i] + offset;
+      m_converter(frame_data, out, channels, read);
+    }
+
+    for(int i = 0; i < channels; i++)
+      std::fill_n(audio_array[i] + offset + read, count - read, 0.f);
+  }
+
   drwav_handle m_handle{};
 
   ossia::audio_outlet audio_out;
@@ -352,9 +249,7 @@ private:
   std::size_t start{};
   std::size_t upmix{};
 
-  using read_fn_t
-      = void (*)(ossia::mutable_audio_span<float>& ap, void* data, int64_t samples);
-  read_fn_t m_converter{};
+  ossia::deinterleave_fn m_converter{};
   std::vector<double> m_safetyBuffer;
   std::vector<std::vector<float>> m_resampleBuffer;
 };
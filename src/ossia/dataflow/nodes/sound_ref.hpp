@@ -29,6 +29,14 @@ public:
     m_sampler.set_sound(hdl, channels, sampleRate);
   }
 
+  //! Nodes loading the same key share a single decoded buffer
+  void load_sound(
+      const sound_cache_key& key, const sound_cache::loader& load,
+      sound_cache& cache = sound_cache::instance())
+  {
+    m_sampler.load_sound(key, load, cache);
+  }
+
   void run(const ossia::token_request& t, ossia::exec_state_facade e) noexcept override
   {
     return m_sampler.run(t, e);
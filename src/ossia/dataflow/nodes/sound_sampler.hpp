@@ -1,6 +1,7 @@
 #pragma once
 #include <ossia/dataflow/graph_node.hpp>
 #include <ossia/dataflow/nodes/sound.hpp>
+#include <ossia/dataflow/nodes/sound_cache.hpp>
 #include <ossia/dataflow/nodes/sound_utils.hpp>
 
 namespace ossia::nodes
@@ -49,6 +50,16 @@ struct sound_sampler
     }
   }
 
+  void load_sound(
+      const sound_cache_key& key, const sound_cache::loader& load, sound_cache& cache)
+  {
+    auto hdl = cache.get(key, load);
+    if(hdl)
+      set_sound(hdl, hdl->data.size(), hdl->rate > 0 ? hdl->rate : key.sample_rate);
+    else
+      set_sound(hdl, 0, 0);
+  }
+
   template <typename T>
   void fetch_audio(
       const int64_t start, const int64_t samples_to_write,
@@ -20,12 +20,36 @@ public:
 
   std::string label() const noexcept override { return "spline"; }
 
+  /**
+   * Builds the table of the spline, which is too costly for the execution
+   * thread: from there, set a spline prepared with make_spline instead.
+   */
   void set_spline(const spline_data& t)
   {
     m_spline.set_points(
         reinterpret_cast<const tsReal*>(t.points.data()), t.points.size());
   }
 
+  //! Prepares a spline outside of the execution thread, see set_spline
+  static ts::spline<2> make_spline(
+      const spline_data& t, double tolerance = ts::spline<2>::default_tolerance)
+  {
+    ts::spline<2> s;
+    s.set_tolerance(tolerance);
+    s.set_points(reinterpret_cast<const tsReal*>(t.points.data()), t.points.size());
+    return s;
+  }
+
+  /**
+   * Sets a spline prepared outside of the execution thread,
+   * whose table is thus not built during execution.
+   * The previous spline is left in s.
+   */
+  void set_spline(ts::spline<2>& s) noexcept { m_spline.swap(s); }
+
+  //! Maximal error of the evaluation, see ts::spline::set_tolerance
+  void set_tolerance(double tolerance) noexcept { m_spline.set_tolerance(tolerance); }
+
 private:
   void run(const ossia::token_request& t, ossia::exec_state_facade e) noexcept override
   {
@@ -58,12 +82,36 @@ public:
 
   std::string label() const noexcept override { return "spline"; }
 
+  /**
+   * Builds the table of the spline, which is too costly for the execution
+   * thread: from there, set a spline prepared with make_spline instead.
+   */
   void set_spline(const spline3d_data& t)
   {
     m_spline.set_points(
         reinterpret_cast<const tsReal*>(t.points.data()), t.points.size());
   }
 
+  //! Prepares a spline outside of the execution thread, see set_spline
+  static ts::spline<3> make_spline(
+      const spline3d_data& t, double tolerance = ts::spline<3>::default_tolerance)
+  {
+    ts::spline<3> s;
+    s.set_tolerance(tolerance);
+    s.set_points(reinterpret_cast<const tsReal*>(t.points.data()), t.points.size());
+    return s;
+  }
+
+  /**
+   * Sets a spline prepared outside of the execution thread,
+   * whose table is thus not built during execution.
+   * The previous spline is left in s.
+   */
+  void set_spline(ts::spline<3>& s) noexcept { m_spline.swap(s); }
+
+  //! Maximal error of the evaluation, see ts::spline::set_tolerance
+  void set_tolerance(double tolerance) noexcept { m_spline.set_tolerance(tolerance); }
+
 private:
   void run(const ossia::token_request& t, ossia::exec_state_facade e) noexcept override
   {
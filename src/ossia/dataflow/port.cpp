@@ -78,6 +78,8 @@ struct push_data
     {
       for(auto& val : p.messages)
         midi->push_value(val);
+      for(auto& ev : p.events)
+        midi->push_value(p.events.to_message(ev));
     }
 #endif
   }
@@ -160,7 +162,7 @@ struct outlet_inserter
   void operator()(const ossia::midi_port& data) const noexcept
   {
 #if defined(OSSIA_PROTOCOL_MIDI)
-    if(data.messages.empty())
+    if(data.empty())
       return;
 
     if(auto p = dynamic_cast<ossia::net::midi::midi_parameter*>(addr))
@@ -0,0 +1,784 @@
+#include <ossia/dataflow/float_to_sample.hpp>
+#include <ossia/dataflow/sample_conversion.hpp>
+#include <ossia/dataflow/sample_to_float.hpp>
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <immintrin.h>
+#define OSSIA_SAMPLE_CONVERSION_SSE2 1
+#if defined(__GNUC__)
+#define OSSIA_SAMPLE_CONVERSION_AVX2 1
+#define OSSIA_TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(__AVX2__)
+#define OSSIA_SAMPLE_CONVERSION_AVX2 1
+#define OSSIA_TARGET_AVX2
+#endif
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define OSSIA_SAMPLE_CONVERSION_NEON 1
+#endif
+
+namespace ossia
+{
+namespace
+{
+// Samples are converted by blocks which fit in L1, then (de)interleaved
+static constexpr int64_t block_size = 1024;
+
+using to_float_fn = void (*)(const uint8_t* in, float* out, int64_t n);
+using from_float_fn = void (*)(const float* in, uint8_t* out, int64_t n);
+
+namespace scalar
+{
+static void u8_to_float(const uint8_t* in, float* out, int64_t n)
+{
+  for(int64_t i = 0; i < n; i++)
+    out[i] = sample_to_float<uint8_t, 8>(in[i]);
+}
+
+static void s16_to_float(const uint8_t* in, float* out, int64_t n)
+{
+  for(int64_t i = 0; i < n; i++)
+  {
+    int16_t s;
+    std::memcpy(&s, in + 2 * i, 2);
+    out[i] = sample_to_float<int16_t, 16>(s);
+  }
+}
+
+static void s24_to_float(const uint8_t* in, float* out, int64_t n)
+{
+  for(int64_t i = 0; i < n; i++)
+  {
+    const auto b = in + 3 * i;
+    const auto s
+        = (int32_t)(uint32_t(b[0]) << 8 | uint32_t(b[1]) << 16 | uint32_t(b[2]) << 24);
+    out[i] = sample_to_float<int32_t, 24>(s);
+  }
+}
+
+static void s32_to_float(const uint8_t* in, float* out, int64_t n)
+{
+  for(int64_t i = 0; i < n; i++)
+  {
+    int32_t s;
+    std::memcpy(&s, in + 4 * i, 4);
+    out[i] = sample_to_float<int32_t, 32>(s);
+  }
+}
+
+static void f64_to_float(const uint8_t* in, float* out, int64_t n)
+{
+  for(int64_t i = 0; i < n; i++)
+  {
+    double s;
+    std::memcpy(&s, in + 8 * i, 8);
+    out[i] = s;
+  }
+}
+
+static void float_to_u8(const float* in, uint8_t* out, int64_t n)
+{
+  for(int64_t i = 0; i < n; i++)
+    out[i] = std::clamp((in[i] + 1.f) * 127.5f, 0.f, 255.f);
+}
+
+static void float_to_s16(const float* in, uint8_t* out, int64_t n)
+{
+  for(int64_t i = 0; i < n; i++)
+  {
+    const int16_t s = std::clamp(in[i] * (0x7FFF + .5f) - 0.5f, -32768.f, 32767.f);
+    std::memcpy(out + 2 * i, &s, 2);
+  }
+}
+
+static void float_to_s24(const float* in, uint8_t* out, int64_t n)
+{
+  for(int64_t i = 0; i < n; i++)
+  {
+    const int32_t s = std::clamp(in[i] * 8388608.f, -8388608.f, 8388607.f);
+    out[3 * i] = s;
+    out[3 * i + 1] = s >> 8;
+    out[3 * i + 2] = s >> 16;
+  }
+}
+
+static void float_to_s32(const float* in, uint8_t* out, int64_t n)
+{
+  for(int64_t i = 0; i < n; i++)
+  {
+    const float f = in[i] * 2147483648.f;
+    int32_t s = INT_MIN;
+    if(f >= 2147483648.f)
+      s = INT_MAX;
+    else if(f > -2147483648.f)
+      s = f;
+    std::memcpy(out + 4 * i, &s, 4);
+  }
+}
+
+static void float_to_f64(const float* in, uint8_t* out, int64_t n)
+{
+  for(int64_t i = 0; i < n; i++)
+  {
+    const double s = in[i];
+    std::memcpy(out + 8 * i, &s, 8);
+  }
+}
+}
+
+#if defined(OSSIA_SAMPLE_CONVERSION_SSE2)
+namespace sse2
+{
+static void u8_to_float(const uint8_t* in, float* out, int64_t n)
+{
+  const __m128i zero = _mm_setzero_si128();
+  const __m128 scale = _mm_set1_ps(127.f);
+  const __m128 one = _mm_set1_ps(1.f);
+  int64_t i = 0;
+  for(; i + 16 <= n; i += 16)
+  {
+    const __m128i v = _mm_loadu_si128((const __m128i*)(in + i));
+    const __m128i lo = _mm_unpacklo_epi8(v, zero);
+    const __m128i hi = _mm_unpackhi_epi8(v, zero);
+    const __m128i q[4] = {
+        _mm_unpacklo_epi16(lo, zero), _mm_unpackhi_epi16(lo, zero),
+        _mm_unpacklo_epi16(hi, zero), _mm_unpackhi_epi16(hi, zero)};
+    for(int k = 0; k < 4; k++)
+      _mm_storeu_ps(
+          out + i + 4 * k, _mm_sub_ps(_mm_div_ps(_mm_cvtepi32_ps(q[k]), scale), one));
+  }
+  scalar::u8_to_float(in + i, out + i, n - i);
+}
+
+static void s16_to_float(const uint8_t* in, float* out, int64_t n)
+{
+  const __m128 half = _mm_set1_ps(.5f);
+  const __m128 scale = _mm_set1_ps(0x7FFF + .5f);
+  int64_t i = 0;
+  for(; i + 8 <= n; i += 8)
+  {
+    const __m128i v = _mm_loadu_si128((const __m128i*)(in + 2 * i));
+    const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+    const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+    _mm_storeu_ps(out + i, _mm_div_ps(_mm_add_ps(_mm_cvtepi32_ps(lo), half), scale));
+    _mm_storeu_ps(
+        out + i + 4, _mm_div_ps(_mm_add_ps(_mm_cvtepi32_ps(hi), half), scale));
+  }
+  scalar::s16_to_float(in + i * 2, out + i, n - i);
+}
+
+static void s32_to_float(const uint8_t* in, float* out, int64_t n)
+{
+  // Dividing by 2^31 is exact, thus the same as multiplying by 2^-31
+  const __m128 scale = _mm_set1_ps(1.f / 2147483648.f);
+  int64_t i = 0;
+  for(; i + 4 <= n; i += 4)
+  {
+    const __m128i v = _mm_loadu_si128((const __m128i*)(in + 4 * i));
+    _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(v), scale));
+  }
+  scalar::s32_to_float(in + i * 4, out + i, n - i);
+}
+
+static void f64_to_float(const uint8_t* in, float* out, int64_t n)
+{
+  int64_t i = 0;
+  for(; i + 4 <= n; i += 4)
+  {
+    const __m128 a = _mm_cvtpd_ps(_mm_loadu_pd((const double*)(in + 8 * i)));
+    const __m128 b = _mm_cvtpd_ps(_mm_loadu_pd((const double*)(in + 8 * i + 16)));
+    _mm_storeu_ps(out + i, _mm_movelh_ps(a, b));
+  }
+  scalar::f64_to_float(in + i * 8, out + i, n - i);
+}
+
+static void float_to_s16(const float* in, uint8_t* out, int64_t n)
+{
+  const __m128 scale = _mm_set1_ps(0x7FFF + .5f);
+  const __m128 half = _mm_set1_ps(.5f);
+  const __m128 min = _mm_set1_ps(-32768.f);
+  const __m128 max = _mm_set1_ps(32767.f);
+  auto convert = [&](const float* p) {
+    __m128 v = _mm_sub_ps(_mm_mul_ps(_mm_loadu_ps(p), scale), half);
+    v = _mm_min_ps(_mm_max_ps(v, min), max);
+    return _mm_cvttps_epi32(v);
+  };
+
+  int64_t i = 0;
+  for(; i + 8 <= n; i += 8)
+  {
+    const __m128i s = _mm_packs_epi32(convert(in + i), convert(in + i + 4));
+    _mm_storeu_si128((__m128i*)(out + 2 * i), s);
+  }
+  scalar::float_to_s16(in + i, out + i * 2, n - i);
+}
+
+static void float_to_s32(const float* in, uint8_t* out, int64_t n)
+{
+  const __m128 scale = _mm_set1_ps(2147483648.f);
+  int64_t i = 0;
+  for(; i + 4 <= n; i += 4)
+  {
+    const __m128 v = _mm_mul_ps(_mm_loadu_ps(in + i), scale);
+    // Overflowing conversions give INT_MIN: flip them to INT_MAX if positive
+    const __m128i overflow = _mm_castps_si128(_mm_cmpge_ps(v, scale));
+    const __m128i s = _mm_xor_si128(_mm_cvttps_epi32(v), overflow);
+    _mm_storeu_si128((__m128i*)(out + 4 * i), s);
+  }
+  scalar::float_to_s32(in + i, out + i * 4, n - i);
+}
+
+static void float_to_f64(const float* in, uint8_t* out, int64_t n)
+{
+  int64_t i = 0;
+  for(; i + 4 <= n; i += 4)
+  {
+    const __m128 v = _mm_loadu_ps(in + i);
+    _mm_storeu_pd((double*)(out + 8 * i), _mm_cvtps_pd(v));
+    _mm_storeu_pd((double*)(out + 8 * i + 16), _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+  }
+  scalar::float_to_f64(in + i, out + i * 8, n - i);
+}
+}
+#endif
+
+#if defined(OSSIA_SAMPLE_CONVERSION_AVX2)
+namespace avx2
+{
+OSSIA_TARGET_AVX2
+static void u8_to_float(const uint8_t* in, float* out, int64_t n)
+{
+  const __m256 scale = _mm256_set1_ps(127.f);
+  const __m256 one = _mm256_set1_ps(1.f);
+  int64_t i = 0;
+  for(; i + 8 <= n; i += 8)
+  {
+    const __m256i v = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(in + i)));
+    _mm256_storeu_ps(
+        out + i, _mm256_sub_ps(_mm256_div_ps(_mm256_cvtepi32_ps(v), scale), one));
+  }
+  scalar::u8_to_float(in + i, out + i, n - i);
+}
+
+OSSIA_TARGET_AVX2
+static void s16_to_float(const uint8_t* in, float* out, int64_t n)
+{
+  const __m256 half = _mm256_set1_ps(.5f);
+  const __m256 scale = _mm256_set1_ps(0x7FFF + .5f);
+  int64_t i = 0;
+  for(; i + 8 <= n; i += 8)
+  {
+    const __m256i v
+        = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)(in + 2 * i)));
+    _mm256_storeu_ps(
+        out + i, _mm256_div_ps(_mm256_add_ps(_mm256_cvtepi32_ps(v), half), scale));
+  }
+  scalar::s16_to_float(in + i * 2, out + i, n - i);
+}
+
+OSSIA_TARGET_AVX2
+static void s24_to_float(const uint8_t* in, float* out, int64_t n)
+{
+  // Moves the three bytes of each sample in the upper bytes of an int32,
+  // then shifts back to keep the sign.
+  const __m256i shuffle = _mm256_setr_epi8(
+      -128, 0, 1, 2, -128, 3, 4, 5, -128, 6, 7, 8, -128, 9, 10, 11, //
+      -128, 0, 1, 2, -128, 3, 4, 5, -128, 6, 7, 8, -128, 9, 10, 11);
+  const __m256 scale = _mm256_set1_ps(1.f / 8388608.f);
+  int64_t i = 0;
+
+  // Each iteration reads 32 bytes for 24 bytes of samples
+  for(; i + 10 <= n; i += 8)
+  {
+    const uint8_t* p = in + 3 * i;
+    const __m256i v = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)p)),
+        _mm_loadu_si128((const __m128i*)(p + 12)), 1);
+    const __m256i s = _mm256_srai_epi32(_mm256_shuffle_epi8(v, shuffle), 8);
+    _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_cvtepi32_ps(s), scale));
+  }
+  scalar::s24_to_float(in + i * 3, out + i, n - i);
+}
+
+OSSIA_TARGET_AVX2
+static void s32_to_float(const uint8_t* in, float* out, int64_t n)
+{
+  const __m256 scale = _mm256_set1_ps(1.f / 2147483648.f);
+  int64_t i = 0;
+  for(; i + 8 <= n; i += 8)
+  {
+    const __m256i v = _mm256_loadu_si256((const __m256i*)(in + 4 * i));
+    _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_cvtepi32_ps(v), scale));
+  }
+  scalar::s32_to_float(in + i * 4, out + i, n - i);
+}
+
+OSSIA_TARGET_AVX2
+static void f64_to_float(const uint8_t* in, float* out, int64_t n)
+{
+  int64_t i = 0;
+  for(; i + 8 <= n; i += 8)
+  {
+    const __m128 a = _mm256_cvtpd_ps(_mm256_loadu_pd((const double*)(in + 8 * i)));
+    const __m128 b
+        = _mm256_cvtpd_ps(_mm256_loadu_pd((const double*)(in + 8 * i + 32)));
+    _mm256_storeu_ps(out + i, _mm256_insertf128_ps(_mm256_castps128_ps256(a), b, 1));
+  }
+  scalar::f64_to_float(in + i * 8, out + i, n - i);
+}
+
+OSSIA_TARGET_AVX2
+static void float_to_s16(const float* in, uint8_t* out, int64_t n)
+{
+  const __m256 scale = _mm256_set1_ps(0x7FFF + .5f);
+  const __m256 half = _mm256_set1_ps(.5f);
+  const __m256 min = _mm256_set1_ps(-32768.f);
+  const __m256 max = _mm256_set1_ps(32767.f);
+
+  int64_t i = 0;
+  for(; i + 16 <= n; i += 16)
+  {
+    __m256 a = _mm256_sub_ps(_mm256_mul_ps(_mm256_loadu_ps(in + i), scale), half);
+    __m256 b = _mm256_sub_ps(_mm256_mul_ps(_mm256_loadu_ps(in + i + 8), scale), half);
+    a = _mm256_min_ps(_mm256_max_ps(a, min), max);
+    b = _mm256_min_ps(_mm256_max_ps(b, min), max);
+
+    // packs works per 128-bit lane: put the 64-bit blocks back in order
+    const __m256i s = _mm256_permute4x64_epi64(
+        _mm256_packs_epi32(_mm256_cvttps_epi32(a), _mm256_cvttps_epi32(b)),
+        _MM_SHUFFLE(3, 1, 2, 0));
+    _mm256_storeu_si256((__m256i*)(out + 2 * i), s);
+  }
+  scalar::float_to_s16(in + i, out + i * 2, n - i);
+}
+
+OSSIA_TARGET_AVX2
+static void float_to_s24(const float* in, uint8_t* out, int64_t n)
+{
+  // Keeps the three lower bytes of each int32, in the first 12 bytes of each lane
+  const __m256i shuffle = _mm256_setr_epi8(
+      0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -128, -128, -128, -128, //
+      0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -128, -128, -128, -128);
+  const __m256 scale = _mm256_set1_ps(8388608.f);
+  const __m256 min = _mm256_set1_ps(-8388608.f);
+  const __m256 max = _mm256_set1_ps(8388607.f);
+
+  int64_t i = 0;
+
+  // Each iteration writes 28 bytes for 24 bytes of samples,
+  // the last 4 are overwritten by the next iteration.
+  for(; i + 10 <= n; i += 8)
+  {
+    __m256 v = _mm256_mul_ps(_mm256_loadu_ps(in + i), scale);
+    v = _mm256_min_ps(_mm256_max_ps(v, min), max);
+    const __m256i s = _mm256_shuffle_epi8(_mm256_cvttps_epi32(v), shuffle);
+    _mm_storeu_si128((__m128i*)(out + 3 * i), _mm256_castsi256_si128(s));
+    _mm_storeu_si128((__m128i*)(out + 3 * i + 12), _mm256_extracti128_si256(s, 1));
+  }
+  scalar::float_to_s24(in + i, out + i * 3, n - i);
+}
+
+OSSIA_TARGET_AVX2
+static void float_to_s32(const float* in, uint8_t* out, int64_t n)
+{
+  const __m256 scale = _mm256_set1_ps(2147483648.f);
+  int64_t i = 0;
+  for(; i + 8 <= n; i += 8)
+  {
+    const __m256 v = _mm256_mul_ps(_mm256_loadu_ps(in + i), scale);
+    const __m256i overflow = _mm256_castps_si256(_mm256_cmp_ps(v, scale, _CMP_GE_OQ));
+    const __m256i s = _mm256_xor_si256(_mm256_cvttps_epi32(v), overflow);
+    _mm256_storeu_si256((__m256i*)(out + 4 * i), s);
+  }
+  scalar::float_to_s32(in + i, out + i * 4, n - i);
+}
+}
+#endif
+
+#if defined(OSSIA_SAMPLE_CONVERSION_NEON)
+namespace neon
+{
+static void u8_to_float(const uint8_t* in, float* out, int64_t n)
+{
+  const float32x4_t scale = vdupq_n_f32(127.f);
+  const float32x4_t one = vdupq_n_f32(1.f);
+  int64_t i = 0;
+  for(; i + 8 <= n; i += 8)
+  {
+    const uint16x8_t v = vmovl_u8(vld1_u8(in + i));
+    const float32x4_t lo = vcvtq_f32_u32(vmovl_u16(vget_low_u16(v)));
+    const float32x4_t hi = vcvtq_f32_u32(vmovl_u16(vget_high_u16(v)));
+    vst1q_f32(out + i, vsubq_f32(vdivq_f32(lo, scale), one));
+    vst1q_f32(out + i + 4, vsubq_f32(vdivq_f32(hi, scale), one));
+  }
+  scalar::u8_to_float(in + i, out + i, n - i);
+}
+
+static void s16_to_float(const uint8_t* in, float* out, int64_t n)
+{
+  const float32x4_t half = vdupq_n_f32(.5f);
+  const float32x4_t scale = vdupq_n_f32(0x7FFF + .5f);
+  int64_t i = 0;
+  for(; i + 8 <= n; i += 8)
+  {
+    const int16x8_t v = vreinterpretq_s16_u8(vld1q_u8(in + 2 * i));
+    const float32x4_t lo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(v)));
+    const float32x4_t hi = vcvtq_f32_s32(vmovl_s16(vget_high_s16(v)));
+    vst1q_f32(out + i, vdivq_f32(vaddq_f32(lo, half), scale));
+    vst1q_f32(out + i + 4, vdivq_f32(vaddq_f32(hi, half), scale));
+  }
+  scalar::s16_to_float(in + i * 2, out + i, n - i);
+}
+
+static void s24_to_float(const uint8_t* in, float* out, int64_t n)
+{
+  const float32x4_t scale = vdupq_n_f32(1.f / 8388608.f);
+  int64_t i = 0;
+  for(; i + 8 <= n; i += 8)
+  {
+    // Splits the bytes of 8 samples
+    const uint8x8x3_t b = vld3_u8(in + 3 * i);
+    const uint16x8_t low = vorrq_u16(vmovl_u8(b.val[0]), vshll_n_u8(b.val[1], 8));
+    const int16x8_t high = vmovl_s8(vreinterpret_s8_u8(b.val[2]));
+
+    const int32x4_t s0 = vorrq_s32(
+        vshlq_n_s32(vmovl_s16(vget_low_s16(high)), 16),
+        vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(low))));
+    const int32x4_t s1 = vorrq_s32(
+        vshlq_n_s32(vmovl_s16(vget_high_s16(high)), 16),
+        vreinterpretq_s32_u32(vmovl_u16(vget_high_u16(low))));
+    vst1q_f32(out + i, vmulq_f32(vcvtq_f32_s32(s0), scale));
+    vst1q_f32(out + i + 4, vmulq_f32(vcvtq_f32_s32(s1), scale));
+  }
+  scalar::s24_to_float(in + i * 3, out + i, n - i);
+}
+
+static void s32_to_float(const uint8_t* in, float* out, int64_t n)
+{
+  const float32x4_t scale = vdupq_n_f32(1.f / 2147483648.f);
+  int64_t i = 0;
+  for(; i + 4 <= n; i += 4)
+  {
+    const int32x4_t v = vreinterpretq_s32_u8(vld1q_u8(in + 4 * i));
+    vst1q_f32(out + i, vmulq_f32(vcvtq_f32_s32(v), scale));
+  }
+  scalar::s32_to_float(in + i * 4, out + i, n - i);
+}
+
+static void f64_to_float(const uint8_t* in, float* out, int64_t n)
+{
+  int64_t i = 0;
+  for(; i + 4 <= n; i += 4)
+  {
+    const float64x2_t a = vreinterpretq_f64_u8(vld1q_u8(in + 8 * i));
+    const float64x2_t b = vreinterpretq_f64_u8(vld1q_u8(in + 8 * i + 16));
+    vst1q_f32(out + i, vcvt_high_f32_f64(vcvt_f32_f64(a), b));
+  }
+  scalar::f64_to_float(in + i * 8, out + i, n - i);
+}
+
+static void float_to_s16(const float* in, uint8_t* out, int64_t n)
+{
+  // Float to int conversions and narrowing saturate on NEON
+  const float32x4_t scale = vdupq_n_f32(0x7FFF + .5f);
+  const float32x4_t half = vdupq_n_f32(.5f);
+  int64_t i = 0;
+  for(; i + 8 <= n; i += 8)
+  {
+    const int32x4_t a
+        = vcvtq_s32_f32(vsubq_f32(vmulq_f32(vld1q_f32(in + i), scale), half));
+    const int32x4_t b
+        = vcvtq_s32_f32(vsubq_f32(vmulq_f32(vld1q_f32(in + i + 4), scale), half));
+    const int16x8_t s = vcombine_s16(vqmovn_s32(a), vqmovn_s32(b));
+    vst1q_u8(out + 2 * i, vreinterpretq_u8_s16(s));
+  }
+  scalar::float_to_s16(in + i, out + i * 2, n - i);
+}
+
+static void float_to_s32(const float* in, uint8_t* out, int64_t n)
+{
+  const float32x4_t scale = vdupq_n_f32(2147483648.f);
+  int64_t i = 0;
+  for(; i + 4 <= n; i += 4)
+  {
+    const int32x4_t s = vcvtq_s32_f32(vmulq_f32(vld1q_f32(in + i), scale));
+    vst1q_u8(out + 4 * i, vreinterpretq_u8_s32(s));
+  }
+  scalar::float_to_s32(in + i, out + i * 4, n - i);
+}
+}
+#endif
+
+static void deinterleave_floats(
+    const float* in, float* const* out, int channels, int64_t offset, int64_t frames)
+{
+  switch(channels)
+  {
+    case 1:
+      std::memcpy(out[0] + offset, in, frames * sizeof(float));
+      break;
+    case 2: {
+      float* l = out[0] + offset;
+      float* r = out[1] + offset;
+      int64_t k = 0;
+#if defined(OSSIA_SAMPLE_CONVERSION_SSE2)
+      for(; k + 4 <= frames; k += 4)
+      {
+        const __m128 a = _mm_loadu_ps(in + 2 * k);
+        const __m128 b = _mm_loadu_ps(in + 2 * k + 4);
+        _mm_storeu_ps(l + k, _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(r + k, _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)));
+      }
+#elif defined(OSSIA_SAMPLE_CONVERSION_NEON)
+      for(; k + 4 <= frames; k += 4)
+      {
+        const float32x4x2_t v = vld2q_f32(in + 2 * k);
+        vst1q_f32(l + k, v.val[0]);
+        vst1q_f32(r + k, v.val[1]);
+      }
+#endif
+      for(; k < frames; k++)
+      {
+        l[k] = in[2 * k];
+        r[k] = in[2 * k + 1];
+      }
+      break;
+    }
+    default:
+      for(int c = 0; c < channels; c++)
+      {
+        float* o = out[c] + offset;
+        for(int64_t k = 0; k < frames; k++)
+          o[k] = in[k * channels + c];
+      }
+      break;
+  }
+}
+
+static void interleave_floats(
+    const float* const* in, int64_t offset, float* out, int channels, int64_t frames)
+{
+  switch(channels)
+  {
+    case 1:
+      std::memcpy(out, in[0] + offset, frames * sizeof(float));
+      break;
+    case 2: {
+      const float* l = in[0] + offset;
+      const float* r = in[1] + offset;
+      int64_t k = 0;
+#if defined(OSSIA_SAMPLE_CONVERSION_SSE2)
+      for(; k + 4 <= frames; k += 4)
+      {
+        const __m128 a = _mm_loadu_ps(l + k);
+        const __m128 b = _mm_loadu_ps(r + k);
+        _mm_storeu_ps(out + 2 * k, _mm_unpacklo_ps(a, b));
+        _mm_storeu_ps(out + 2 * k + 4, _mm_unpackhi_ps(a, b));
+      }
+#elif defined(OSSIA_SAMPLE_CONVERSION_NEON)
+      for(; k + 4 <= frames; k += 4)
+      {
+        const float32x4x2_t v{vld1q_f32(l + k), vld1q_f32(r + k)};
+        vst2q_f32(out + 2 * k, v);
+      }
+#endif
+      for(; k < frames; k++)
+      {
+        out[2 * k] = l[k];
+        out[2 * k + 1] = r[k];
+      }
+      break;
+    }
+    default:
+      for(int c = 0; c < channels; c++)
+      {
+        const float* i = in[c] + offset;
+        for(int64_t k = 0; k < frames; k++)
+          out[k * channels + c] = i[k];
+      }
+      break;
+  }
+}
+
+template <to_float_fn ToFloat, int SampleSize>
+void deinterleave(const void* in, float* const* out, int channels, int64_t frames)
+{
+  const auto src = static_cast<const uint8_t*>(in);
+  if constexpr(ToFloat == nullptr)
+  {
+    // Float samples: nothing to convert
+    deinterleave_floats(reinterpret_cast<const float*>(src), out, channels, 0, frames);
+  }
+  else if(channels > block_size)
+  {
+    for(int64_t k = 0; k < frames; k++)
+      for(int c = 0; c < channels; c++)
+        ToFloat(src + (k * channels + c) * SampleSize, out[c] + k, 1);
+  }
+  else
+  {
+    alignas(32) float buf[block_size];
+    const int64_t block_frames = block_size / channels;
+    for(int64_t k = 0; k < frames; k += block_frames)
+    {
+      const int64_t n = std::min(block_frames, frames - k);
+      ToFloat(src + k * channels * SampleSize, buf, n * channels);
+      deinterleave_floats(buf, out, channels, k, n);
+    }
+  }
+}
+
+template <from_float_fn FromFloat, int SampleSize>
+void interleave(const float* const* in, void* out, int channels, int64_t frames)
+{
+  const auto dst = static_cast<uint8_t*>(out);
+  if constexpr(FromFloat == nullptr)
+  {
+    interleave_floats(in, 0, reinterpret_cast<float*>(dst), channels, frames);
+  }
+  else if(channels > block_size)
+  {
+    for(int64_t k = 0; k < frames; k++)
+      for(int c = 0; c < channels; c++)
+        FromFloat(in[c] + k, dst + (k * channels + c) * SampleSize, 1);
+  }
+  else
+  {
+    alignas(32) float buf[block_size];
+    const int64_t block_frames = block_size / channels;
+    for(int64_t k = 0; k < frames; k += block_frames)
+    {
+      const int64_t n = std::min(block_frames, frames - k);
+      interleave_floats(in, k, buf, channels, n);
+      FromFloat(buf, dst + k * channels * SampleSize, n * channels);
+    }
+  }
+}
+
+static bool has_avx2() noexcept
+{
+#if defined(OSSIA_SAMPLE_CONVERSION_AVX2) && defined(__GNUC__)
+  static const bool avx2 = __builtin_cpu_supports("avx2");
+  return avx2;
+#elif defined(OSSIA_SAMPLE_CONVERSION_AVX2)
+  // MSVC: only enabled when building for AVX2
+  return true;
+#else
+  return false;
+#endif
+}
+}
+
+deinterleave_fn get_deinterleaver(sample_format fmt) noexcept
+{
+#if defined(OSSIA_SAMPLE_CONVERSION_AVX2)
+  if(has_avx2())
+  {
+    switch(fmt)
+    {
+      case sample_format::u8:
+        return deinterleave<avx2::u8_to_float, 1>;
+      case sample_format::s16:
+        return deinterleave<avx2::s16_to_float, 2>;
+      case sample_format::s24:
+        return deinterleave<avx2::s24_to_float, 3>;
+      case sample_format::s32:
+        return deinterleave<avx2::s32_to_float, 4>;
+      case sample_format::f32:
+        return deinterleave<nullptr, 4>;
+      case sample_format::f64:
+        return deinterleave<avx2::f64_to_float, 8>;
+    }
+    return nullptr;
+  }
+#endif
+
+#if defined(OSSIA_SAMPLE_CONVERSION_SSE2)
+  namespace simd = sse2;
+#elif defined(OSSIA_SAMPLE_CONVERSION_NEON)
+  namespace simd = neon;
+#else
+  namespace simd = scalar;
+#endif
+
+  switch(fmt)
+  {
+    case sample_format::u8:
+      return deinterleave<simd::u8_to_float, 1>;
+    case sample_format::s16:
+      return deinterleave<simd::s16_to_float, 2>;
+    case sample_format::s24:
+#if defined(OSSIA_SAMPLE_CONVERSION_NEON)
+      return deinterleave<neon::s24_to_float, 3>;
+#else
+      // Needs byte shuffles, not available in SSE2
+      return deinterleave<scalar::s24_to_float, 3>;
+#endif
+    case sample_format::s32:
+      return deinterleave<simd::s32_to_float, 4>;
+    case sample_format::f32:
+      return deinterleave<nullptr, 4>;
+    case sample_format::f64:
+      return deinterleave<simd::f64_to_float, 8>;
+  }
+  return nullptr;
+}
+
+interleave_fn get_interleaver(sample_format fmt) noexcept
+{
+#if defined(OSSIA_SAMPLE_CONVERSION_AVX2)
+  if(has_avx2())
+  {
+    switch(fmt)
+    {
+      case sample_format::u8:
+        return interleave<scalar::float_to_u8, 1>;
+      case sample_format::s16:
+        return interleave<avx2::float_to_s16, 2>;
+      case sample_format::s24:
+        return interleave<avx2::float_to_s24, 3>;
+      case sample_format::s32:
+        return interleave<avx2::float_to_s32, 4>;
+      case sample_format::f32:
+        return interleave<nullptr, 4>;
+      case sample_format::f64:
+        return interleave<sse2::float_to_f64, 8>;
+    }
+    return nullptr;
+  }
+#endif
+
+#if defined(OSSIA_SAMPLE_CONVERSION_SSE2)
+  namespace simd = sse2;
+#elif defined(OSSIA_SAMPLE_CONVERSION_NEON)
+  namespace simd = neon;
+#else
+  namespace simd = scalar;
+#endif
+
+  switch(fmt)
+  {
+    case sample_format::u8:
+      return interleave<scalar::float_to_u8, 1>;
+    case sample_format::s16:
+      return interleave<simd::float_to_s16, 2>;
+    case sample_format::s24:
+      return interleave<scalar::float_to_s24, 3>;
+    case sample_format::s32:
+      return interleave<simd::float_to_s32, 4>;
+    case sample_format::f32:
+      return interleave<nullptr, 4>;
+    case sample_format::f64:
+#if defined(OSSIA_SAMPLE_CONVERSION_SSE2)
+      return interleave<sse2::float_to_f64, 8>;
+#else
+      return interleave<scalar::float_to_f64, 8>;
+#endif
+  }
+  return nullptr;
+}
+}
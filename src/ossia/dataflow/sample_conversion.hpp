@@ -0,0 +1,63 @@
+#pragma once
+#include <ossia/detail/config.hpp>
+
+#include <cstdint>
+
+namespace ossia
+{
+//! Formats of interleaved samples, as found in sound files and audio APIs
+enum class sample_format : int8_t
+{
+  u8,
+  s16,
+  s24, //!< Packed, 3 bytes per sample
+  s32,
+  f32,
+  f64
+};
+
+//! Size of a sample of the given format, in bytes
+constexpr int sample_size(sample_format fmt) noexcept
+{
+  switch(fmt)
+  {
+    case sample_format::u8:
+      return 1;
+    case sample_format::s16:
+      return 2;
+    case sample_format::s24:
+      return 3;
+    case sample_format::s32:
+    case sample_format::f32:
+      return 4;
+    case sample_format::f64:
+      return 8;
+  }
+  return 0;
+}
+
+//! Converts interleaved samples to one float buffer per channel
+using deinterleave_fn
+    = void (*)(const void* in, float* const* out, int channels, int64_t frames);
+
+//! Converts one float buffer per channel to interleaved samples
+using interleave_fn
+    = void (*)(const float* const* in, void* out, int channels, int64_t frames);
+
+/**
+ * @brief Returns the fastest deinterleaving converter for this CPU.
+ *
+ * The CPU features are checked at run-time, so that the result can be kept
+ * and called directly from the audio thread.
+ * The conversion gives the same values as the functions of sample_to_float.hpp.
+ */
+OSSIA_EXPORT deinterleave_fn get_deinterleaver(sample_format fmt) noexcept;
+
+/**
+ * @brief Returns the fastest interleaving converter for this CPU.
+ *
+ * The conversion gives the same values as the functions of float_to_sample.hpp,
+ * except that out-of-range integer samples are saturated.
+ */
+OSSIA_EXPORT interleave_fn get_interleaver(sample_format fmt) noexcept;
+}
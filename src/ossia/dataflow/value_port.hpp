@@ -49,6 +49,10 @@ struct OSSIA_EXPORT value_port
   bool is_event{};
   data_mix_method mix_method{};
 
+  //! For event ports: how many of the values received by the parameter between
+  //! two ticks are kept. 1 only keeps the latest one, 0 keeps all of them.
+  int inbox_size{};
+
 private:
   value_vector<ossia::timed_value> data;
 };
@@ -6,8 +6,13 @@
 #include "tinyspline.h"
 // clang-format on
 
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
 
 extern "C" {
 TINYSPLINE_API
@@ -30,9 +35,19 @@ tsReal* ts_int_deboornet_access_result(const tsDeBoorNet* net);
 
 namespace ts
 {
+/**
+ * @brief A clamped cubic B-spline with N dimensions.
+ *
+ * When the control points are set, the spline is sampled in a table fine enough
+ * for the linear interpolation between two samples to stay within the tolerance
+ * of the exact curve: evaluation is then a lookup, without allocation.
+ */
 template <std::size_t N>
 struct spline
 {
+  using point = std::array<tsReal, N>;
+  static constexpr double default_tolerance = 1e-5;
+
   tsBSpline m_spline;
   mutable tsDeBoorNet m_net;
 
@@ -42,6 +57,21 @@ struct spline
     ts_int_deboornet_init(&m_net);
   }
 
+  spline(const spline&) = delete;
+  spline& operator=(const spline&) = delete;
+
+  spline(spline&& other) noexcept
+      : spline()
+  {
+    swap(other);
+  }
+
+  spline& operator=(spline&& other) noexcept
+  {
+    swap(other);
+    return *this;
+  }
+
   ~spline()
   {
     if(m_net.pImpl)
@@ -50,8 +80,25 @@ struct spline
       ts_bspline_free(&m_spline);
   }
 
+  void swap(spline& other) noexcept
+  {
+    std::swap(m_spline, other.m_spline);
+    std::swap(m_net, other.m_net);
+    m_table.swap(other.m_table);
+    std::swap(m_tolerance, other.m_tolerance);
+  }
+
   operator bool() const noexcept { return m_net.pImpl; }
 
+  /**
+   * @brief Maximal distance, on each axis, between the curve and its table.
+   *
+   * Takes effect on the next call to set_points.
+   * A tolerance of zero disables the table: every evaluation is then exact.
+   */
+  void set_tolerance(double tolerance) noexcept { m_tolerance = tolerance; }
+  double tolerance() const noexcept { return m_tolerance; }
+
   void set_points(const tsReal* points, std::size_t numPoints) noexcept
   {
     tsStatus status;
@@ -61,6 +108,8 @@ struct spline
     if(m_spline.pImpl)
       ts_bspline_free(&m_spline);
 
+    m_table.clear();
+
     ts_int_bspline_init(&m_spline);
     ts_bspline_new(numPoints, N, 3, TS_CLAMPED, &m_spline, &status);
 
@@ -68,26 +117,129 @@ struct spline
 
     ts_int_deboornet_init(&m_net);
     ts_int_deboornet_new(&m_spline, &m_net, &status);
+
+    if(m_net.pImpl && m_tolerance > 0.)
+      build_table();
+  }
+
+  //! Position on the curve, for pos in [0; 1]
+  point evaluate(double pos) const noexcept
+  {
+    if(m_table.empty())
+      return evaluate_exact(pos);
+
+    const std::size_t intervals = m_table.size() - 1;
+    const double x = std::clamp(pos, 0., 1.) * intervals;
+    const std::size_t i = std::min((std::size_t)x, intervals - 1);
+    const tsReal t = x - i;
+
+    const point& a = m_table[i];
+    const point& b = m_table[i + 1];
+    point res;
+    for(std::size_t k = 0; k < N; k++)
+      res[k] = a[k] + t * (b[k] - a[k]);
+    return res;
   }
 
-  std::array<tsReal, N> evaluate(double pos) const noexcept
+  //! Evaluates the curve at n positions at once, e.g. one per sample
+  void evaluate(const double* pos, point* out, std::size_t n) const noexcept
   {
-    std::array<tsReal, N> res = {};
+    for(std::size_t i = 0; i < n; i++)
+      out[i] = evaluate(pos[i]);
+  }
 
-    tsStatus status;
-    if(ts_int_bspline_eval_woa(&m_spline, pos, &m_net, &status) != 0)
-    {
-      // error during evaluation
+  /**
+   * @brief Evaluation with the de Boor algorithm, without the table.
+   *
+   * tinyspline's own evaluation snaps the positions close to a knot onto it,
+   * which makes the curve jump around each knot: it is thus done here.
+   */
+  point evaluate_exact(double pos) const noexcept
+  {
+    point res = {};
+    if(!m_spline.pImpl)
       return res;
+
+    constexpr std::size_t deg = 3;
+    const std::size_t n = ts_bspline_num_control_points(&m_spline);
+    const tsReal* knots = ts_bspline_knots_ptr(&m_spline);
+    const tsReal* ctrlp = ts_bspline_control_points_ptr(&m_spline);
+
+    // The span of u, in [knots[deg]; knots[n]]
+    const tsReal u = std::clamp(tsReal(pos), knots[deg], knots[n]);
+    const std::size_t k = std::upper_bound(knots + deg, knots + n, u) - knots - 1;
+
+    point d[deg + 1];
+    for(std::size_t j = 0; j <= deg; j++)
+      std::memcpy(d[j].data(), ctrlp + (k - deg + j) * N, sizeof(point));
+
+    for(std::size_t r = 1; r <= deg; r++)
+    {
+      for(std::size_t j = deg; j >= r; j--)
+      {
+        const std::size_t i = k - deg + j;
+        const tsReal alpha = (u - knots[i]) / (knots[i + deg + 1 - r] - knots[i]);
+        for(std::size_t c = 0; c < N; c++)
+          d[j][c] = (1 - alpha) * d[j - 1][c] + alpha * d[j][c];
+      }
     }
 
+    return d[deg];
+  }
+
+  //! Number of samples of the table, 0 if evaluation is exact
+  std::size_t table_size() const noexcept { return m_table.size(); }
+
+private:
+  static constexpr std::size_t min_intervals = 64;
+  static constexpr std::size_t max_intervals = 1 << 16;
+
+  void build_table() noexcept
+  {
+    // The number of intervals is doubled until the curve is close enough
+    // to the interpolation of the ends of each of them:
+    // the table is then allocated once.
+    std::size_t intervals = min_intervals;
+    while(intervals < max_intervals && !precise(intervals))
+      intervals *= 2;
+
+    try
+    {
+      m_table.resize(intervals + 1);
+    }
+    catch(...)
     {
-      const auto bytes = std::min(
-          (std::size_t)N * sizeof(tsReal), (std::size_t)ts_deboornet_sof_result(&m_net));
-      memcpy(res.data(), ts_int_deboornet_access_result(&m_net), bytes);
+      // Evaluation stays exact
+      return;
     }
 
-    return res;
+    for(std::size_t i = 0; i <= intervals; i++)
+      m_table[i] = evaluate_exact(double(i) / intervals);
+  }
+
+  // The error is measured at the quarters of each interval.
+  // Where the curve is a single cubic over the interval, the largest error is
+  // less than 1.1 times the largest measured one, hence the margin.
+  bool precise(std::size_t intervals) const noexcept
+  {
+    const double tolerance = m_tolerance / 1.1;
+    point a = evaluate_exact(0.);
+    for(std::size_t i = 0; i < intervals; i++)
+    {
+      const point b = evaluate_exact(double(i + 1) / intervals);
+      for(double q : {0.25, 0.5, 0.75})
+      {
+        const point p = evaluate_exact((i + q) / intervals);
+        for(std::size_t k = 0; k < N; k++)
+          if(std::abs(p[k] - (a[k] + q * (b[k] - a[k]))) > tolerance)
+            return false;
+      }
+      a = b;
+    }
+    return true;
   }
+
+  std::vector<point> m_table;
+  double m_tolerance{default_tolerance};
 };
 }
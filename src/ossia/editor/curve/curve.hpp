@@ -5,6 +5,7 @@
 #include <ossia/detail/flat_map.hpp>
 #include <ossia/detail/optional.hpp>
 #include <ossia/detail/ptr_container.hpp>
+#include <ossia/detail/span.hpp>
 #include <ossia/editor/curve/curve_abstract.hpp>
 #include <ossia/editor/curve/curve_segment.hpp>
 #include <ossia/editor/curve/curve_segment/easing.hpp>
@@ -13,6 +14,7 @@
 #include <ossia/network/value/destination.hpp>
 #include <ossia/network/value/value.hpp>
 
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <utility>
@@ -71,6 +73,7 @@ public:
     m_y0_destination = other.m_y0_destination;
 
     m_points = other.m_points;
+    m_batch = other.m_batch;
 
     m_y0_cacheUsed = false;
   }
@@ -82,6 +85,7 @@ public:
     m_y0_destination = std::move(other.m_y0_destination);
 
     m_points = std::move(other.m_points);
+    m_batch = std::move(other.m_batch);
 
     m_y0_cacheUsed = false;
   }
@@ -93,6 +97,7 @@ public:
     m_y0_destination = other.m_y0_destination;
 
     m_points = other.m_points;
+    m_batch = other.m_batch;
 
     m_y0_cacheUsed = false;
     return *this;
@@ -104,6 +109,7 @@ public:
     m_y0_destination = std::move(other.m_y0_destination);
 
     m_points = std::move(other.m_points);
+    m_batch = std::move(other.m_batch);
 
     m_y0_cacheUsed = false;
     return *this;
@@ -120,6 +126,12 @@ public:
  \return bool */
   bool add_point(ossia::curve_segment<Y>&& segment, X abscissa, Y value);
 
+  /*! add a segment of a known type, which can then be evaluated
+ without going through the type-erased curve_segment in values_at */
+  template <typename Segment>
+    requires(!std::is_same_v<std::remove_cvref_t<Segment>, ossia::curve_segment<Y>>)
+  bool add_point(Segment&& segment, X abscissa, Y value);
+
   /*! remove a point from the curve
  \param X point abscissa
  \return bool */
@@ -130,6 +142,13 @@ public:
  \return Y ordinate */
   Y value_at(X abscissa) const;
 
+  /*! get values at many abscissae at once
+ \details gives the same results as value_at for each abscissa,
+ but is much faster when the abscissae are sorted, e.g. one per sample.
+ \param abscissae
+ \param out must be at least as large as abscissae */
+  void values_at(tcb::span<const X> abscissae, tcb::span<Y> out) const;
+
   ossia::curve_type get_type() const override;
 
   /*! get initial point abscissa
@@ -171,7 +190,11 @@ public:
   static Y convert_to_template_type_value(
       const ossia::value& value, ossia::destination_index::const_iterator idx);
 
-  void reserve(std::size_t count) { m_points.reserve(count); }
+  void reserve(std::size_t count)
+  {
+    m_points.reserve(count);
+    m_batch.reserve(count);
+  }
 
 private:
   mutable X m_x0;
@@ -180,6 +203,9 @@ private:
 
   mutable map_type m_points;
 
+  // Same keys as m_points
+  curve_map<X, ossia::curve_segment_batch<Y>> m_batch;
+
   mutable Y m_y0_cache;
 
   mutable bool m_y0_cacheUsed = false;
@@ -196,6 +222,21 @@ inline bool
 curve<X, Y>::add_point(ossia::curve_segment<Y>&& segment, X abscissa, Y value)
 {
   m_points.emplace(abscissa, std::make_pair(value, std::move(segment)));
+  m_batch.emplace(abscissa, ossia::curve_segment_batch<Y>{});
+
+  return true;
+}
+
+template <typename X, typename Y>
+template <typename Segment>
+  requires(!std::is_same_v<std::remove_cvref_t<Segment>, ossia::curve_segment<Y>>)
+inline bool curve<X, Y>::add_point(Segment&& segment, X abscissa, Y value)
+{
+  auto batch = ossia::curve_segment_batch<Y>::make(segment);
+  m_points.emplace(
+      abscissa,
+      std::make_pair(value, ossia::curve_segment<Y>{std::forward<Segment>(segment)}));
+  m_batch.emplace(abscissa, batch);
 
   return true;
 }
@@ -203,6 +244,7 @@ curve<X, Y>::add_point(ossia::curve_segment<Y>&& segment, X abscissa, Y value)
 template <typename X, typename Y>
 inline bool curve<X, Y>::remove_point(X abscissa)
 {
+  m_batch.erase(abscissa);
   return m_points.erase(abscissa) > 0;
 }
 
@@ -235,6 +277,75 @@ inline Y curve<X, Y>::value_at(X abscissa) const
   return lastValue;
 }
 
+template <typename X, typename Y>
+inline void
+curve<X, Y>::values_at(tcb::span<const X> abscissae, tcb::span<Y> out) const
+{
+  const X x0 = get_x0();
+  const Y y0 = get_y0();
+  const std::size_t n = std::min(abscissae.size(), out.size());
+
+  const auto begin = m_points.begin();
+  const auto end = m_points.end();
+
+  std::size_t i = 0;
+  while(i < n)
+  {
+    // Same lookup as value_at: the segment ending on the first point
+    // which is not before the abscissa
+    const X x = abscissae[i];
+    const auto it = m_points.lower_bound(x);
+    if(it == end)
+    {
+      out[i++] = m_points.empty() ? y0 : std::prev(end)->second.first;
+      continue;
+    }
+    if(it == begin && !(x > x0))
+    {
+      out[i++] = y0;
+      continue;
+    }
+
+    X start_x = x0;
+    Y start_y = y0;
+    if(it != begin)
+    {
+      start_x = std::prev(it)->first;
+      start_y = std::prev(it)->second.first;
+    }
+    const X end_x = it->first;
+    const Y end_y = it->second.first;
+
+    // All the following abscissae in (start_x; end_x] use the same segment
+    std::size_t last = i + 1;
+    while(last < n && abscissae[last] > start_x && abscissae[last] <= end_x)
+      last++;
+
+    const double dx0 = start_x;
+    const double width = (double)end_x - dx0;
+    const auto& batch = m_batch.begin()[it - begin].second;
+    const auto& segment = it->second.second;
+
+    // Compute the ratios in blocks, then apply the segment to each block
+    static constexpr std::size_t block = 256;
+    double ratios[block];
+    for(std::size_t k = i; k < last; k += block)
+    {
+      const std::size_t count = std::min(block, last - k);
+      for(std::size_t j = 0; j < count; j++)
+        ratios[j] = ((double)abscissae[k + j] - dx0) / width;
+
+      if(batch.function)
+        batch.function(batch, ratios, start_y, end_y, out.data() + k, count);
+      else
+        for(std::size_t j = 0; j < count; j++)
+          out[k + j] = segment(ratios[j], start_y, end_y);
+    }
+
+    i = last;
+  }
+}
+
 template <typename X, typename Y>
 inline curve_type curve<X, Y>::get_type() const
 {
@@ -1,6 +1,10 @@
 #pragma once
 #include <smallfun.hpp>
 
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
 /**
  * \file curve_segment.hpp
  */
@@ -31,4 +35,44 @@ using curve_segment = smallfun::function<Y(double, Y, Y), 24 + 24>;
 #else
 using curve_segment = smallfun::function<Y(double, Y, Y), 24>;
 #endif
+
+/**
+ * \brief Evaluates a curve segment for many ratios at once.
+ *
+ * It keeps a copy of the concrete segment function, so that it can be
+ * called directly in a loop instead of through the type-erased curve_segment.
+ * When the segment type is not known, or too large, function is null.
+ */
+template <typename Y>
+struct curve_segment_batch
+{
+  using function_type = void (*)(
+      const curve_segment_batch& self, const double* ratios, Y start, Y end, Y* out,
+      std::size_t n);
+
+  function_type function{};
+  alignas(double) unsigned char storage[16]{};
+
+  template <typename Segment>
+  static curve_segment_batch make(const Segment& seg) noexcept
+  {
+    curve_segment_batch b;
+    if constexpr(
+        std::is_trivially_copyable_v<Segment> && std::is_default_constructible_v<Segment>
+        && sizeof(Segment) <= sizeof(storage)
+        && alignof(Segment) <= alignof(double)
+        && std::is_invocable_r_v<Y, const Segment&, double, Y, Y>)
+    {
+      std::memcpy(b.storage, &seg, sizeof(Segment));
+      b.function = [](const curve_segment_batch& self, const double* ratios, Y start,
+                      Y end, Y* out, std::size_t n) {
+        Segment seg;
+        std::memcpy(&seg, self.storage, sizeof(Segment));
+        for(std::size_t i = 0; i < n; i++)
+          out[i] = seg(ratios[i], start, end);
+      };
+    }
+    return b;
+  }
+};
 }
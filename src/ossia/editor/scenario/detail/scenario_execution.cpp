@@ -49,6 +49,7 @@ void scenario::make_happen(
     timeInterval->stop();
     mark_end_discontinuous{}(*timeInterval);
     stopped.erase(timeInterval.get());
+    m_touchedIntervals.insert(timeInterval.get());
   }
 
   event.tick(0_tv, tick_offset);
@@ -63,6 +64,7 @@ void scenario::make_happen(
     mark_start_discontinuous{}(*timeInterval);
 
     started.insert(timeInterval.get());
+    m_touchedIntervals.insert(timeInterval.get());
   }
 
   if(event.m_callback)
@@ -90,6 +92,7 @@ void scenario::make_dispose(time_event& event, interval_set& stopped)
     timeInterval->stop();
     mark_end_discontinuous{}(*timeInterval);
     stopped.erase(timeInterval.get());
+    m_touchedIntervals.insert(timeInterval.get());
   }
 
   // dispose next TimeIntervals end event if everything is disposed before
@@ -229,6 +232,7 @@ void scenario::stop_interval(time_interval& itv)
   itv.stop();
 
   m_runningIntervals.erase(&itv);
+  m_touchedIntervals.insert(&itv);
   m_itv_end_map.erase(&itv);
 }
 
@@ -258,7 +262,10 @@ void scenario::state_impl(const ossia::token_request& tk)
     for(auto it = m_runningIntervals.begin(); it != m_runningIntervals.end();)
     {
       if((*it)->get_end_event().get_status() == time_event::status::HAPPENED)
+      {
+        m_touchedIntervals.insert(*it);
         it = m_runningIntervals.erase(it);
+      }
       else
         ++it;
     }
@@ -350,6 +357,7 @@ void scenario::state_impl(const ossia::token_request& tk)
         // mark_start_discontinuous{}(*itv);
 
         m_runningIntervals.insert(itv);
+        m_touchedIntervals.insert(itv);
         auto& start_ev = itv->get_start_event();
         start_ev.set_status(ossia::time_event::status::HAPPENED);
         auto& end_ev = itv->get_end_event();
@@ -361,6 +369,7 @@ void scenario::state_impl(const ossia::token_request& tk)
           {
             running->stop();
           }
+          m_touchedIntervals.insert(m_runningIntervals.begin(), m_runningIntervals.end());
           m_runningIntervals.clear();
           m_itv_to_start.clear();
           break;
@@ -386,6 +395,7 @@ void scenario::state_impl(const ossia::token_request& tk)
           itv->stop();
         }
 
+        m_touchedIntervals.insert(itv);
         if(auto running_it = m_runningIntervals.find(itv);
            running_it != m_runningIntervals.end())
           m_runningIntervals.erase(running_it);
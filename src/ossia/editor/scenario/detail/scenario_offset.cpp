@@ -16,28 +16,57 @@
 namespace ossia
 {
 using past_events_map = ossia::flat_multimap<time_value, time_event*>;
-using DateMap = ossia::ptr_map<time_sync*, ossia::time_value>;
+using DateMap = ossia::ptr_map<const time_sync*, ossia::time_value>;
 using EventPtr = std::shared_ptr<ossia::time_event>;
 using IntervalPtr = std::shared_ptr<ossia::time_interval>;
-static void process_timesync_dates(time_sync& t, DateMap& map)
+
+// Same as time_sync::get_date, but each date is only computed once
+static time_value timesync_date(const time_sync& t, DateMap& dates)
+{
+  if(auto it = dates.find(&t); it != dates.end())
+    return it->second;
+
+  time_value date = Zero;
+  for(const EventPtr& ev : t.get_time_events())
+  {
+    auto& prev = ev->previous_time_intervals();
+    if(!prev.empty())
+    {
+      auto& prev_itv = *prev[0];
+      if(!prev_itv.graphal)
+      {
+        date = prev_itv.get_nominal_duration()
+               + timesync_date(prev_itv.get_start_event().get_time_sync(), dates);
+        break;
+      }
+    }
+  }
+
+  dates.insert(std::make_pair(&t, date));
+  return date;
+}
+
+static void process_timesync_dates(time_sync& t, DateMap& map, DateMap& dates)
 {
-  map.insert(std::make_pair(&t, t.get_date()));
+  // Already visited through another branch
+  if(!map.insert(std::make_pair(&t, timesync_date(t, dates))).second)
+    return;
 
   for(EventPtr& ev : t.get_time_events())
   {
     for(IntervalPtr& cst : ev->next_time_intervals())
     {
       if(!cst->graphal)
-        process_timesync_dates(cst->get_end_event().get_time_sync(), map);
+        process_timesync_dates(cst->get_end_event().get_time_sync(), map, dates);
     }
   }
 }
 
-void process_offset(
+static void process_offset(
     time_sync& timesync, ossia::time_value offset, past_events_map& pastEvents,
-    ossia::flat_set<ossia::time_event*>& seen_events)
+    ossia::flat_set<ossia::time_event*>& seen_events, DateMap& dates)
 {
-  time_value date = timesync.get_date();
+  time_value date = timesync_date(timesync, dates);
   auto get_event_status = [](const time_event& event) {
     switch(event.get_offset_behavior())
     {
@@ -80,7 +109,8 @@ void process_offset(
     for(const auto& timeInterval : event.previous_time_intervals())
     {
       time_value intervalOffset
-          = offset - timeInterval->get_start_event().get_time_sync().get_date();
+          = offset
+            - timesync_date(timeInterval->get_start_event().get_time_sync(), dates);
 
       if(intervalOffset < Zero)
       {
@@ -115,7 +145,7 @@ void process_offset(
       {
         process_offset(
             timeInterval->get_end_event().get_time_sync(), offset, pastEvents,
-            seen_events);
+            seen_events, dates);
       }
     }
   }
@@ -138,11 +168,14 @@ void scenario::transport_impl(ossia::time_value offset)
   ossia::flat_set<ossia::time_event*> seen_events;
   seen_events.reserve(pastEvents.size());
 
+  m_touchedIntervals.insert(m_runningIntervals.begin(), m_runningIntervals.end());
   m_runningIntervals.clear();
 
   // Precompute the default date of every timesync.
-  ossia::ptr_map<time_sync*, ossia::time_value> time_map;
-  process_timesync_dates(*m_nodes[0], time_map);
+  DateMap time_map, dates;
+  time_map.reserve(m_nodes.size());
+  dates.reserve(m_nodes.size());
+  process_timesync_dates(*m_nodes[0], time_map, dates);
 
   // Set *every* time interval prior to this one to be rigid
   // note : this change the semantics of the score and should not be done like
@@ -190,7 +223,7 @@ void scenario::transport_impl(ossia::time_value offset)
   }
 
   // propagate offset from the first TimeSync
-  process_offset(*m_nodes[0], offset, pastEvents, seen_events);
+  process_offset(*m_nodes[0], offset, pastEvents, seen_events, dates);
 
   // offset all TimeIntervals
   for(const auto& timeInterval : m_intervals)
@@ -199,7 +232,7 @@ void scenario::transport_impl(ossia::time_value offset)
 
     const auto& sev = cst.get_start_event();
     const auto& stn = sev.get_time_sync();
-    const auto start_date = sev.get_time_sync().get_date();
+    const auto start_date = timesync_date(stn, dates);
     const bool all_empty = ossia::all_of(stn.get_time_events(), [](const auto& ev) {
       return ev->previous_time_intervals().empty();
     });
@@ -215,9 +248,11 @@ void scenario::transport_impl(ossia::time_value offset)
     {
       cst.transport(intervalOffset);
       m_runningIntervals.insert(&cst);
+      m_touchedIntervals.insert(&cst);
     }
-    else
+    else if(m_touchedIntervals.erase(&cst))
     {
+      // Intervals which were never started nor moved are already at zero
       cst.transport(Zero);
     }
   }
@@ -236,11 +271,14 @@ void scenario::offset_impl(ossia::time_value offset)
   ossia::flat_set<ossia::time_event*> seen_events;
   seen_events.reserve(pastEvents.size());
 
+  m_touchedIntervals.insert(m_runningIntervals.begin(), m_runningIntervals.end());
   m_runningIntervals.clear();
 
   // Precompute the default date of every timesync.
-  ossia::ptr_map<time_sync*, ossia::time_value> time_map;
-  process_timesync_dates(*m_nodes[0], time_map);
+  DateMap time_map, dates;
+  time_map.reserve(m_nodes.size());
+  dates.reserve(m_nodes.size());
+  process_timesync_dates(*m_nodes[0], time_map, dates);
 
   // Set *every* time interval prior to this one to be rigid
   // note : this change the semantics of the score and should not be done like
@@ -288,7 +326,7 @@ void scenario::offset_impl(ossia::time_value offset)
   }
 
   // propagate offset from the first TimeSync
-  process_offset(*m_nodes[0], offset, pastEvents, seen_events);
+  process_offset(*m_nodes[0], offset, pastEvents, seen_events, dates);
 
   // build offset state from all ordered past events
   if(unmuted())
@@ -321,7 +359,7 @@ void scenario::offset_impl(ossia::time_value offset)
 
     auto& sev = cst.get_start_event();
     auto& stn = sev.get_time_sync();
-    auto start_date = sev.get_time_sync().get_date();
+    auto start_date = timesync_date(stn, dates);
     auto end_date = start_date + cst.get_nominal_duration();
     bool all_empty = ossia::all_of(stn.get_time_events(), [](const auto& ev) {
       return ev->previous_time_intervals().empty();
@@ -340,6 +378,7 @@ void scenario::offset_impl(ossia::time_value offset)
         cst.offset(offset - start_date);
 
         m_runningIntervals.insert(&cst);
+        m_touchedIntervals.insert(&cst);
       }
     }
   }
@@ -36,6 +36,7 @@ scenario::scenario()
   // m_rootNodes.reserve(1024);
 
   m_runningIntervals.reserve(1024);
+  m_touchedIntervals.reserve(1024);
   m_waitingNodes.reserve(1024);
   m_component_visit_cache.reserve(1024);
   m_component_visit_stack.reserve(1024);
@@ -98,6 +99,7 @@ void scenario::start()
         && endStatus == time_event::status::NONE)
     {
       m_runningIntervals.insert(&cst);
+      m_touchedIntervals.insert(&cst);
       cst.start();
       // TODO cst.tick_current();
     }
@@ -114,6 +116,7 @@ void scenario::start()
         && endStatus == time_event::status::PENDING)
     {
       m_runningIntervals.insert(&cst);
+      m_touchedIntervals.insert(&cst);
       cst.start();
       // const auto tok = ossia::token_request{};
       // cst.tick_current(0_tv, tok);
@@ -159,6 +162,7 @@ void scenario::stop()
     node->reset();
   }
 
+  m_touchedIntervals.insert(m_runningIntervals.begin(), m_runningIntervals.end());
   m_runningIntervals.clear();
   m_itv_to_start.clear();
   m_itv_to_stop.clear();
@@ -236,6 +240,7 @@ void scenario::remove_time_interval(const std::shared_ptr<time_interval>& itv)
     if(auto it = ossia::find(m_runningIntervals, itv.get());
        it != m_runningIntervals.end())
       m_runningIntervals.erase(it);
+    m_touchedIntervals.erase(itv.get());
     if(auto it = ossia::find(m_itv_to_start, itv.get()); it != m_itv_to_start.end())
       m_itv_to_start.erase(it);
     if(auto it = ossia::find(m_itv_to_stop, itv.get()); it != m_itv_to_stop.end())
@@ -315,6 +320,7 @@ void scenario::reset_subgraph(
   {
     itv->stop();
     m_runningIntervals.erase(itv.get());
+    m_touchedIntervals.insert(itv.get());
     m_itv_end_map.erase(itv.get());
   }
 }
@@ -164,6 +164,8 @@ private:
                                     // (the first is the start node)
 
   interval_set m_runningIntervals;
+  interval_set m_touchedIntervals; // started or moved since they were last
+                                   // reset: only those are reset on transport
   sync_set m_waitingNodes;
   small_sync_vec m_rootNodes;
   small_event_vec m_pendingEvents;
@@ -190,11 +192,11 @@ private:
   ossia::small_vector<quantized_interval, 2> m_itv_to_start;
   ossia::small_vector<quantized_interval, 2> m_itv_to_stop;
 
-  static void make_happen(
+  void make_happen(
       time_event& event, interval_set& started, interval_set& stopped,
       ossia::time_value tick_offset, const ossia::token_request& tok);
 
-  static void make_dispose(time_event& event, interval_set& stopped);
+  void make_dispose(time_event& event, interval_set& stopped);
 
   sync_status process_this(
       time_sync& node, small_event_vec& pendingEvents, small_event_vec& maxReachedEvents,
@@ -0,0 +1,285 @@
+#include <ossia/detail/algorithms.hpp>
+#include <ossia/network/base/fuzzysearch_index.hpp>
+#include <ossia/network/base/osc_address.hpp>
+
+#if defined(OSSIA_HAS_RAPIDFUZZ)
+#include <rapidfuzz/fuzz.hpp>
+#endif
+
+#include <algorithm>
+#include <cctype>
+#include <thread>
+
+namespace ossia::net
+{
+namespace
+{
+// Below this number of nodes, the search is not worth splitting across threads
+static constexpr std::size_t parallel_search_threshold = 16384;
+
+static void add_char(std::array<uint64_t, 2>& set, unsigned char c) noexcept
+{
+  c = std::min(c, (unsigned char)127);
+  set[c >> 6] |= uint64_t(1) << (c & 63);
+}
+
+static bool has_char(const std::array<uint64_t, 2>& set, unsigned char c) noexcept
+{
+  return set[c >> 6] & (uint64_t(1) << (c & 63));
+}
+
+static std::string to_lower(std::string str)
+{
+  for(char& c : str)
+    c = std::tolower((unsigned char)c);
+  return str;
+}
+
+struct search_pattern
+{
+  std::string text;
+
+  // Distinct characters of the pattern, with their count
+  std::vector<std::pair<unsigned char, int>> chars;
+
+  explicit search_pattern(std::string str)
+      : text{std::move(str)}
+  {
+    for(unsigned char c : text)
+    {
+      c = std::min(c, (unsigned char)127);
+      auto it = ossia::find_if(chars, [c](const auto& p) { return p.first == c; });
+      if(it != chars.end())
+        it->second++;
+      else
+        chars.emplace_back(c, 1);
+    }
+  }
+
+  /**
+   * partial_ratio compares the shortest string of length n with substrings of the
+   * other, with the score 2 * LCS / (n + substring length).
+   * The LCS is at most the number c of characters of the pattern found in the
+   * address, thus the score is at most 2c / (n + c).
+   */
+  double upper_bound(const std::array<uint64_t, 2>& set, std::size_t size) const noexcept
+  {
+    if(text.empty())
+      return 1.;
+
+    int common = 0;
+    for(auto [c, count] : chars)
+      if(has_char(set, c))
+        common += count;
+    if(common == 0)
+      return 0.;
+
+    const double n = std::min(text.size(), size);
+    return std::min(1., 2. * common / (n + common));
+  }
+};
+
+struct candidate
+{
+  double score{};
+  std::size_t index{};
+};
+
+static constexpr auto best_first
+    = [](const candidate& lhs, const candidate& rhs) { return lhs.score > rhs.score; };
+}
+
+fuzzysearch_index::fuzzysearch_index(ossia::net::device_base& dev)
+    : device{dev}
+{
+  add_recursive(dev.get_root_node());
+
+  dev.on_node_created.connect<&fuzzysearch_index::on_node_created>(*this);
+  dev.on_node_removing.connect<&fuzzysearch_index::on_node_removing>(*this);
+  dev.on_node_renamed.connect<&fuzzysearch_index::on_node_renamed>(*this);
+}
+
+fuzzysearch_index::~fuzzysearch_index() = default;
+
+void fuzzysearch_index::add(ossia::net::node_base& node)
+{
+  if(m_positions.find(&node) != m_positions.end())
+    return;
+
+  entry e;
+  e.node = &node;
+  e.address = ossia::net::osc_parameter_string_with_device(node);
+  e.lowercase = to_lower(e.address);
+  for(unsigned char c : e.address)
+    add_char(e.chars, c);
+  for(unsigned char c : e.lowercase)
+    add_char(e.lowercase_chars, c);
+
+  m_positions[&node] = m_entries.size();
+  m_entries.push_back(std::move(e));
+}
+
+void fuzzysearch_index::add_recursive(ossia::net::node_base& node)
+{
+  // Like fuzzysearch, the root itself is not a result
+  for(auto* child : node.children_copy())
+  {
+    add(*child);
+    add_recursive(*child);
+  }
+}
+
+void fuzzysearch_index::update_recursive(ossia::net::node_base& node)
+{
+  if(auto it = m_positions.find(&node); it != m_positions.end())
+  {
+    auto& e = m_entries[it->second];
+    e.address = ossia::net::osc_parameter_string_with_device(node);
+    e.lowercase = to_lower(e.address);
+    e.chars = {};
+    e.lowercase_chars = {};
+    for(unsigned char c : e.address)
+      add_char(e.chars, c);
+    for(unsigned char c : e.lowercase)
+      add_char(e.lowercase_chars, c);
+  }
+
+  for(auto* child : node.children_copy())
+    update_recursive(*child);
+}
+
+void fuzzysearch_index::on_node_created(ossia::net::node_base& node)
+{
+  // The node may come with its children, e.g. through add_child
+  add(node);
+  add_recursive(node);
+}
+
+void fuzzysearch_index::on_node_removing(ossia::net::node_base& node)
+{
+  // The children are removed before their parent
+  auto it = m_positions.find(&node);
+  if(it == m_positions.end())
+    return;
+
+  const std::size_t pos = it->second;
+  m_positions.erase(it);
+  if(pos != m_entries.size() - 1)
+  {
+    m_entries[pos] = std::move(m_entries.back());
+    m_positions[m_entries[pos].node] = pos;
+  }
+  m_entries.pop_back();
+}
+
+void fuzzysearch_index::on_node_renamed(ossia::net::node_base& node, std::string)
+{
+  update_recursive(node);
+}
+
+void fuzzysearch_index::search(
+    const std::vector<std::string>& patterns, std::vector<fuzzysearch_result>& results,
+    fuzzysearch_options opt) const
+{
+  results.clear();
+#if defined(OSSIA_HAS_RAPIDFUZZ)
+  std::vector<search_pattern> query;
+  query.reserve(patterns.size());
+  for(const auto& p : patterns)
+    query.emplace_back(opt.case_sensitive ? p : to_lower(p));
+
+  const std::size_t k = opt.max_results;
+
+  // Scores a range of entries, keeping the k best in a min-heap if k > 0
+  auto score_range = [&](std::size_t first, std::size_t last, auto& out) {
+    std::vector<rapidfuzz::fuzz::CachedPartialRatio<char>> scorers;
+    scorers.reserve(query.size());
+    for(const auto& p : query)
+      scorers.emplace_back(p.text);
+
+    for(std::size_t i = first; i < last; i++)
+    {
+      const auto& e = m_entries[i];
+      const auto& address = opt.case_sensitive ? e.address : e.lowercase;
+      const auto& set = opt.case_sensitive ? e.chars : e.lowercase_chars;
+
+      const bool full = k > 0 && out.size() == k;
+      const double threshold = full ? out.front().score : 0.;
+      if(full)
+      {
+        double bound = 100.;
+        for(const auto& p : query)
+          bound *= p.upper_bound(set, address.size());
+        if(bound <= threshold - 1e-6)
+          continue;
+      }
+
+      double percent = 1.0;
+      for(const auto& scorer : scorers)
+      {
+        // A factor below the threshold is enough to discard the node
+        percent *= scorer.similarity(address, threshold) / 100.;
+        if(percent == 0.)
+          break;
+      }
+
+      const candidate c{percent * 100., i};
+      if(k == 0 || out.size() < k)
+      {
+        out.push_back(c);
+        if(k > 0)
+          std::push_heap(out.begin(), out.end(), best_first);
+      }
+      else if(c.score > threshold)
+      {
+        std::pop_heap(out.begin(), out.end(), best_first);
+        out.back() = c;
+        std::push_heap(out.begin(), out.end(), best_first);
+      }
+    }
+  };
+
+  const std::size_t n = m_entries.size();
+  std::size_t threads = 1;
+  if(n >= parallel_search_threshold)
+    threads = std::clamp<std::size_t>(
+        std::thread::hardware_concurrency(), 1, n / (parallel_search_threshold / 2));
+
+  std::vector<std::vector<candidate>> partial(threads);
+  {
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    const std::size_t chunk = (n + threads - 1) / threads;
+    for(std::size_t t = 1; t < threads; t++)
+      workers.emplace_back([&, t] {
+        score_range(t * chunk, std::min(n, (t + 1) * chunk), partial[t]);
+      });
+    score_range(0, std::min(n, chunk), partial[0]);
+    for(auto& w : workers)
+      w.join();
+  }
+
+  std::vector<candidate> best = std::move(partial[0]);
+  for(std::size_t t = 1; t < threads; t++)
+    best.insert(best.end(), partial[t].begin(), partial[t].end());
+
+  if(k > 0 && best.size() > k)
+  {
+    std::partial_sort(best.begin(), best.begin() + k, best.end(), best_first);
+    best.resize(k);
+  }
+  else
+  {
+    std::sort(best.begin(), best.end(), best_first);
+  }
+
+  results.reserve(best.size());
+  for(const auto& c : best)
+  {
+    const auto& e = m_entries[c.index];
+    results.push_back(
+        {c.score, opt.case_sensitive ? e.address : e.lowercase, e.node});
+  }
+#endif
+}
+}
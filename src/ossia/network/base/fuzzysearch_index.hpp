@@ -0,0 +1,70 @@
+#pragma once
+#include <ossia/detail/hash_map.hpp>
+#include <ossia/network/base/device.hpp>
+#include <ossia/network/base/node_functions.hpp>
+
+#include <array>
+#include <string>
+#include <vector>
+
+namespace ossia::net
+{
+/**
+ * @brief Keeps the addresses of the nodes of a device ready for fuzzysearch.
+ *
+ * The index is built once, then kept up to date when nodes are created,
+ * removed or renamed: searching does not walk the device tree nor rebuild
+ * the address strings.
+ * The set of characters of each address is used to skip, without scoring
+ * them, the nodes which cannot be among the best results.
+ *
+ * Must be used from the thread which modifies the device.
+ */
+class OSSIA_EXPORT fuzzysearch_index final : public Nano::Observer
+{
+public:
+  ossia::net::device_base& device;
+  explicit fuzzysearch_index(ossia::net::device_base& dev);
+  ~fuzzysearch_index();
+
+  fuzzysearch_index(const fuzzysearch_index&) = delete;
+  fuzzysearch_index(fuzzysearch_index&&) = delete;
+  fuzzysearch_index& operator=(const fuzzysearch_index&) = delete;
+  fuzzysearch_index& operator=(fuzzysearch_index&&) = delete;
+
+  /**
+   * @brief Same results as ossia::net::fuzzysearch on the root of the device,
+   * sorted in descending score order.
+   */
+  void search(
+      const std::vector<std::string>& patterns, std::vector<fuzzysearch_result>& results,
+      fuzzysearch_options = {}) const;
+
+  //! Number of indexed nodes
+  std::size_t size() const noexcept { return m_entries.size(); }
+
+private:
+  // One bit per ASCII character, non-ASCII characters share the last one
+  using charset = std::array<uint64_t, 2>;
+
+  struct entry
+  {
+    ossia::net::node_base* node{};
+    std::string address;
+    std::string lowercase;
+    charset chars{};
+    charset lowercase_chars{};
+  };
+
+  void add(ossia::net::node_base& node);
+  void add_recursive(ossia::net::node_base& node);
+  void update_recursive(ossia::net::node_base& node);
+
+  void on_node_created(ossia::net::node_base& node);
+  void on_node_removing(ossia::net::node_base& node);
+  void on_node_renamed(ossia::net::node_base& node, std::string old_name);
+
+  std::vector<entry> m_entries;
+  ossia::hash_map<const ossia::net::node_base*, std::size_t> m_positions;
+};
+}
@@ -966,6 +966,25 @@ void fuzzysearch(
 #if defined(OSSIA_HAS_RAPIDFUZZ)
   results.clear();
 
+  // The patterns are prepared once for all the nodes
+  std::vector<rapidfuzz::fuzz::CachedPartialRatio<char>> scorers;
+  scorers.reserve(patterns.size());
+  for(const auto& pattern : patterns)
+  {
+    if(opt.case_sensitive)
+    {
+      scorers.emplace_back(pattern);
+    }
+    else
+    {
+      // Make everything lowercase, address and patterns
+      std::string lower = pattern;
+      for(char& c : lower)
+        c = std::tolower(c);
+      scorers.emplace_back(lower);
+    }
+  }
+
   for(const auto& node : nodes)
   {
     auto children = list_all_children(node);
@@ -977,39 +996,31 @@ void fuzzysearch(
       std::string oscaddress = ossia::net::osc_parameter_string_with_device(*n);
       if(!opt.case_sensitive)
       {
-        // Make everything lowercase, address and patterns
         for(char& c : oscaddress)
           c = std::tolower(c);
-        double percent = 1.0;
-
-        auto res = patterns;
-        for(std::string& s : res)
-          for(char& c : s)
-            c = std::tolower(c);
-
-        for(const auto& pattern : res)
-        {
-          percent *= rapidfuzz::fuzz::partial_ratio(oscaddress, pattern) / 100.;
-        }
-        results.push_back({percent * 100., oscaddress, n});
       }
-      else
+
+      double percent = 1.0;
+      for(const auto& scorer : scorers)
       {
-        double percent = 1.0;
-        for(const auto& pattern : patterns)
-        {
-          percent *= rapidfuzz::fuzz::partial_ratio(oscaddress, pattern) / 100.;
-        }
-        results.push_back({percent * 100., oscaddress, n});
+        percent *= scorer.similarity(oscaddress) / 100.;
       }
+      results.push_back({percent * 100., std::move(oscaddress), n});
     }
+  }
 
-    // TODO in the future, when we'll use C++20
-    // ranges::sort(results, std::greater{}, &fuzzysearch_result::score);
-    ossia::sort(
-        results, [](const fuzzysearch_result& left, const fuzzysearch_result& right) {
-          return left.score > right.score;
-        });
+  auto best_first = [](const fuzzysearch_result& left, const fuzzysearch_result& right) {
+    return left.score > right.score;
+  };
+  if(opt.max_results > 0 && results.size() > opt.max_results)
+  {
+    std::partial_sort(
+        results.begin(), results.begin() + opt.max_results, results.end(), best_first);
+    results.resize(opt.max_results);
+  }
+  else
+  {
+    ossia::sort(results, best_first);
   }
 #endif
 }
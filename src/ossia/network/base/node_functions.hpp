@@ -172,8 +172,16 @@ struct OSSIA_EXPORT fuzzysearch_result
 struct fuzzysearch_options
 {
   bool case_sensitive{true};
+
+  //! If not zero, only the best max_results nodes are returned
+  std::size_t max_results{};
 };
 
+/**
+ * @brief Scores all the nodes under the given ones against the patterns.
+ *
+ * For repeated searches in a device, see fuzzysearch_index.
+ */
 OSSIA_EXPORT
 void fuzzysearch(
     const std::vector<ossia::net::node_base*>& node,
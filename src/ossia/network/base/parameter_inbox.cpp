@@ -0,0 +1,189 @@
+#include <ossia/detail/algorithms.hpp>
+#include <ossia/network/base/parameter_inbox.hpp>
+
+#include <algorithm>
+
+namespace ossia
+{
+parameter_inbox::parameter_inbox(ossia::net::device_base& dev)
+    : device{dev}
+{
+  dev.on_parameter_removing.connect<&parameter_inbox::on_param_removed>(*this);
+}
+
+parameter_inbox::~parameter_inbox()
+{
+  collect_removed();
+#if defined(__cpp_exceptions)
+  try
+  {
+    for(auto& [param, slot] : m_slots)
+      param->remove_callback(slot->callback);
+  }
+  catch(...)
+  {
+  }
+#else
+  for(auto& [param, slot] : m_slots)
+    param->remove_callback(slot->callback);
+#endif
+}
+
+void parameter_inbox::slot::resize(int size, bool bound)
+{
+  std::lock_guard lock{mutex};
+  bounded = bounded && bound;
+  if(size <= (int)values.size())
+    return;
+
+  // Put the values in order before growing the buffer
+  std::rotate(values.begin(), values.begin() + first, values.end());
+  first = 0;
+  values.resize(size);
+  reading.resize(size);
+}
+
+int parameter_inbox::slot::swap_buffers()
+{
+  int n{}, start{};
+  {
+    std::lock_guard lock{mutex};
+    std::swap(values, reading);
+    n = std::exchange(count, 0);
+    start = std::exchange(first, 0);
+    dirty = false;
+  }
+
+  if(start != 0)
+    std::rotate(reading.begin(), reading.begin() + start, reading.end());
+  return n;
+}
+
+void parameter_inbox::push(slot& s, const ossia::value& v)
+{
+  bool was_dirty{};
+  {
+    std::lock_guard lock{s.mutex};
+    const int size = s.values.size();
+    if(s.count < size)
+    {
+      s.values[(s.first + s.count) % size] = v;
+      s.count++;
+    }
+    else if(!s.bounded)
+    {
+      // Full: put the values in order and grow the buffer
+      std::rotate(s.values.begin(), s.values.begin() + s.first, s.values.end());
+      s.first = 0;
+      s.values.resize(size * 2);
+      s.values[s.count] = v;
+      s.count++;
+    }
+    else
+    {
+      // Full: replace the oldest value
+      s.values[s.first] = v;
+      s.first = (s.first + 1) % size;
+      m_overflow.fetch_add(1, std::memory_order_relaxed);
+    }
+    was_dirty = std::exchange(s.dirty, true);
+  }
+
+  if(!was_dirty)
+  {
+    // Only the thread which sets the dirty flag adds the slot to the stack,
+    // and it is only removed from it by drain()
+    slot* head = m_dirty.load(std::memory_order_relaxed);
+    do
+    {
+      s.next_dirty = head;
+    } while(!m_dirty.compare_exchange_weak(
+        head, &s, std::memory_order_release, std::memory_order_relaxed));
+  }
+}
+
+void parameter_inbox::reg(ossia::net::parameter_base& p, int size)
+{
+  // A removed parameter may have left a slot at the same address
+  collect_removed();
+
+  const bool bounded = size > 0;
+  if(!bounded)
+    size = initial_size;
+  auto it = m_slots.find(&p);
+  if(it == m_slots.end())
+  {
+    auto s = std::make_unique<slot>();
+    s->address = &p;
+    s->registrations = 1;
+    s->resize(size, bounded);
+
+    auto ptr = s.get();
+    s->callback = p.add_callback([this, ptr](const ossia::value& val) { push(*ptr, val); });
+    m_slots.insert({&p, std::move(s)});
+  }
+  else
+  {
+    it->second->registrations++;
+    it->second->resize(size, bounded);
+  }
+}
+
+void parameter_inbox::unreg(ossia::net::parameter_base& p)
+{
+  // The callback of a removed parameter must not be removed again
+  collect_removed();
+
+  auto it = m_slots.find(&p);
+  if(it != m_slots.end())
+  {
+    auto& s = it->second;
+    s->registrations--;
+    if(s->registrations <= 0)
+    {
+      p.remove_callback(s->callback);
+      retire(std::move(s));
+      m_slots.erase(it);
+    }
+  }
+}
+
+void parameter_inbox::on_param_removed(const ossia::net::parameter_base& p)
+{
+  // May be called from any thread: the slot is removed in the next call to
+  // drain, reg or unreg
+  m_removed.enqueue(const_cast<ossia::net::parameter_base*>(&p));
+}
+
+void parameter_inbox::collect_removed()
+{
+  ossia::net::parameter_base* p{};
+  while(m_removed.try_dequeue(p))
+  {
+    auto it = m_slots.find(p);
+    if(it != m_slots.end())
+    {
+      retire(std::move(it->second));
+      m_slots.erase(it);
+    }
+  }
+}
+
+void parameter_inbox::retire(std::unique_ptr<slot> s)
+{
+  // The slot may still be in the dirty stack: it is kept until drained
+  s->removed = true;
+  m_garbage.push_back(std::move(s));
+}
+
+void parameter_inbox::collect_garbage()
+{
+  if(m_garbage.empty())
+    return;
+
+  ossia::remove_erase_if(m_garbage, [](const std::unique_ptr<slot>& s) {
+    std::lock_guard lock{s->mutex};
+    return !s->dirty;
+  });
+}
+}
@@ -0,0 +1,121 @@
+#pragma once
+#include <ossia/detail/audio_spin_mutex.hpp>
+#include <ossia/detail/lockfree_queue.hpp>
+#include <ossia/detail/ptr_set.hpp>
+#include <ossia/detail/span.hpp>
+#include <ossia/network/base/device.hpp>
+#include <ossia/network/base/parameter.hpp>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace ossia
+{
+/**
+ * @brief Keeps the values received by parameters until they are processed.
+ *
+ * Unlike message_queue, each registered parameter has its own buffer.
+ * By default it is unbounded, like message_queue: no value is ever dropped,
+ * and the buffer grows when needed, which allocates on the receiving thread.
+ *
+ * A parameter can instead be registered with a bound, allocated at
+ * registration: receiving a value then never allocates.
+ * When more values are received between two calls to drain() than the buffer
+ * can hold, the oldest ones are dropped and counted in overflow().
+ * A buffer of size 1 thus only keeps the latest value.
+ *
+ * Values can be received from any thread, while reg, unreg and drain must be
+ * called from a single thread, e.g. the execution thread.
+ */
+class OSSIA_EXPORT parameter_inbox final : public Nano::Observer
+{
+public:
+  //! Size of the buffer of unbounded parameters, before it first grows
+  static constexpr int initial_size = 16;
+
+  ossia::net::device_base& device;
+  explicit parameter_inbox(ossia::net::device_base& dev);
+  ~parameter_inbox();
+
+  parameter_inbox(const parameter_inbox&) = delete;
+  parameter_inbox(parameter_inbox&&) = delete;
+  parameter_inbox& operator=(const parameter_inbox&) = delete;
+  parameter_inbox& operator=(parameter_inbox&&) = delete;
+
+  //! Starts listening to a parameter, keeping at most size values between drains,
+  //! or all of them if size is 0.
+  //! If the parameter is already registered, its buffer only grows: a parameter
+  //! registered once without bound stays unbounded.
+  void reg(ossia::net::parameter_base& p, int size = 0);
+  void unreg(ossia::net::parameter_base& p);
+
+  /**
+   * @brief Calls f(parameter, span of values) for each parameter which received
+   * values since the last call, with the values in the order they were received.
+   *
+   * The values can be moved from.
+   */
+  template <typename F>
+  void drain(F&& f)
+  {
+    collect_removed();
+
+    slot* s = m_dirty.exchange(nullptr, std::memory_order_acquire);
+    while(s)
+    {
+      slot* next = s->next_dirty;
+      const int count = s->swap_buffers();
+      if(!s->removed && count > 0)
+        f(*s->address, tcb::span<ossia::value>(s->reading.data(), count));
+      s = next;
+    }
+
+    collect_garbage();
+  }
+
+  //! Number of values dropped since the creation of the inbox
+  int64_t overflow() const noexcept { return m_overflow.load(std::memory_order_relaxed); }
+
+private:
+  struct slot
+  {
+    ossia::net::parameter_base* address{};
+    ossia::net::parameter_base::callback_index callback;
+    int registrations{};
+    bool removed{};
+
+    // Circular buffer written by the network threads
+    ossia::audio_spin_mutex mutex;
+    std::vector<ossia::value> values TS_GUARDED_BY(mutex);
+    int first TS_GUARDED_BY(mutex){};
+    int count TS_GUARDED_BY(mutex){};
+    bool dirty TS_GUARDED_BY(mutex){};
+    bool bounded TS_GUARDED_BY(mutex){true};
+
+    // Linear buffer read by the execution thread
+    std::vector<ossia::value> reading;
+
+    slot* next_dirty{};
+
+    void resize(int size, bool bounded);
+    int swap_buffers();
+  };
+
+  void push(slot& s, const ossia::value& v);
+  void on_param_removed(const ossia::net::parameter_base& p);
+  void collect_removed();
+  void collect_garbage();
+  void retire(std::unique_ptr<slot> s);
+
+  ossia::ptr_map<ossia::net::parameter_base*, std::unique_ptr<slot>> m_slots;
+
+  // Intrusive stack of the slots which received values since the last drain
+  std::atomic<slot*> m_dirty{};
+  std::atomic<int64_t> m_overflow{};
+
+  // Parameters removed from the device: the slots are freed on the draining thread
+  ossia::mpmc_queue<ossia::net::parameter_base*> m_removed;
+  std::vector<std::unique_ptr<slot>> m_garbage;
+};
+}
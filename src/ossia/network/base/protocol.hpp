@@ -41,7 +41,10 @@ class OSSIA_EXPORT protocol_base
 public:
   enum flags
   {
-    SupportsMultiplex = (1 << 0)
+    SupportsMultiplex = (1 << 0),
+
+    //! push_bundle sends the values together instead of pushing them one by one
+    SupportsBundles = (1 << 1)
   };
 
   explicit protocol_base()
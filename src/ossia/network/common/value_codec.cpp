@@ -0,0 +1,576 @@
+#include <ossia/detail/small_vector.hpp>
+#include <ossia/network/base/node.hpp>
+#include <ossia/network/base/node_functions.hpp>
+#include <ossia/network/base/parameter.hpp>
+#include <ossia/network/common/value_codec.hpp>
+#include <ossia/network/value/value_conversion.hpp>
+
+#include <boost/endian/conversion.hpp>
+
+#include <fmt/format.h>
+
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <version>
+
+#if defined(__cpp_lib_to_chars)
+#include <charconv>
+#else
+#include <boost/spirit/home/x3.hpp>
+#endif
+
+namespace ossia::net
+{
+namespace
+{
+// A value is encoded as a sequence of scalars, one per field
+struct scalar
+{
+  double number{};
+  std::string_view text;
+  bool is_text{};
+};
+using scalars = ossia::small_vector<scalar, 16>;
+
+struct flatten_value
+{
+  scalars& out;
+  void operator()(ossia::impulse) const { }
+  void operator()(int32_t v) const { out.push_back({double(v)}); }
+  void operator()(float v) const { out.push_back({v}); }
+  void operator()(bool v) const { out.push_back({v ? 1. : 0.}); }
+  void operator()(const std::string& v) const { out.push_back({0., v, true}); }
+
+  template <std::size_t N>
+  void operator()(const std::array<float, N>& v) const
+  {
+    for(float f : v)
+      out.push_back({f});
+  }
+
+  void operator()(const std::vector<ossia::value>& v) const
+  {
+    for(const auto& sub : v)
+      sub.apply(*this);
+  }
+
+  void operator()(const value_map_type& v) const
+  {
+    for(const auto& [k, sub] : v)
+      sub.apply(*this);
+  }
+
+  void operator()() const { }
+};
+
+static bool is_space(char c) noexcept
+{
+  return std::isspace((unsigned char)c);
+}
+
+static void skip_spaces(std::string_view& in) noexcept
+{
+  while(!in.empty() && is_space(in.front()))
+    in.remove_prefix(1);
+}
+
+template <typename T>
+static bool read_number(std::string_view& in, T& res, int base = 10) noexcept
+{
+#if defined(__cpp_lib_to_chars)
+  const char* begin = in.data();
+  const char* end = in.data() + in.size();
+  std::from_chars_result r;
+  if constexpr(std::is_floating_point_v<T>)
+    r = std::from_chars(begin, end, res);
+  else
+    r = std::from_chars(begin, end, res, base);
+  if(r.ec != std::errc{})
+    return false;
+  in.remove_prefix(r.ptr - begin);
+  return true;
+#else
+  namespace x3 = boost::spirit::x3;
+  auto it = in.begin();
+  bool ok{};
+  if constexpr(std::is_floating_point_v<T>)
+    ok = x3::parse(it, in.end(), x3::double_, res);
+  else if(base == 16)
+    ok = x3::parse(it, in.end(), x3::hex, res);
+  else
+    ok = x3::parse(it, in.end(), x3::long_long, res);
+  if(!ok)
+    return false;
+  in.remove_prefix(it - in.begin());
+  return true;
+#endif
+}
+
+// Casting a double which is NaN or out of the range of an integer type is
+// undefined: values are saturated to the range of the field, NaN gives 0
+template <typename T>
+static T saturate(double d) noexcept
+{
+  if(std::isnan(d))
+    return 0;
+  if(d <= (double)std::numeric_limits<T>::min())
+    return std::numeric_limits<T>::min();
+  if(d >= (double)std::numeric_limits<T>::max())
+    return std::numeric_limits<T>::max();
+  return (T)d;
+}
+
+// Values have no 64-bit integers: integers which do not fit in an int are
+// read as floats instead of wrapping around
+template <typename T>
+static ossia::value integer_value(T n) noexcept
+{
+  constexpr auto min = std::numeric_limits<int32_t>::min();
+  constexpr auto max = std::numeric_limits<int32_t>::max();
+  if constexpr(std::is_signed_v<T>)
+  {
+    if(n >= min && n <= max)
+      return (int32_t)n;
+  }
+  else
+  {
+    if(n <= (uint64_t)max)
+      return (int32_t)n;
+  }
+  return (float)n;
+}
+
+static int field_size(char type)
+{
+  switch(type)
+  {
+    case 'b':
+    case 'B':
+    case 'x':
+      return 1;
+    case 'h':
+    case 'H':
+      return 2;
+    case 'i':
+    case 'I':
+    case 'f':
+      return 4;
+    case 'q':
+    case 'Q':
+    case 'd':
+      return 8;
+    default:
+      return 0;
+  }
+}
+
+template <typename T>
+static void write_binary(T v, bool big_endian, std::string& out)
+{
+  if(big_endian)
+    boost::endian::native_to_big_inplace(v);
+  else
+    boost::endian::native_to_little_inplace(v);
+  char bytes[sizeof(T)];
+  std::memcpy(bytes, &v, sizeof(T));
+  out.append(bytes, sizeof(T));
+}
+
+template <typename T>
+static T read_binary(const char* in, bool big_endian)
+{
+  T v;
+  std::memcpy(&v, in, sizeof(T));
+  if(big_endian)
+    boost::endian::big_to_native_inplace(v);
+  else
+    boost::endian::little_to_native_inplace(v);
+  return v;
+}
+
+template <typename T>
+static T bit_cast_from(auto v)
+{
+  T res;
+  std::memcpy(&res, &v, sizeof(T));
+  return res;
+}
+}
+
+value_codec value_codec::text(std::string_view format)
+{
+  value_codec c;
+  std::string literal;
+  for(std::size_t i = 0; i < format.size(); i++)
+  {
+    if(format[i] != '%')
+    {
+      literal += format[i];
+      continue;
+    }
+
+    if(++i == format.size())
+      throw std::runtime_error("value_codec: unterminated conversion");
+    if(format[i] == '%')
+    {
+      literal += '%';
+      continue;
+    }
+
+    if(!literal.empty())
+      c.m_fields.push_back({.literal = std::move(literal)});
+    literal.clear();
+
+    field f;
+    // Flags and width are not supported, only a precision
+    if(format[i] == '.')
+    {
+      f.precision = 0;
+      while(++i < format.size() && std::isdigit((unsigned char)format[i]))
+        f.precision = f.precision * 10 + (format[i] - '0');
+    }
+    // Length modifiers are irrelevant here
+    while(i < format.size() && (format[i] == 'l' || format[i] == 'h'))
+      i++;
+    if(i == format.size())
+      throw std::runtime_error("value_codec: unterminated conversion");
+
+    switch(format[i])
+    {
+      case 'd':
+      case 'i':
+      case 'u':
+      case 'x':
+      case 'X':
+      case 'f':
+      case 'F':
+      case 'e':
+      case 'g':
+      case 's':
+        f.type = format[i];
+        break;
+      default:
+        throw std::runtime_error(
+            std::string("value_codec: unsupported conversion: %") + format[i]);
+    }
+    c.m_fields.push_back(std::move(f));
+  }
+  if(!literal.empty())
+    c.m_fields.push_back({.literal = std::move(literal)});
+  return c;
+}
+
+value_codec value_codec::binary(std::string_view layout)
+{
+  value_codec c;
+  c.m_binary = true;
+
+  bool big_endian = boost::endian::order::native == boost::endian::order::big;
+  std::size_t i = 0;
+  if(!layout.empty())
+  {
+    switch(layout[0])
+    {
+      case '<':
+        big_endian = false;
+        i++;
+        break;
+      case '>':
+      case '!':
+        big_endian = true;
+        i++;
+        break;
+      case '=':
+      case '@':
+        i++;
+        break;
+    }
+  }
+
+  for(; i < layout.size(); i++)
+  {
+    const char ch = layout[i];
+    if(is_space(ch))
+      continue;
+
+    if(ch == '#')
+    {
+      long long byte{};
+      std::string_view hex = layout.substr(i + 1, 2);
+      if(hex.size() != 2 || !read_number(hex, byte, 16) || !hex.empty())
+        throw std::runtime_error("value_codec: invalid literal byte");
+      if(!c.m_fields.empty() && c.m_fields.back().type == 0)
+        c.m_fields.back().literal += char(byte);
+      else
+        c.m_fields.push_back({.literal = std::string(1, char(byte))});
+      i += 2;
+      continue;
+    }
+
+    int count = 1;
+    if(std::isdigit((unsigned char)ch))
+    {
+      count = 0;
+      while(i < layout.size() && std::isdigit((unsigned char)layout[i]))
+        count = count * 10 + (layout[i++] - '0');
+      if(i == layout.size())
+        throw std::runtime_error("value_codec: count without field");
+    }
+
+    const char type = layout[i];
+    if(type == 's')
+    {
+      c.m_fields.push_back({.type = 's', .size = count});
+      continue;
+    }
+
+    const int size = field_size(type);
+    if(size == 0)
+      throw std::runtime_error(
+          std::string("value_codec: unsupported field: ") + type);
+    for(int k = 0; k < count; k++)
+      c.m_fields.push_back({.type = type, .big_endian = big_endian, .size = size});
+  }
+  return c;
+}
+
+void value_codec::encode(const ossia::value& v, std::string& out) const
+{
+  scalars values;
+  v.apply(flatten_value{values});
+
+  std::size_t next = 0;
+  auto take = [&]() -> scalar {
+    return next < values.size() ? values[next++] : scalar{};
+  };
+
+  if(!m_binary)
+  {
+    auto it = std::back_inserter(out);
+    for(const auto& f : m_fields)
+    {
+      if(f.type == 0)
+      {
+        out += f.literal;
+        continue;
+      }
+
+      const scalar s = take();
+      const int prec = f.precision >= 0 ? f.precision : 6;
+      switch(f.type)
+      {
+        case 'd':
+        case 'i':
+          fmt::format_to(it, "{}", saturate<int64_t>(s.number));
+          break;
+        case 'u':
+          fmt::format_to(it, "{}", saturate<uint64_t>(s.number));
+          break;
+        case 'x':
+          fmt::format_to(it, "{:x}", saturate<int64_t>(s.number));
+          break;
+        case 'X':
+          fmt::format_to(it, "{:X}", saturate<int64_t>(s.number));
+          break;
+        case 'f':
+        case 'F':
+          fmt::format_to(it, "{:.{}f}", s.number, prec);
+          break;
+        case 'e':
+          fmt::format_to(it, "{:.{}e}", s.number, prec);
+          break;
+        case 'g':
+          fmt::format_to(it, "{:.{}g}", s.number, prec);
+          break;
+        case 's':
+          if(s.is_text)
+            out += s.text;
+          else
+            fmt::format_to(it, "{}", s.number);
+          break;
+      }
+    }
+  }
+  else
+  {
+    for(const auto& f : m_fields)
+    {
+      if(f.type == 0)
+      {
+        out += f.literal;
+        continue;
+      }
+      if(f.type == 'x')
+      {
+        out += '\0';
+        continue;
+      }
+
+      const scalar s = take();
+      const bool be = f.big_endian;
+      switch(f.type)
+      {
+        // clang-format off
+        case 'b': write_binary(saturate<int8_t>(s.number), be, out); break;
+        case 'B': write_binary(saturate<uint8_t>(s.number), be, out); break;
+        case 'h': write_binary(saturate<int16_t>(s.number), be, out); break;
+        case 'H': write_binary(saturate<uint16_t>(s.number), be, out); break;
+        case 'i': write_binary(saturate<int32_t>(s.number), be, out); break;
+        case 'I': write_binary(saturate<uint32_t>(s.number), be, out); break;
+        case 'q': write_binary(saturate<int64_t>(s.number), be, out); break;
+        case 'Q': write_binary(saturate<uint64_t>(s.number), be, out); break;
+        case 'f': write_binary(bit_cast_from<uint32_t>((float)s.number), be, out); break;
+        case 'd': write_binary(bit_cast_from<uint64_t>(s.number), be, out); break;
+        // clang-format on
+        case 's': {
+          const auto n = std::min<std::size_t>(s.text.size(), f.size);
+          out.append(s.text.data(), n);
+          out.append(f.size - n, '\0');
+          break;
+        }
+      }
+    }
+  }
+}
+
+bool value_codec::decode(std::string_view in, ossia::value& out) const
+{
+  ossia::small_vector<ossia::value, 8> res;
+
+  if(!m_binary)
+  {
+    for(const auto& f : m_fields)
+    {
+      if(f.type == 0)
+      {
+        for(char c : f.literal)
+        {
+          if(is_space(c))
+            skip_spaces(in);
+          else if(!in.empty() && in.front() == c)
+            in.remove_prefix(1);
+          else
+            return false;
+        }
+        continue;
+      }
+
+      skip_spaces(in);
+      switch(f.type)
+      {
+        case 'd':
+        case 'i':
+        case 'u':
+        case 'x':
+        case 'X': {
+          long long n{};
+          if(!in.empty() && in.front() == '+')
+            in.remove_prefix(1);
+          if(!read_number(in, n, (f.type == 'x' || f.type == 'X') ? 16 : 10))
+            return false;
+          res.push_back(integer_value(n));
+          break;
+        }
+        case 's': {
+          std::size_t n = 0;
+          while(n < in.size() && !is_space(in[n]))
+            n++;
+          if(n == 0)
+            return false;
+          res.push_back(std::string(in.substr(0, n)));
+          in.remove_prefix(n);
+          break;
+        }
+        default: {
+          double d{};
+          if(!in.empty() && in.front() == '+')
+            in.remove_prefix(1);
+          if(!read_number(in, d))
+            return false;
+          res.push_back((float)d);
+          break;
+        }
+      }
+    }
+
+    // e.g. a line delimiter which was not removed by the framing
+    skip_spaces(in);
+    if(!in.empty())
+      return false;
+  }
+  else
+  {
+    std::size_t total = 0;
+    for(const auto& f : m_fields)
+      total += f.type == 0 ? f.literal.size() : f.size;
+    if(in.size() != total)
+      return false;
+
+    const char* p = in.data();
+    for(const auto& f : m_fields)
+    {
+      if(f.type == 0)
+      {
+        if(std::memcmp(p, f.literal.data(), f.literal.size()) != 0)
+          return false;
+        p += f.literal.size();
+        continue;
+      }
+
+      const bool be = f.big_endian;
+      switch(f.type)
+      {
+        // clang-format off
+        case 'b': res.push_back((int32_t)(int8_t)*p); break;
+        case 'B': res.push_back((int32_t)(uint8_t)*p); break;
+        case 'h': res.push_back((int32_t)read_binary<int16_t>(p, be)); break;
+        case 'H': res.push_back((int32_t)read_binary<uint16_t>(p, be)); break;
+        case 'i': res.push_back((int32_t)read_binary<int32_t>(p, be)); break;
+        case 'I': res.push_back(integer_value(read_binary<uint32_t>(p, be))); break;
+        case 'q': res.push_back(integer_value(read_binary<int64_t>(p, be))); break;
+        case 'Q': res.push_back(integer_value(read_binary<uint64_t>(p, be))); break;
+        case 'f': res.push_back(bit_cast_from<float>(read_binary<uint32_t>(p, be))); break;
+        case 'd': res.push_back((float)bit_cast_from<double>(read_binary<uint64_t>(p, be))); break;
+        // clang-format on
+        case 's':
+          res.push_back(std::string(p, strnlen(p, f.size)));
+          break;
+        case 'x':
+          break;
+      }
+      p += f.size;
+    }
+  }
+
+  if(res.size() == 1)
+    out = std::move(res.front());
+  else
+    out = std::vector<ossia::value>(
+        std::make_move_iterator(res.begin()), std::make_move_iterator(res.end()));
+  return true;
+}
+
+ossia::net::parameter_base* value_decoders::decode(
+    ossia::net::node_base& root, std::string_view message, ossia::value& out) const
+{
+  for(const auto& [address, codec] : decoders)
+  {
+    if(!codec->decode(message, out))
+      continue;
+
+    auto node = ossia::net::find_node(root, address);
+    if(!node)
+      continue;
+    auto param = node->get_parameter();
+    if(!param)
+      continue;
+
+    out = ossia::convert(out, param->get_value_type());
+    return param;
+  }
+  return nullptr;
+}
+}
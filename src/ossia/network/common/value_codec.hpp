@@ -0,0 +1,99 @@
+#pragma once
+#include <ossia/network/value/value.hpp>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ossia::net
+{
+class node_base;
+class parameter_base;
+
+/**
+ * @brief Native conversion between values and the messages of a device.
+ *
+ * Formats are declared in the device description and compiled once, so that
+ * values can be written to and read from text or binary protocols without
+ * going through a script engine.
+ *
+ * Text formats are printf / scanf-like templates, e.g. "SPD %.2f" or
+ * "POS %d %d". Supported conversions: %d %i %u %x %X %f %F %e %g %s %%.
+ * When reading, whitespace in the template matches any amount of whitespace.
+ *
+ * Binary formats are struct layouts, e.g. ">#02 h h f":
+ * - an optional byte order: '<' little endian, '>' or '!' big endian,
+ *   '=' or '@' native (the default),
+ * - fields with an optional count: b B (8 bits), h H (16 bits), i I (32 bits),
+ *   q Q (64 bits), f (float), d (double), Ns (string of N bytes),
+ *   x (padding byte),
+ * - literal bytes: '#' followed by two hex digits, e.g. a header.
+ *
+ * Each field takes the next scalar of the value: the value itself,
+ * or the elements of a vecNf or of a list.
+ * A message is read as a single value if the format has one field,
+ * as a list otherwise.
+ *
+ * Numbers written to integer fields are saturated to the range of the field,
+ * and NaN is written as 0. Integers read which do not fit in an int, e.g. from
+ * I, q or Q fields, are read as floats.
+ */
+class OSSIA_EXPORT value_codec
+{
+public:
+  //! Throws std::runtime_error if the template is invalid
+  static value_codec text(std::string_view format);
+
+  //! Throws std::runtime_error if the layout is invalid
+  static value_codec binary(std::string_view layout);
+
+  //! Appends the encoded value to out
+  void encode(const ossia::value& v, std::string& out) const;
+
+  //! Reads a whole message, returns false if it does not match the format
+  bool decode(std::string_view message, ossia::value& out) const;
+
+  bool is_binary() const noexcept { return m_binary; }
+
+  struct field
+  {
+    // Conversion character, or 0 for a literal
+    char type{};
+    bool big_endian{};
+    int precision{-1};
+    int size{};
+    std::string literal;
+  };
+
+private:
+  value_codec() = default;
+
+  std::vector<field> m_fields;
+  bool m_binary{};
+};
+
+/**
+ * @brief The decoders declared for the parameters of a device.
+ *
+ * Incoming messages are matched against each decoder in declaration order.
+ */
+struct OSSIA_EXPORT value_decoders
+{
+  struct decoder
+  {
+    std::string address;
+    std::shared_ptr<const value_codec> codec;
+  };
+  std::vector<decoder> decoders;
+
+  bool empty() const noexcept { return decoders.empty(); }
+
+  /**
+   * @brief Finds the first decoder which matches the message.
+   * @return the parameter and its new value, or nullptr if none matched.
+   */
+  ossia::net::parameter_base*
+  decode(ossia::net::node_base& root, std::string_view message, ossia::value& out) const;
+};
+}
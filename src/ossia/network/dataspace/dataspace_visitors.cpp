@@ -351,14 +351,134 @@ merge(const value_with_unit& vu, const ossia::vec4f& val, std::bitset<4> idx)
   return vu;
 }
 
+namespace
+{
+// Calls f(source unit, destination unit) with the concrete unit types,
+// so that the conversion is resolved once for many values.
+template <typename R, typename F>
+R apply_to_units(const unit_t& source_unit, const unit_t& destination_unit, F&& f)
+{
+  if(!source_unit || !check_units_convertible(source_unit, destination_unit))
+    return R{};
+
+  return ossia::apply_nonnull(
+      [&](const auto& src_dataspace) -> R {
+        using dataspace_t = std::decay_t<decltype(src_dataspace)>;
+        const auto& dst_dataspace = *destination_unit.v.target<dataspace_t>();
+        if(!src_dataspace || !dst_dataspace)
+          return R{};
+
+        return ossia::apply_nonnull(
+            [&](auto src) -> R {
+              return ossia::apply_nonnull(
+                  [&](auto dst) -> R { return f(src, dst); }, dst_dataspace);
+            },
+            src_dataspace);
+      },
+      source_unit.v);
+}
+
+template <typename T>
+bool convert_array(
+    tcb::span<T> values, const unit_t& source_unit, const unit_t& destination_unit)
+{
+  return apply_to_units<bool>(
+      source_unit, destination_unit, [values](auto src, auto dst) {
+        using src_t = decltype(src);
+        using dst_t = decltype(dst);
+        if constexpr(
+            std::is_same_v<typename src_t::value_type, T>
+            && std::is_same_v<typename dst_t::value_type, T>)
+        {
+          if constexpr(!std::is_same_v<src_t, dst_t>)
+          {
+            for(T& v : values)
+              v = strong_value<dst_t>{strong_value<src_t>{v}}.dataspace_value;
+          }
+          return true;
+        }
+        else
+        {
+          return false;
+        }
+      });
+}
+
+// Lists of values of the unit's type, e.g. a list of vec3f for a list of
+// colors: every element is converted, instead of the list being taken as a
+// single value. Returns an invalid value if the list does not match.
+ossia::value convert_list(
+    const std::vector<ossia::value>& list, const unit_t& source_unit,
+    const unit_t& destination_unit)
+{
+  return apply_to_units<ossia::value>(
+      source_unit, destination_unit, [&list](auto src, auto dst) -> ossia::value {
+        using src_t = decltype(src);
+        using dst_t = decltype(dst);
+        using src_value_t = typename src_t::value_type;
+
+        // Empty lists and e.g. lists of 3 floats for a vec3f unit
+        // keep being converted as a single value
+        if(list.empty())
+          return {};
+
+        std::vector<ossia::value> res;
+        res.reserve(list.size());
+        for(const auto& v : list)
+        {
+          auto val = v.target<src_value_t>();
+          if(!val)
+            return {};
+          res.emplace_back(
+              strong_value<dst_t>{strong_value<src_t>{*val}}.dataspace_value);
+        }
+        return res;
+      });
+}
+}
+
 ossia::value convert(
     const ossia::value& value, const ossia::unit_t& source_unit,
     const ossia::unit_t& destination_unit)
 {
+  if(auto list = value.target<std::vector<ossia::value>>())
+  {
+    if(auto res = convert_list(*list, source_unit, destination_unit); res.valid())
+      return res;
+  }
+
   return ossia::to_value(
       ossia::convert(ossia::make_value(value, source_unit), destination_unit));
 }
 
+bool convert(
+    tcb::span<float> values, const ossia::unit_t& source_unit,
+    const ossia::unit_t& destination_unit)
+{
+  return convert_array(values, source_unit, destination_unit);
+}
+
+bool convert(
+    tcb::span<ossia::vec2f> values, const ossia::unit_t& source_unit,
+    const ossia::unit_t& destination_unit)
+{
+  return convert_array(values, source_unit, destination_unit);
+}
+
+bool convert(
+    tcb::span<ossia::vec3f> values, const ossia::unit_t& source_unit,
+    const ossia::unit_t& destination_unit)
+{
+  return convert_array(values, source_unit, destination_unit);
+}
+
+bool convert(
+    tcb::span<ossia::vec4f> values, const ossia::unit_t& source_unit,
+    const ossia::unit_t& destination_unit)
+{
+  return convert_array(values, source_unit, destination_unit);
+}
+
 template OSSIA_EXPORT ossia::unit_t parse_unit(std::string_view, ossia::color_u);
 template OSSIA_EXPORT ossia::unit_t parse_unit(std::string_view, ossia::distance_u);
 template OSSIA_EXPORT ossia::unit_t parse_unit(std::string_view, ossia::position_u);
@@ -1,5 +1,6 @@
 #pragma once
 #include <ossia/detail/destination_index.hpp>
+#include <ossia/detail/span.hpp>
 #include <ossia/detail/string_view.hpp>
 #include <ossia/network/common/parameter_properties.hpp>
 #include <ossia/network/value/vec.hpp>
@@ -172,6 +173,30 @@ OSSIA_EXPORT ossia::value convert(
     const ossia::value& v, const ossia::unit_t& source_unit,
     const ossia::unit_t& destination_unit);
 
+/**
+ * @brief convert Convert an array of values to another unit, in place.
+ * @param values Values expressed in source_unit.
+ *
+ * The conversion is looked up once for the whole array instead of once
+ * per value. Both units must be in the same dataspace and use this
+ * type of value, e.g. vec3f for rgb and hsv.
+ *
+ * @return false if the units do not allow the conversion, in which case
+ * the values are left untouched.
+ */
+OSSIA_EXPORT bool convert(
+    tcb::span<float> values, const ossia::unit_t& source_unit,
+    const ossia::unit_t& destination_unit);
+OSSIA_EXPORT bool convert(
+    tcb::span<ossia::vec2f> values, const ossia::unit_t& source_unit,
+    const ossia::unit_t& destination_unit);
+OSSIA_EXPORT bool convert(
+    tcb::span<ossia::vec3f> values, const ossia::unit_t& source_unit,
+    const ossia::unit_t& destination_unit);
+OSSIA_EXPORT bool convert(
+    tcb::span<ossia::vec4f> values, const ossia::unit_t& source_unit,
+    const ossia::unit_t& destination_unit);
+
 /**
  * @brief convert Convert a value + unit to a simple value
  * @param v Value to convert
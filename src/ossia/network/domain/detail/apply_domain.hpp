@@ -156,6 +156,13 @@ ossia::value apply_domain_visitor::operator()(
     const std::vector<ossia::value>& value, const domain_base<T>& domain) const
 {
   std::vector<ossia::value> res = value;
+  if constexpr(std::is_same_v<T, float> || std::is_same_v<T, int32_t>)
+  {
+    if(bound_numeric_range(
+           domain, b, res, [](ossia::value& v) { return v.target<T>(); }))
+      return ossia::value{std::move(res)};
+  }
+
   for(auto& val : res)
   {
     if(val.get_type() == ossia::value_trait<T>::ossia_enum)
@@ -169,6 +176,13 @@ template <typename T>
 ossia::value apply_domain_visitor::operator()(
     std::vector<ossia::value>&& value, const domain_base<T>& domain) const
 {
+  if constexpr(std::is_same_v<T, float> || std::is_same_v<T, int32_t>)
+  {
+    if(bound_numeric_range(
+           domain, b, value, [](ossia::value& v) { return v.target<T>(); }))
+      return ossia::value{std::move(value)};
+  }
+
   for(auto& val : value)
   {
     if(val.get_type() == ossia::value_trait<T>::ossia_enum)
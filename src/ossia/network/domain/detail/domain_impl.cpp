@@ -1029,6 +1029,9 @@ value apply_domain_visitor::operator()(
 value apply_domain_visitor::operator()(
     float value, const domain_base<int32_t>& domain) const
 {
+  // Do not truncate the value if no bound applies
+  if(!numeric_bound_applies(domain, b))
+    return value;
   auto res = numeric_clamp<domain_base<int32_t>>{domain}(b, int32_t(value));
   return convert(res, val_type::FLOAT);
 }
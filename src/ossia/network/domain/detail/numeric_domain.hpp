@@ -22,4 +22,99 @@ struct numeric_clamp
   template <std::size_t N>
   ossia::value operator()(bounding_mode b, std::array<float, N> val) const;
 };
+
+//! True if applying the domain with this bounding mode can change a value
+template <typename T>
+bool numeric_bound_applies(const domain_base<T>& domain, bounding_mode b) noexcept
+{
+  if(b == bounding_mode::FREE)
+    return false;
+  if(!domain.values.empty())
+    return true;
+
+  const bool has_min = bool(domain.min);
+  const bool has_max = bool(domain.max);
+  if(has_min && has_max)
+    return true;
+  else if(has_min)
+    return b == bounding_mode::CLIP || b == bounding_mode::CLAMP_LOW;
+  else if(has_max)
+    return b == bounding_mode::CLIP || b == bounding_mode::CLAMP_HIGH;
+  return false;
+}
+
+/**
+ * Applies a min / max numeric domain to a whole range of numbers.
+ *
+ * The bounds and the bounding mode are looked up once, then the same
+ * operation is applied to every number, which lets the compiler vectorize
+ * the loop when the numbers are contiguous.
+ * get(element) returns a pointer to the number to bound, or nullptr to skip it.
+ * Numbers of another type than the domain are converted to the type of the
+ * domain and back when a bound applies, and left untouched otherwise.
+ *
+ * Returns false if the domain is a set of values, which is not handled here.
+ */
+template <typename T, typename Range, typename Get>
+bool bound_numeric_range(
+    const domain_base<T>& domain, bounding_mode b, Range&& range, Get get)
+{
+  if(!domain.values.empty())
+    return false;
+  if(!numeric_bound_applies(domain, b))
+    return true;
+
+  auto apply = [&](auto f) {
+    for(auto& elt : range)
+    {
+      if(auto v = get(elt))
+      {
+        using elt_type = std::remove_reference_t<decltype(*v)>;
+        *v = elt_type(f(T(*v)));
+      }
+    }
+  };
+
+  const bool has_min = bool(domain.min);
+  const bool has_max = bool(domain.max);
+  if(has_min && has_max)
+  {
+    const T min = *domain.min;
+    const T max = *domain.max;
+    switch(b)
+    {
+      case bounding_mode::CLIP:
+        apply([=](T v) { return T(ossia::clamp(v, min, max)); });
+        break;
+      case bounding_mode::WRAP:
+        apply([=](T v) { return T(ossia::wrap(v, min, max)); });
+        break;
+      case bounding_mode::FOLD:
+        apply([=](T v) { return T(ossia::fold(v, min, max)); });
+        break;
+      case bounding_mode::CLAMP_LOW:
+        apply([=](T v) { return T(ossia::max(v, min)); });
+        break;
+      case bounding_mode::CLAMP_HIGH:
+        apply([=](T v) { return T(ossia::min(v, max)); });
+        break;
+      default:
+        break;
+    }
+  }
+  else if(has_min)
+  {
+    const T min = *domain.min;
+    if(b == bounding_mode::CLIP || b == bounding_mode::CLAMP_LOW)
+      apply([=](T v) { return T(ossia::max(v, min)); });
+  }
+  else if(has_max)
+  {
+    const T max = *domain.max;
+    if(b == bounding_mode::CLIP || b == bounding_mode::CLAMP_HIGH)
+      apply([=](T v) { return T(ossia::min(v, max)); });
+  }
+
+  return true;
+}
 }
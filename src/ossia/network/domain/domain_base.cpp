@@ -243,6 +243,42 @@ value apply_domain(const domain& dom, bounding_mode b, ossia::value&& val)
   return std::move(val);
 }
 
+template <typename U>
+struct bulk_apply_domain_visitor
+{
+  bounding_mode b;
+  tcb::span<U> vals;
+
+  template <typename T>
+  bool operator()(const domain_base<T>& domain) const
+  {
+    if constexpr(std::is_same_v<T, float> || std::is_same_v<T, int32_t>)
+      return bound_numeric_range(domain, b, vals, [](U& v) { return &v; });
+    else
+      return false;
+  }
+
+  template <typename Domain>
+  bool operator()(const Domain&) const
+  {
+    return false;
+  }
+};
+
+bool apply_domain(const domain& dom, bounding_mode b, tcb::span<float> vals)
+{
+  if(bool(dom))
+    return ossia::apply_nonnull(bulk_apply_domain_visitor<float>{b, vals}, dom.v);
+  return true;
+}
+
+bool apply_domain(const domain& dom, bounding_mode b, tcb::span<int32_t> vals)
+{
+  if(bool(dom))
+    return ossia::apply_nonnull(bulk_apply_domain_visitor<int32_t>{b, vals}, dom.v);
+  return true;
+}
+
 domain init_domain(ossia::val_type type)
 {
   switch(type)
@@ -23,6 +23,20 @@ OSSIA_EXPORT value
 apply_domain(const domain& dom, bounding_mode b, const ossia::value& val);
 OSSIA_EXPORT value apply_domain(const domain& dom, bounding_mode b, ossia::value&& val);
 
+/**
+ * Applies a domain to an array of numbers, in place.
+ *
+ * The bounds and the bounding mode are looked up once for the whole array.
+ * The result is the same as applying the domain to each number separately.
+ *
+ * @return false if the domain cannot be applied to the numbers in bulk,
+ * e.g. if it is a set of values: the numbers are then left untouched.
+ */
+OSSIA_EXPORT bool
+apply_domain(const domain& dom, bounding_mode b, tcb::span<float> vals);
+OSSIA_EXPORT bool
+apply_domain(const domain& dom, bounding_mode b, tcb::span<int32_t> vals);
+
 OSSIA_EXPORT value get_min(const domain& dom);
 OSSIA_EXPORT value get_max(const domain& dom);
 OSSIA_EXPORT std::pair<std::optional<float>, std::optional<float>>
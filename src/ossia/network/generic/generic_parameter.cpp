@@ -114,9 +114,11 @@ ossia::value generic_parameter::set_value(const ossia::value& val)
     value_lock_t lock(m_valueMutex);
     if(m_value.v.which() == val.v.which())
     {
-      // TODO assess whether we would avoid an allocation on the return
-      // if doing copy = std::move(m_previousValue)
-      m_previousValue = std::move(m_value); // TODO also implement me for MIDI
+      // The value gets the storage of the value before the previous one, so that
+      // e.g. strings and lists of the same size are copied without allocating.
+      // Only the returned copy allocates: it is handed to the caller, e.g. to
+      // the protocol by push_value, so it cannot reuse a buffer of the parameter.
+      std::swap(m_previousValue, m_value); // TODO also implement me for MIDI
       m_value = val;
       copy = val;
     }
@@ -166,9 +168,11 @@ ossia::value generic_parameter::set_value_quiet(const ossia::value& val)
     value_lock_t lock(m_valueMutex);
     if(m_value.v.which() == val.v.which())
     {
-      // TODO assess whether we would avoid an allocation on the return
-      // if doing copy = std::move(m_previousValue)
-      m_previousValue = std::move(m_value); // TODO also implement me for MIDI
+      // The value gets the storage of the value before the previous one, so that
+      // e.g. strings and lists of the same size are copied without allocating.
+      // Only the returned copy allocates: it is handed to the caller, e.g. to
+      // the protocol by push_value, so it cannot reuse a buffer of the parameter.
+      std::swap(m_previousValue, m_value); // TODO also implement me for MIDI
       m_value = val;
       copy = val;
     }
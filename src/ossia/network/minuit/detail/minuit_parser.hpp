@@ -559,6 +559,9 @@ struct minuit_behavior<minuit_command::Answer, minuit_operation::Namespace>
       child_address += '/';
     const auto child_parameter_size = child_address.size();
 
+    // Create the children directly under their parent instead of looking
+    // the whole address up from the root for each of them
+    auto& parent = ossia::net::find_or_create_node(dev.get_root_node(), address);
     for(auto child : get_nodes(beg_it, end_it))
     {
       child_address.resize(child_parameter_size);
@@ -567,7 +570,7 @@ struct minuit_behavior<minuit_command::Answer, minuit_operation::Namespace>
       child_address.append(child.begin(), child.end());
 
       // Create the actual node
-      ossia::net::find_or_create_node(dev.get_root_node(), address);
+      ossia::net::find_or_create_node(parent, child);
 
       // request children
       proto.namespace_refresh(sub_request, child_address);
@@ -13,6 +13,8 @@
 
 #include <oscpack/osc/OscPrintReceivedElements.h>
 
+#include <algorithm>
+
 namespace ossia::net
 {
 
@@ -117,6 +119,25 @@ minuit_protocol& minuit_protocol::set_local_port(uint16_t out_port)
   return *this;
 }
 
+int minuit_protocol::get_request_window() const
+{
+  return m_requestWindow;
+}
+
+minuit_protocol& minuit_protocol::set_request_window(int window)
+{
+  lock_type lock(m_requestMutex);
+  m_requestWindow = std::max(window, 1);
+  return *this;
+}
+
+void minuit_protocol::set_progress_callback(
+    std::function<void(std::size_t, std::size_t)> cb)
+{
+  lock_type lock(m_requestMutex);
+  m_progressCallback = std::move(cb);
+}
+
 bool minuit_protocol::update(ossia::net::node_base& node)
 {
   // Reset node
@@ -124,8 +145,14 @@ bool minuit_protocol::update(ossia::net::node_base& node)
   node.remove_parameter();
 
   // Send "namespace" request
-  m_namespaceFinishedPromise = std::promise<void>{};
-  auto fut = m_namespaceFinishedPromise.get_future();
+  std::future<void> fut;
+  {
+    lock_type lock(m_requestMutex);
+    m_namespaceFinishedPromise = std::promise<void>{};
+    fut = m_namespaceFinishedPromise.get_future();
+    m_answered = 0;
+    m_exploring = true;
+  }
 
   auto act = name_table.get_action(ossia::minuit::minuit_action::NamespaceRequest);
   namespace_refresh(act, node.osc_address());
@@ -136,13 +163,7 @@ bool minuit_protocol::update(ossia::net::node_base& node)
   // If there are still un-explored nodes, we go for a second round
   if(status != std::future_status::ready)
   {
-    auto req = name_table.get_action(minuit::minuit_action::NamespaceRequest);
-    lock_type lock(m_nsRequestMutex);
-    for(const auto& addr : m_nsRequests)
-    {
-      m_sender->send(req, std::string_view(addr));
-    }
-    m_lastSentMessage = get_time();
+    resend_requests();
   }
   // While messages are being received regularly, we wait.
   m_lastRecvMessage = get_time();
@@ -158,15 +179,16 @@ bool minuit_protocol::update(ossia::net::node_base& node)
   }
 
   auto check_unfinished = [&] {
-    lock_type lock(m_nsRequestMutex);
-    lock_type lock2(m_getRequestMutex);
+    lock_type lock(m_requestMutex);
     return !m_nsRequests.empty() || !m_getRequests.empty()
            || status != std::future_status::ready;
   };
 
   if(check_unfinished())
   {
-    std::vector<std::string> nreq, greq;
+    // Answers may have been lost: send the requests again each time the
+    // remote device stops answering. The wait is bounded even if the device
+    // keeps sending other messages.
     for(int i = 0; i < 100; i++)
     {
       status = fut.wait_for(std::chrono::milliseconds(250));
@@ -174,58 +196,64 @@ bool minuit_protocol::update(ossia::net::node_base& node)
       {
         break;
       }
-      else
+      else if(m_lastRecvMessage == prev_t)
       {
-        {
-          lock_type lock(m_nsRequestMutex);
-          nreq.clear();
-          ossia::copy(m_nsRequests, nreq);
-        }
-        for(const auto& req : nreq)
-        {
-          m_sender->send(
-              name_table.get_action(ossia::minuit::minuit_action::NamespaceRequest),
-              std::string_view(req));
-          std::this_thread::sleep_for(std::chrono::milliseconds(1));
-        }
-
-        {
-          lock_type lock(m_getRequestMutex);
-          greq.clear();
-          for(const auto& req : m_getRequests)
-            greq.push_back(req.first);
-        }
-        for(const auto& req : greq)
-        {
-          m_sender->send(
-              name_table.get_action(ossia::minuit::minuit_action::GetRequest),
-              std::string_view(req));
-          std::this_thread::sleep_for(std::chrono::milliseconds(1));
-        }
+        resend_requests();
       }
+      prev_t = m_lastRecvMessage;
     }
   }
 
   {
-    lock_type lock(m_nsRequestMutex);
+    lock_type lock(m_requestMutex);
     for(const auto& node : m_nsRequests)
     {
-      logger().error("Namespace request unmatched: {0}", node);
+      logger().error("Namespace request unmatched: {0}", node.first);
     }
     m_nsRequests.clear();
-  }
-  {
-    lock_type lock(m_getRequestMutex);
+
     for(const auto& node : m_getRequests)
     {
       logger().error("Namespace request unmatched: {0}", node.first);
     }
     m_getRequests.clear();
+
+    m_queuedRequests.clear();
+    m_inFlight = 0;
+    m_exploring = false;
   }
 
   return status == std::future_status::ready || !node.children().empty();
 }
 
+void minuit_protocol::resend_requests()
+{
+  // Only the requests which were already sent are sent again,
+  // the queued ones will be sent as answers arrive.
+  std::vector<std::pair<std::string_view, std::string>> requests;
+  {
+    lock_type lock(m_requestMutex);
+    requests.reserve(m_inFlight);
+
+    auto ns = name_table.get_action(ossia::minuit::minuit_action::NamespaceRequest);
+    for(const auto& [addr, state] : m_nsRequests)
+      if(state != request_state::queued)
+        requests.emplace_back(ns, addr);
+
+    auto get = name_table.get_action(ossia::minuit::minuit_action::GetRequest);
+    for(const auto& [addr, req] : m_getRequests)
+      if(req.state != request_state::queued)
+        requests.emplace_back(get, addr);
+  }
+
+  for(const auto& [act, addr] : requests)
+  {
+    m_sender->send(act, std::string_view(addr));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  m_lastSentMessage = get_time();
+}
+
 void minuit_protocol::request(ossia::net::parameter_base& address)
 {
   auto act = name_table.get_action(ossia::minuit::minuit_action::GetRequest);
@@ -317,55 +345,120 @@ bool minuit_protocol::observe_quietly(ossia::net::parameter_base& address, bool
   return true;
 }
 
+bool minuit_protocol::can_send_request() const noexcept
+{
+  // Only the requests of update() are bounded: a get request sent
+  // outside of it must not wait for room in the window, nor take it.
+  return !m_exploring || m_inFlight < m_requestWindow;
+}
+
+minuit_protocol::request_state
+minuit_protocol::send_request(std::string_view req, std::string_view addr)
+{
+  m_sender->send(req, addr);
+  m_lastSentMessage = get_time();
+
+  if(!m_exploring)
+    return request_state::sent;
+  m_inFlight++;
+  return request_state::windowed;
+}
+
+void minuit_protocol::request_answered(request_state state)
+{
+  m_answered++;
+  if(state == request_state::windowed && m_inFlight > 0)
+    m_inFlight--;
+
+  // Fill the window again
+  while(m_inFlight < m_requestWindow && !m_queuedRequests.empty())
+  {
+    auto req = std::move(m_queuedRequests.front());
+    m_queuedRequests.pop_front();
+
+    if(req.get)
+    {
+      if(auto it = m_getRequests.find(req.address); it != m_getRequests.end())
+        it->second.state = send_request(req.request, req.address);
+    }
+    else
+    {
+      if(auto it = m_nsRequests.find(req.address); it != m_nsRequests.end())
+        it->second = send_request(req.request, req.address);
+    }
+  }
+
+  if(m_exploring)
+  {
+    const std::size_t remaining = m_nsRequests.size() + m_getRequests.size();
+    if(m_progressCallback)
+      m_progressCallback(m_answered, remaining);
+
+    if(remaining == 0)
+    {
+      m_exploring = false;
+      m_namespaceFinishedPromise.set_value();
+    }
+  }
+}
+
 void minuit_protocol::namespace_refresh(std::string_view req, const std::string& addr)
 {
-  lock_type lock(m_nsRequestMutex);
-  auto it = m_nsRequests.find(addr);
-  if(it == m_nsRequests.end())
+  lock_type lock(m_requestMutex);
+  auto [it, inserted] = m_nsRequests.insert({addr, request_state::queued});
+  if(inserted)
   {
-    m_nsRequests.insert(addr);
-    m_sender->send(req, std::string_view(addr));
-    m_lastSentMessage = get_time();
+    if(can_send_request())
+    {
+      it->second = send_request(req, addr);
+    }
+    else
+    {
+      m_queuedRequests.push_back({req, addr, false});
+    }
   }
 }
 
 void minuit_protocol::namespace_refreshed(std::string_view addr)
 {
-  lock_type lock(m_nsRequestMutex);
+  lock_type lock(m_requestMutex);
   auto it = m_nsRequests.find(addr);
   if(it != m_nsRequests.end())
   {
+    const auto state = it->second;
     m_nsRequests.erase(it);
-  }
-
-  if(m_nsRequests.empty())
-  {
-    m_namespaceFinishedPromise.set_value();
+    request_answered(state);
   }
 }
 
 void minuit_protocol::get_refresh(
     std::string_view req, const std::string& addr, std::promise<void>&& p)
 {
-  lock_type lock(m_getRequestMutex);
-  auto it = m_getRequests.find(addr);
-  if(it == m_getRequests.end())
+  lock_type lock(m_requestMutex);
+  auto [it, inserted] = m_getRequests.insert({addr, get_request{std::move(p)}});
+  if(inserted)
   {
-    m_getRequests[addr] = std::move(p);
-    m_sender->send(req, std::string_view(addr));
-
-    m_lastSentMessage = get_time();
+    if(can_send_request())
+    {
+      it->second.state = send_request(req, addr);
+    }
+    else
+    {
+      m_queuedRequests.push_back({req, addr, true});
+    }
   }
 }
 
 void minuit_protocol::get_refreshed(std::string_view addr)
 {
-  lock_type lock(m_getRequestMutex);
+  lock_type lock(m_requestMutex);
   auto it = m_getRequests.find(addr);
   if(it != m_getRequests.end())
   {
-    it->second.set_value();
+    it->second.promise.set_value();
+    const auto state = it->second.state;
     m_getRequests.erase(it);
+    request_answered(state);
   }
 }
 
@@ -8,6 +8,8 @@
 #include <ossia/network/zeroconf/zeroconf.hpp>
 
 #include <atomic>
+#include <deque>
+#include <functional>
 #include <future>
 #include <string>
 
@@ -55,6 +57,19 @@ public:
   uint16_t get_local_port() const;
   minuit_protocol& set_local_port(uint16_t);
 
+  static constexpr int default_request_window = 128;
+
+  //! Maximum number of namespace and get requests awaiting an answer
+  //! during update(): the others are sent as answers are received.
+  //! Requests made outside of update() are sent immediately.
+  int get_request_window() const;
+  minuit_protocol& set_request_window(int);
+
+  //! Called from the network thread during update(), with the number of
+  //! answers received and the number of requests not answered yet.
+  //! The callback must not call back into the protocol.
+  void set_progress_callback(std::function<void(std::size_t, std::size_t)>);
+
   bool update(ossia::net::node_base& node_base) override;
 
   bool pull(ossia::net::parameter_base& parameter_base) override;
@@ -84,6 +99,30 @@ private:
 
   void update_zeroconf();
 
+  //! windowed: sent during update(), and counted in the request window
+  enum class request_state : uint8_t
+  {
+    queued,
+    sent,
+    windowed
+  };
+  struct get_request
+  {
+    std::promise<void> promise;
+    request_state state{};
+  };
+  struct queued_request
+  {
+    std::string_view request;
+    std::string address;
+    bool get{};
+  };
+
+  bool can_send_request() const noexcept;
+  request_state send_request(std::string_view req, std::string_view addr);
+  void request_answered(request_state);
+  void resend_requests();
+
   std::string m_localName;
   std::string m_ip;
   uint16_t m_remotePort{}; /// the port that a remote device opens
@@ -95,11 +134,17 @@ private:
   std::promise<void> m_namespaceFinishedPromise;
   ossia::net::device_base* m_device{};
 
-  mutex_t m_nsRequestMutex;
-  ossia::hash_set<std::string> m_nsRequests;
-
-  mutex_t m_getRequestMutex;
-  ossia::string_map<std::promise<void>> m_getRequests;
+  // Requests waiting for an answer, whether they were already sent or are
+  // still queued because of the request window
+  mutex_t m_requestMutex;
+  ossia::string_map<request_state> m_nsRequests;
+  ossia::string_map<get_request> m_getRequests;
+  std::deque<queued_request> m_queuedRequests;
+  int m_inFlight{};
+  int m_requestWindow{default_request_window};
+  std::size_t m_answered{};
+  bool m_exploring{};
+  std::function<void(std::size_t, std::size_t)> m_progressCallback;
 
   std::unique_ptr<osc::sender<osc_1_0_outbound_stream_visitor>> m_sender;
   std::unique_ptr<osc::receiver> m_receiver;
@@ -6,6 +6,7 @@
 #include <ossia/network/osc/detail/osc_packet_processor.hpp>
 #include <ossia/network/osc/detail/osc_utils.hpp>
 #include <ossia/network/value/value.hpp>
+#include <ossia/network/value/value_array.hpp>
 
 #include <boost/endian/conversion.hpp>
 
@@ -14,6 +15,53 @@
 
 namespace ossia::net
 {
+//! Size of a message containing a top-level list of n floats and ints
+inline constexpr std::size_t
+numeric_list_message_size(std::string_view address_pattern, std::size_t n) noexcept
+{
+  return pattern_size(address_pattern.size()) + pattern_size(n + 1) + 4 * n;
+}
+
+/**
+ * @brief Writes a message for a list which only contains floats and ints.
+ *
+ * All the OSC policies write such lists as a flat sequence of f and i
+ * arguments: the message is written in a single pass, without going
+ * through oscpack and the per-element visitors.
+ * The buffer must have numeric_list_message_size bytes.
+ */
+inline std::size_t write_numeric_list_message(
+    std::string_view address_pattern, const std::vector<ossia::value>& v,
+    char* buffer) noexcept
+{
+  const std::size_t n = v.size();
+  std::size_t i = write_string(address_pattern, buffer);
+
+  char* tags = buffer + i;
+  const std::size_t tags_size = pattern_size(n + 1);
+  std::fill_n(tags + n + 1, tags_size - n - 1, '\0');
+  tags[0] = ',';
+
+  auto data = (unsigned char*)tags + tags_size;
+  for(std::size_t k = 0; k < n; k++)
+  {
+    if(auto f = v[k].target<float>())
+    {
+      tags[k + 1] = oscpack::FLOAT_TYPE_TAG;
+      boost::endian::endian_store<float, 4, boost::endian::order::big>(
+          data + 4 * k, *f);
+    }
+    else
+    {
+      tags[k + 1] = oscpack::INT32_TYPE_TAG;
+      boost::endian::endian_store<int32_t, 4, boost::endian::order::big>(
+          data + 4 * k, *v[k].target<int32_t>());
+    }
+  }
+
+  return i + tags_size + 4 * n;
+}
+
 template <typename Parameter, typename OscPolicy, typename Writer>
 #if __cpp_lib_concepts >= 201907L
   requires std::is_invocable_v<Writer, const char*, std::size_t>
@@ -120,6 +168,19 @@ struct osc_value_send_visitor
   try
   {
     auto& pool = buffer_pool::instance();
+    const auto ep = ossia::net::get_extended_type(parameter);
+    if((!ep || *ep != u8_blob_type()) && ossia::is_numeric_list(v))
+    {
+      const std::size_t sz = numeric_list_message_size(address_pattern, v.size());
+      if(sz < max_osc_message_size)
+      {
+        auto buf = pool.acquire(sz);
+        writer(buf.data(), write_numeric_list_message(address_pattern, v, buf.data()));
+        pool.release(std::move(buf));
+        return;
+      }
+    }
+
     auto buf = pool.acquire();
     while(buf.size() < max_osc_message_size)
     {
@@ -130,7 +191,7 @@ struct osc_value_send_visitor
         p << oscpack::BeginMessageN(address_pattern);
 
         bool ok = false;
-        if(auto ep = ossia::net::get_extended_type(parameter))
+        if(ep)
           ok = process_extended_array(*ep, p, v);
         if(!ok)
           dynamic_policy{{p, parameter.get_unit()}}(v);
@@ -222,6 +283,17 @@ struct osc_value_write_visitor
 
   void operator()(const std::vector<ossia::value>& v) const noexcept
   {
+    if(ossia::is_numeric_list(v))
+    {
+      const std::size_t sz = numeric_list_message_size(address_pattern, v.size());
+      if(sz < max_osc_message_size)
+      {
+        result.resize(sz);
+        result.resize(write_numeric_list_message(address_pattern, v, result.data()));
+        return;
+      }
+    }
+
     // OPTIMIZEME
     while(result.size() < max_osc_message_size)
     {
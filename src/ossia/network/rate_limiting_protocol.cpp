@@ -1,96 +1,231 @@
 // This is an open source non-commercial project. Dear PVS-Studio, please check
 // it. PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
 #include <ossia/detail/thread.hpp>
+#include <ossia/network/base/bundle.hpp>
+#include <ossia/network/base/node_attributes.hpp>
 #include <ossia/network/generic/generic_device.hpp>
 #include <ossia/network/generic/generic_parameter.hpp>
 #include <ossia/network/rate_limiting_protocol.hpp>
 
+#include <algorithm>
+#include <limits>
+
 #if defined(__cpp_exceptions)
 namespace ossia::net
 {
+//! Hashed timer wheel with a resolution of one millisecond
+struct rate_limiter_wheel
+{
+  using clock = rate_limiting_protocol::clock;
+  using slot = rate_limiting_protocol::slot;
+  static constexpr int64_t num_buckets = 256;
+  static constexpr int64_t no_tick = std::numeric_limits<int64_t>::max();
+
+  struct entry
+  {
+    slot* s{};
+    int64_t tick{};
+  };
+
+  static int64_t to_tick(clock::time_point t) noexcept
+  {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(t.time_since_epoch())
+        .count();
+  }
+
+  static clock::time_point to_time(int64_t tick) noexcept
+  {
+    return clock::time_point{std::chrono::milliseconds{tick}};
+  }
+
+  explicit rate_limiter_wheel(clock::time_point now)
+      : current_tick{to_tick(now)}
+  {
+    for(auto& b : buckets)
+      b.reserve(16);
+  }
+
+  void insert(slot* s, clock::time_point t)
+  {
+    const int64_t tick = std::max(to_tick(t), current_tick);
+    buckets[tick % num_buckets].push_back({s, tick});
+    next_tick = std::min(next_tick, tick);
+    count++;
+  }
+
+  // Calls f on every slot due at or before now and removes it from the wheel
+  template <typename F>
+  void advance(clock::time_point now, F&& f)
+  {
+    const int64_t now_tick = to_tick(now);
+    if(count > 0 && next_tick <= now_tick)
+    {
+      // Every bucket is visited at most once per call
+      const int64_t first = std::max(current_tick, now_tick - num_buckets + 1);
+      for(int64_t t = first; t <= now_tick; t++)
+      {
+        auto& bucket = buckets[t % num_buckets];
+        auto it = std::remove_if(bucket.begin(), bucket.end(), [&](const entry& e) {
+          if(e.tick > now_tick)
+            return false;
+          f(e.s);
+          return true;
+        });
+        count -= std::distance(it, bucket.end());
+        bucket.erase(it, bucket.end());
+      }
+
+      next_tick = no_tick;
+      if(count > 0)
+        next_tick = find_next_tick(now_tick + 1);
+    }
+    current_tick = std::max(current_tick, now_tick + 1);
+  }
+
+  // Looks for the first due entry in the next turn of the wheel, and only
+  // goes through all the entries if everything is due later than that
+  int64_t find_next_tick(int64_t from) const noexcept
+  {
+    for(int64_t t = from; t < from + num_buckets; t++)
+      for(auto& e : buckets[t % num_buckets])
+        if(e.tick == t)
+          return t;
+
+    int64_t res = no_tick;
+    for(auto& bucket : buckets)
+      for(auto& e : bucket)
+        res = std::min(res, e.tick);
+    return res;
+  }
+
+  void remove_dead_slots()
+  {
+    for(auto& bucket : buckets)
+    {
+      auto it = std::remove_if(
+          bucket.begin(), bucket.end(), [](const entry& e) { return e.s->removed; });
+      count -= std::distance(it, bucket.end());
+      bucket.erase(it, bucket.end());
+    }
+  }
+
+  std::array<std::vector<entry>, num_buckets> buckets;
+  int64_t current_tick{};
+  int64_t next_tick{no_tick};
+  std::size_t count{};
+};
+
 struct rate_limiter
 {
   rate_limiting_protocol& self;
+  using clock = rate_limiting_protocol::clock;
+  using slot = rate_limiting_protocol::slot;
+  using duration_t = rate_limiting_protocol::duration;
+
   void operator()() const noexcept
   {
     ossia::set_thread_name("ossia ratelim");
     using namespace std::literals;
-    using clock = rate_limiting_protocol::clock;
-    const auto duration = self.m_duration.load();
-    thread_local auto time_to_sleep = duration;
+
+    rate_limiter_wheel wheel{clock::now()};
+    std::vector<slot*> due;
+    std::vector<ossia::bundle_element> bundle;
+    due.reserve(4096);
+    bundle.reserve(4096);
+
+    auto min_period = self.m_duration.load();
     while(self.m_running)
     {
       try
       {
-        auto prev_time = clock::now();
-        if(time_to_sleep > 1ms)
-          std::this_thread::sleep_for(time_to_sleep);
+        auto now = clock::now();
 
-        // TODO find safe way to handle if a parameter is removed
-        // TODO instead we should do the value filtering in the parameter ...
-        // but still have to handle cases that can be optimized, such as midi
+        // Schedule the parameters which received a value
+        slot* incoming[256];
+        while(std::size_t n = self.m_scheduled.try_dequeue_bulk(incoming, 256))
         {
-          std::lock_guard lock{self.m_msgMutex};
-          std::swap(self.m_buffer, self.m_userMessages);
-        }
-
-        // Copy newest messages in local map
-        for(auto& msg : self.m_buffer)
-        {
-          if(msg.second.first.valid())
+          for(std::size_t i = 0; i < n; i++)
           {
-            self.m_threadMessages[msg.first] = std::move(msg.second);
-            msg.second.first = ossia::value{};
+            slot* s = incoming[i];
+            if(s->period != rate_limiting_protocol::duration{})
+              min_period = std::min(min_period, s->period);
+            wheel.insert(s, std::max(now, s->next_send));
           }
         }
 
-        // Push the actual messages
-        for(auto& v : self.m_threadMessages)
+        if(self.m_slotsRemoved.exchange(false))
         {
-          auto val = v.second.first;
-          if(val.valid())
+          write_lock_t lock{self.m_slotsMutex};
+          while(std::size_t n = self.m_scheduled.try_dequeue_bulk(incoming, 256))
           {
-            self.m_protocol->push(*v.first, v.second.first);
+            for(std::size_t i = 0; i < n; i++)
+              wheel.insert(incoming[i], std::max(now, incoming[i]->next_send));
           }
+          wheel.remove_dead_slots();
+          self.m_removedSlots.clear();
         }
 
-        // Clear both containers (while keeping memory allocated for sent
-        // messages so that it stays fast)
-        for(auto& v : self.m_buffer)
-        {
-          if(v.second.first.valid())
-          {
-            v.second.first = ossia::value{};
-          }
-        }
+        // Send everything that is due in a single bundle
+        due.clear();
+        wheel.advance(now, [&](slot* s) { due.push_back(s); });
+        if(!due.empty())
+          flush(due, bundle, now);
 
-        for(auto& v : self.m_threadMessages)
-        {
-          if(v.second.first.valid())
-          {
-            v.second.first = ossia::value{};
-          }
-        }
-        auto new_time = clock::now();
-        auto observed_duration = std::chrono::duration_cast<std::chrono::milliseconds>(
-            new_time - prev_time);
-        if(observed_duration > duration)
-        {
-          if(observed_duration >= 2 * duration)
-            time_to_sleep = 0ms;
-          else
-            time_to_sleep = 2 * duration - observed_duration;
-        }
-        else
-        {
-          time_to_sleep = duration;
-        }
+        // Sleep until the next parameter is due
+        const auto default_duration = self.m_duration.load();
+        min_period = std::min(min_period, default_duration);
+        auto next_time = clock::now() + std::max(min_period, duration_t{1ms});
+        if(wheel.next_tick != rate_limiter_wheel::no_tick)
+          next_time = std::min(next_time, rate_limiter_wheel::to_time(wheel.next_tick));
+        std::this_thread::sleep_until(next_time);
       }
       catch(...)
       {
       }
     }
   }
+
+  void flush(
+      const std::vector<slot*>& due, std::vector<ossia::bundle_element>& bundle,
+      clock::time_point now) const
+  {
+    read_lock_t lock{self.m_slotsMutex};
+    const auto default_duration = self.m_duration.load();
+    for(slot* s : due)
+    {
+      if(s->removed)
+        continue;
+
+      ossia::value v;
+      {
+        std::lock_guard l{s->value_mutex};
+        v = std::move(s->value);
+        s->value = ossia::value{};
+        s->scheduled = false;
+      }
+
+      s->next_send
+          = now + (s->period != duration_t{} ? s->period : default_duration);
+      if(v.valid())
+        bundle.push_back({s->parameter, std::move(v)});
+    }
+
+    // The default protocol_base::push_bundle goes through the parameters,
+    // which would call their callbacks from this thread
+    auto& proto = *self.m_protocol;
+    if(bundle.size() > 1 && proto.test_flag(protocol_base::SupportsBundles))
+    {
+      proto.push_bundle(bundle);
+    }
+    else
+    {
+      for(auto& [param, value] : bundle)
+        proto.push(*param, value);
+    }
+
+    // Keep the memory allocated so that it stays fast
+    bundle.clear();
+  }
 };
 
 rate_limiting_protocol::rate_limiting_protocol(
@@ -98,12 +233,9 @@ rate_limiting_protocol::rate_limiting_protocol(
     : protocol_base{flags{SupportsMultiplex}}
     , m_duration{d}
     , m_protocol{std::move(arg)}
-
+    , m_scheduled{4096}
 {
-  m_userMessages.reserve(4096);
-  m_buffer.reserve(4096);
-  m_threadMessages.reserve(4096);
-  m_lastTime = clock::now();
+  m_slots.reserve(4096);
   m_thread = std::thread{rate_limiter{*this}};
 }
 
@@ -111,6 +243,10 @@ rate_limiting_protocol::~rate_limiting_protocol()
 {
   m_running = false;
   m_thread.join();
+
+  if(m_device)
+    m_device->on_parameter_removing
+        .disconnect<&rate_limiting_protocol::parameter_removed>(this);
 }
 
 void rate_limiting_protocol::set_duration(rate_limiting_protocol::duration d)
@@ -118,6 +254,42 @@ void rate_limiting_protocol::set_duration(rate_limiting_protocol::duration d)
   m_duration = d;
 }
 
+std::unique_ptr<rate_limiting_protocol::slot>
+rate_limiting_protocol::make_slot(const ossia::net::parameter_base& p)
+{
+  auto s = std::make_unique<slot>();
+  s->parameter = const_cast<ossia::net::parameter_base*>(&p);
+  if(auto rate = ossia::net::get_refresh_rate(p.get_node()); rate && *rate > 0)
+    s->period = std::chrono::milliseconds{*rate};
+  return s;
+}
+
+void rate_limiting_protocol::push_to_slot(slot& s, const ossia::value& v)
+{
+  bool schedule{};
+  {
+    std::lock_guard lock{s.value_mutex};
+    s.value = v;
+    schedule = !s.scheduled;
+    s.scheduled = true;
+  }
+
+  if(schedule)
+    m_scheduled.enqueue(&s);
+}
+
+void rate_limiting_protocol::parameter_removed(const ossia::net::parameter_base& p)
+{
+  write_lock_t lock{m_slotsMutex};
+  if(auto it = m_slots.find(&p); it != m_slots.end())
+  {
+    it->second->removed = true;
+    m_removedSlots.push_back(std::move(it->second));
+    m_slots.erase(it);
+    m_slotsRemoved = true;
+  }
+}
+
 bool rate_limiting_protocol::pull(ossia::net::parameter_base& address)
 {
   return m_protocol->pull(address);
@@ -126,8 +298,24 @@ bool rate_limiting_protocol::pull(ossia::net::parameter_base& address)
 bool rate_limiting_protocol::push(
     const ossia::net::parameter_base& address, const ossia::value& v)
 {
-  std::lock_guard lock{m_msgMutex};
-  m_userMessages[&address] = {v, {}};
+  if(address.get_critical())
+    return m_protocol->push(address, v);
+
+  // The slots lock is held until the slot is enqueued: the rate limiting
+  // thread frees the removed slots under the write lock.
+  {
+    read_lock_t lock{m_slotsMutex};
+    if(auto it = m_slots.find(&address); it != m_slots.end())
+    {
+      push_to_slot(*it->second, v);
+      return true;
+    }
+  }
+
+  auto s = make_slot(address);
+  write_lock_t lock{m_slotsMutex};
+  auto it = m_slots.try_emplace(&address, std::move(s)).first;
+  push_to_slot(*it->second, v);
   return true;
 }
 
@@ -163,7 +351,13 @@ void rate_limiting_protocol::stop()
 
 void rate_limiting_protocol::set_device(device_base& dev)
 {
+  if(m_device)
+    m_device->on_parameter_removing
+        .disconnect<&rate_limiting_protocol::parameter_removed>(this);
+
   m_device = &dev;
+  m_device->on_parameter_removing.connect<&rate_limiting_protocol::parameter_removed>(
+      this);
   m_protocol->set_device(dev);
 }
 
@@ -1,19 +1,34 @@
 #pragma once
-#include <ossia/detail/algorithms.hpp>
-#include <ossia/detail/flat_map.hpp>
-#include <ossia/network/base/message_queue.hpp>
+#include <ossia/detail/audio_spin_mutex.hpp>
+#include <ossia/detail/hash_map.hpp>
+#include <ossia/detail/lockfree_queue.hpp>
+#include <ossia/detail/mutex.hpp>
 #include <ossia/network/base/parameter_data.hpp>
 #include <ossia/network/base/protocol.hpp>
+#include <ossia/network/value/value.hpp>
 
-#include <readerwriterqueue.h>
-
+#include <atomic>
 #include <chrono>
+#include <memory>
 #include <thread>
 #include <vector>
 
 namespace ossia::net
 {
 struct rate_limiter;
+struct rate_limiter_wheel;
+
+/**
+ * @brief Limits the rate at which values are sent by another protocol
+ *
+ * Only the last value pushed to a parameter during a period is sent.
+ * The period is the one given to the constructor, unless the parameter's node
+ * has a refresh_rate attribute (in milliseconds) when it is first pushed.
+ *
+ * All the values due at a given time are sent as one bundle
+ * if the wrapped protocol supports it, else one by one.
+ * Critical parameters are not rate-limited.
+ */
 class OSSIA_EXPORT rate_limiting_protocol final : public ossia::net::protocol_base
 {
 public:
@@ -46,21 +61,41 @@ private:
   rate_limiting_protocol& operator=(rate_limiting_protocol&&) = delete;
 
   friend struct rate_limiter;
+  friend struct rate_limiter_wheel;
 
   std::atomic<duration> m_duration{};
   std::unique_ptr<ossia::net::protocol_base> m_protocol;
   ossia::net::device_base* m_device{};
 
+  // Last value pushed to a parameter which has not been sent yet
+  struct slot
+  {
+    ossia::net::parameter_base* parameter{};
+    duration period{}; // Zero if the protocol's duration is used
+
+    ossia::audio_spin_mutex value_mutex;
+    ossia::value value TS_GUARDED_BY(value_mutex);
+
+    bool scheduled TS_GUARDED_BY(value_mutex){};
+    bool removed{};
+
+    // Only accessed from the rate limiting thread
+    clock::time_point next_send{};
+  };
+
+  static std::unique_ptr<slot> make_slot(const ossia::net::parameter_base& p);
+  void push_to_slot(slot& s, const ossia::value& v);
+
   std::atomic_bool m_running{true};
   std::thread m_thread;
 
-  clock::time_point m_lastTime;
-  using map_t = ossia::flat_map<
-      const ossia::net::parameter_base*, std::pair<ossia::value, clock::time_point>>;
-  map_t m_userMessages;
-  map_t m_buffer;
-  map_t m_threadMessages;
-  std::mutex m_msgMutex;
+  ossia::hash_map<const ossia::net::parameter_base*, std::unique_ptr<slot>> m_slots;
+  std::vector<std::unique_ptr<slot>> m_removedSlots;
+  ossia::shared_mutex_t m_slotsMutex;
+  std::atomic_bool m_slotsRemoved{};
+
+  // Slots which received a new value since their last send
+  moodycamel::ConcurrentQueue<slot*> m_scheduled;
 };
 
 template <typename Protocol, typename... Args>
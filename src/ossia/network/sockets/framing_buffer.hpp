@@ -0,0 +1,74 @@
+#pragma once
+#include <ossia/detail/pod_vector.hpp>
+
+#include <boost/asio/buffer.hpp>
+
+#include <cstring>
+
+namespace ossia::net
+{
+
+/**
+ * @brief Receive buffer shared by the stream decoders.
+ *
+ * Bytes are read in large chunks at the end of the buffer, and complete
+ * frames are parsed from the beginning. Unparsed leftovers are moved back to
+ * the front only when space runs out, so that every frame handed to
+ * the message handler is a contiguous, zero-copy view into the buffer.
+ */
+struct framing_buffer
+{
+  static constexpr std::size_t default_read_size = 65536;
+
+  framing_buffer() { m_data.resize(default_read_size); }
+
+  //! Beginning of the unparsed bytes
+  const char* data() const noexcept { return m_data.data() + m_begin; }
+
+  //! Number of unparsed bytes
+  std::size_t size() const noexcept { return m_end - m_begin; }
+
+  //! Returns a writable area of at least min_size bytes after the unparsed ones
+  boost::asio::mutable_buffer prepare(std::size_t min_size = default_read_size)
+  {
+    if(m_begin == m_end)
+    {
+      m_begin = 0;
+      m_end = 0;
+    }
+
+    if(m_data.size() - m_end < min_size)
+    {
+      // Move the leftovers back to the front
+      const std::size_t remaining = size();
+      if(m_begin > 0 && remaining > 0)
+        std::memmove(m_data.data(), m_data.data() + m_begin, remaining);
+      m_begin = 0;
+      m_end = remaining;
+
+      if(m_data.size() - m_end < min_size)
+        m_data.resize(m_end + min_size);
+    }
+
+    return boost::asio::mutable_buffer(m_data.data() + m_end, m_data.size() - m_end);
+  }
+
+  //! Marks sz bytes of the area returned by prepare() as received
+  void commit(std::size_t sz) noexcept { m_end += sz; }
+
+  //! Marks sz bytes as parsed
+  void consume(std::size_t sz) noexcept { m_begin += sz; }
+
+  void clear() noexcept
+  {
+    m_begin = 0;
+    m_end = 0;
+  }
+
+private:
+  ossia::pod_vector<char> m_data;
+  std::size_t m_begin{};
+  std::size_t m_end{};
+};
+
+}
@@ -1,15 +1,17 @@
 #pragma once
-#include <ossia/detail/pod_vector.hpp>
+#include <ossia/network/sockets/framing_buffer.hpp>
 #include <ossia/network/sockets/writers.hpp>
 
 #include <boost/asio/buffer.hpp>
 #include <boost/asio/error.hpp>
 #include <boost/asio/read.hpp>
-#include <boost/asio/read_until.hpp>
 #include <boost/asio/streambuf.hpp>
 #include <boost/asio/write.hpp>
 #include <boost/endian/conversion.hpp>
 
+#include <cstring>
+#include <string_view>
+
 namespace ossia::net
 {
 
@@ -18,54 +20,60 @@ struct line_framing_decoder
 {
   Socket& socket;
   char delimiter[8] = {0};
-  int32_t m_next_packet_size{};
-  std::vector<char, ossia::pod_allocator_avx2<char>> m_data;
+  framing_buffer m_data;
 
   explicit line_framing_decoder(Socket& socket)
       : socket{socket}
   {
-    m_data.reserve(65535);
   }
 
   template <typename F>
   void receive(F f)
   {
-    m_data.clear();
-
-    // Receive the size prefix
-    boost::asio::async_read_until(
-        socket, boost::asio::dynamic_buffer(m_data), (const char*)delimiter,
+    socket.async_read_some(
+        m_data.prepare(),
         [this, f = std::move(f)](boost::system::error_code ec, std::size_t sz) mutable {
+      if(!f.validate_stream(ec))
+        return;
       if(ec.failed())
         return;
 
-      int new_sz = sz;
-      new_sz -= strlen(delimiter);
-      if(new_sz > 0)
-        read_data(std::move(f), ec, new_sz);
-      else
-        this->receive(std::move(f));
+      m_data.commit(sz);
+      read_lines(f);
+
+      this->receive(std::move(f));
         });
   }
 
   template <typename F>
-  void read_data(F&& f, boost::system::error_code ec, std::size_t sz)
+  void read_lines(const F& f)
   {
-    if(!f.validate_stream(ec))
+    const std::string_view delim{delimiter, strnlen(delimiter, sizeof(delimiter))};
+    if(delim.empty())
+    {
+      m_data.clear();
       return;
+    }
 
-    if(!ec && sz > 0)
+    // Process every complete line present in the buffer
+    std::string_view buf{m_data.data(), m_data.size()};
+    std::size_t pos{};
+    while((pos = buf.find(delim)) != std::string_view::npos)
     {
-      try
-      {
-        f((const unsigned char*)m_data.data(), sz);
-      }
-      catch(...)
+      if(pos > 0)
       {
+        try
+        {
+          f((const unsigned char*)buf.data(), pos);
+        }
+        catch(...)
+        {
+        }
       }
-    }
 
-    this->receive(std::move(f));
+      m_data.consume(pos + delim.size());
+      buf.remove_prefix(pos + delim.size());
+    }
   }
 };
 
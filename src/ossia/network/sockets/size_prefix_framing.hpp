@@ -1,5 +1,5 @@
 #pragma once
-#include <ossia/detail/pod_vector.hpp>
+#include <ossia/network/sockets/framing_buffer.hpp>
 #include <ossia/network/sockets/writers.hpp>
 
 #include <boost/asio/buffer.hpp>
@@ -9,6 +9,9 @@
 #include <boost/asio/write.hpp>
 #include <boost/endian/conversion.hpp>
 
+#include <algorithm>
+#include <cstring>
+
 namespace ossia::net
 {
 
@@ -16,63 +19,71 @@ template <typename Socket>
 struct size_prefix_decoder
 {
   Socket& socket;
-  int32_t m_next_packet_size{};
-  ossia::pod_vector<char> m_data;
+  framing_buffer m_data;
+  std::size_t m_next_read_size{framing_buffer::default_read_size};
 
   explicit size_prefix_decoder(Socket& socket)
       : socket{socket}
   {
-    m_data.reserve(65535);
   }
 
   template <typename F>
   void receive(F f)
   {
-    // Receive the size prefix
+    // Read as much as is available: a single read may contain many messages
     socket.async_read_some(
-        boost::asio::mutable_buffer(&m_next_packet_size, sizeof(int32_t)),
+        m_data.prepare(m_next_read_size),
         [this, f = std::move(f)](boost::system::error_code ec, std::size_t sz) mutable {
-      read_size(std::move(f), ec, sz);
-        });
-  }
+      if(!f.validate_stream(ec))
+        return;
+      if(ec)
+        return;
 
-  template <typename F>
-  void read_size(F&& f, boost::system::error_code ec, std::size_t sz)
-  {
-    if(!f.validate_stream(ec))
-      return;
-
-    boost::endian::big_to_native_inplace(m_next_packet_size);
-    if(m_next_packet_size <= 0)
-      return;
+      m_data.commit(sz);
+      if(!read_frames(f))
+        return;
 
-    m_data.resize(m_next_packet_size);
-    boost::asio::async_read(
-        socket, boost::asio::mutable_buffer(m_data.data(), m_next_packet_size),
-        boost::asio::transfer_exactly(m_next_packet_size),
-        [this, f = std::move(f)](boost::system::error_code ec, std::size_t sz) mutable {
-      read_data(std::move(f), ec, sz);
+      this->receive(std::move(f));
         });
   }
 
   template <typename F>
-  void read_data(F&& f, boost::system::error_code ec, std::size_t sz)
+  bool read_frames(const F& f)
   {
-    if(!f.validate_stream(ec))
-      return;
-
-    if(!ec && sz > 0)
+    m_next_read_size = framing_buffer::default_read_size;
+    while(m_data.size() >= sizeof(int32_t))
     {
-      try
+      int32_t packet_size{};
+      std::memcpy(&packet_size, m_data.data(), sizeof(int32_t));
+      boost::endian::big_to_native_inplace(packet_size);
+
+      // Invalid stream
+      if(packet_size < 0)
+        return false;
+
+      const std::size_t frame_size = sizeof(int32_t) + packet_size;
+      if(m_data.size() < frame_size)
       {
-        f((const unsigned char*)m_data.data(), sz);
+        // Make sure the next read has room for the whole message
+        m_next_read_size
+            = std::max(m_next_read_size, frame_size - m_data.size());
+        break;
       }
-      catch(...)
+
+      if(packet_size > 0)
       {
+        try
+        {
+          f((const unsigned char*)m_data.data() + sizeof(int32_t), packet_size);
+        }
+        catch(...)
+        {
+        }
       }
-    }
 
-    this->receive(std::move(f));
+      m_data.consume(frame_size);
+    }
+    return true;
   }
 };
 
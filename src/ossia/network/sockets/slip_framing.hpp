@@ -1,5 +1,6 @@
 #pragma once
 #include <ossia/detail/pod_vector.hpp>
+#include <ossia/network/sockets/framing_buffer.hpp>
 #include <ossia/network/sockets/writers.hpp>
 
 #include <boost/asio/error.hpp>
@@ -21,7 +22,7 @@ template <typename Socket>
 struct slip_decoder
 {
   Socket& socket;
-  boost::asio::streambuf m_data;
+  framing_buffer m_data;
   ossia::pod_vector<char> m_decoded;
   enum
   {
@@ -39,13 +40,14 @@ struct slip_decoder
   void receive(F f)
   {
     socket.async_read_some(
-        boost::asio::mutable_buffer(m_data.prepare(1024)),
+        m_data.prepare(),
         [this, f = std::move(f)](boost::system::error_code ec, std::size_t sz) mutable {
       if(!f.validate_stream(ec))
         return;
 
       if(sz > 0)
       {
+        m_data.commit(sz);
         process_bytes(f, sz);
       }
 
@@ -56,11 +58,39 @@ struct slip_decoder
   template <typename F>
   void process_bytes(const F& f, std::size_t sz)
   {
-    auto begin = (const uint8_t*)m_data.data().data();
-    for(std::size_t i = 0; i < sz; i++)
+    auto begin = (const uint8_t*)m_data.data();
+    auto end = begin + sz;
+    while(begin != end)
     {
-      const uint8_t next_char = *begin;
-      process_byte(f, next_char);
+      if(m_status == reading_char)
+      {
+        // Look for the next special character: everything before it
+        // is part of the message
+        auto run_end = begin;
+        while(run_end != end && *run_end != slip::eot && *run_end != slip::esc)
+          ++run_end;
+
+        if(run_end == end)
+        {
+          m_decoded.insert(m_decoded.end(), begin, end);
+          break;
+        }
+
+        if(*run_end == slip::eot && m_decoded.empty())
+        {
+          // The whole message is in the receive buffer, no need to copy it
+          if(run_end != begin)
+            f(begin, run_end - begin);
+          m_status = waiting;
+          begin = run_end + 1;
+          continue;
+        }
+
+        m_decoded.insert(m_decoded.end(), begin, run_end);
+        begin = run_end;
+      }
+
+      process_byte(f, *begin);
       ++begin;
     }
     m_data.consume(sz);
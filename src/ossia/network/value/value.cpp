@@ -14,6 +14,7 @@
 #endif
 #include <ossia/network/value/value.hpp>
 #include <ossia/network/value/value_algorithms.hpp>
+#include <ossia/network/value/value_array.hpp>
 #include <ossia/network/value/value_comparison.hpp>
 #include <ossia/network/value/value_traits.hpp>
 
@@ -686,6 +687,76 @@ void convert_inplace(ossia::value& val, ossia::val_type newtype)
   }
 }
 
+static bool is_number(const ossia::value& v) noexcept
+{
+  const auto t = v.get_type();
+  return t == ossia::val_type::FLOAT || t == ossia::val_type::INT;
+}
+
+bool is_numeric_list(const std::vector<ossia::value>& list) noexcept
+{
+  return !list.empty() && ossia::all_of(list, is_number);
+}
+
+template <typename T>
+static bool
+to_numeric_array_impl(const std::vector<ossia::value>& list, std::vector<T>& out)
+{
+  if(!ossia::all_of(list, is_number))
+    return false;
+
+  const std::size_t n = list.size();
+  out.resize(n);
+  for(std::size_t i = 0; i < n; i++)
+  {
+    if(auto f = list[i].target<float>())
+      out[i] = T(*f);
+    else
+      out[i] = T(*list[i].target<int32_t>());
+  }
+  return true;
+}
+
+bool to_numeric_array(const std::vector<ossia::value>& list, std::vector<float>& out)
+{
+  return to_numeric_array_impl(list, out);
+}
+
+bool to_numeric_array(const std::vector<ossia::value>& list, std::vector<double>& out)
+{
+  return to_numeric_array_impl(list, out);
+}
+
+bool to_numeric_array(const std::vector<ossia::value>& list, std::vector<int32_t>& out)
+{
+  return to_numeric_array_impl(list, out);
+}
+
+template <typename Stored, typename T>
+static std::vector<ossia::value> make_numeric_list_impl(tcb::span<const T> arr)
+{
+  std::vector<ossia::value> res;
+  res.reserve(arr.size());
+  for(T v : arr)
+    res.emplace_back(Stored(v));
+  return res;
+}
+
+std::vector<ossia::value> make_numeric_list(tcb::span<const float> arr)
+{
+  return make_numeric_list_impl<float>(arr);
+}
+
+std::vector<ossia::value> make_numeric_list(tcb::span<const double> arr)
+{
+  return make_numeric_list_impl<float>(arr);
+}
+
+std::vector<ossia::value> make_numeric_list(tcb::span<const int32_t> arr)
+{
+  return make_numeric_list_impl<int32_t>(arr);
+}
+
 void convert_inplace(ossia::value& val, const ossia::value& cur);
 value::~value() noexcept = default;
 }
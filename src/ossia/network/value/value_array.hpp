@@ -0,0 +1,41 @@
+#pragma once
+#include <ossia/detail/config.hpp>
+
+#include <ossia/detail/span.hpp>
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * \file value_array.hpp
+ *
+ * Lists are stored in ossia::value as std::vector<ossia::value>, where each
+ * element carries its own type. Code which handles large numeric lists,
+ * e.g. spectrums or DMX universes, can instead work on contiguous arrays of
+ * numbers and only convert from and to the generic list form when needed.
+ */
+namespace ossia
+{
+class value;
+
+//! True if the list is not empty and only contains floats and ints.
+OSSIA_EXPORT bool is_numeric_list(const std::vector<ossia::value>& list) noexcept;
+
+/**
+ * @brief Copies the numbers of a list to a contiguous array.
+ * @return false if an element is neither a float nor an int,
+ * in which case out is left unchanged.
+ */
+OSSIA_EXPORT bool
+to_numeric_array(const std::vector<ossia::value>& list, std::vector<float>& out);
+OSSIA_EXPORT bool
+to_numeric_array(const std::vector<ossia::value>& list, std::vector<double>& out);
+OSSIA_EXPORT bool
+to_numeric_array(const std::vector<ossia::value>& list, std::vector<int32_t>& out);
+
+//! Makes a list of floats, or of ints, from a contiguous array.
+//! Doubles are stored as floats.
+OSSIA_EXPORT std::vector<ossia::value> make_numeric_list(tcb::span<const float> arr);
+OSSIA_EXPORT std::vector<ossia::value> make_numeric_list(tcb::span<const double> arr);
+OSSIA_EXPORT std::vector<ossia::value> make_numeric_list(tcb::span<const int32_t> arr);
+}
@@ -0,0 +1,522 @@
+#include "mqtt_codec.hpp"
+
+#include <ossia/network/value/value_conversion.hpp>
+
+#include <boost/endian/conversion.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace ossia::net
+{
+namespace
+{
+template <typename T>
+void write_little(std::string& out, T v)
+{
+  boost::endian::native_to_little_inplace(v);
+  out.append(reinterpret_cast<const char*>(&v), sizeof(T));
+}
+
+template <typename T>
+T read_little(const char* data)
+{
+  T v;
+  std::memcpy(&v, data, sizeof(T));
+  boost::endian::little_to_native_inplace(v);
+  return v;
+}
+
+void write_little_float(std::string& out, float f)
+{
+  write_little(out, std::bit_cast<uint32_t>(f));
+}
+
+float read_little_float(const char* data)
+{
+  return std::bit_cast<float>(read_little<uint32_t>(data));
+}
+
+template <typename T>
+void write_big(std::string& out, T v)
+{
+  boost::endian::native_to_big_inplace(v);
+  out.append(reinterpret_cast<const char*>(&v), sizeof(T));
+}
+
+template <typename T>
+T read_big(const char* data)
+{
+  T v;
+  std::memcpy(&v, data, sizeof(T));
+  boost::endian::big_to_native_inplace(v);
+  return v;
+}
+
+/// CBOR ///
+namespace cbor
+{
+enum major : uint8_t
+{
+  unsigned_int = 0,
+  negative_int = 1,
+  byte_string = 2,
+  text_string = 3,
+  array = 4,
+  map = 5,
+  tag = 6,
+  simple = 7
+};
+static constexpr uint8_t false_value = 0xf4;
+static constexpr uint8_t true_value = 0xf5;
+static constexpr uint8_t null_value = 0xf6;
+static constexpr uint8_t undefined_value = 0xf7;
+static constexpr uint8_t half_float = 0xf9;
+static constexpr uint8_t single_float = 0xfa;
+static constexpr uint8_t double_float = 0xfb;
+static constexpr uint8_t indefinite = 31;
+static constexpr uint8_t break_code = 0xff;
+
+void write_head(std::string& out, major m, uint64_t n)
+{
+  const uint8_t mt = m << 5;
+  if(n < 24)
+  {
+    out.push_back(char(mt | n));
+  }
+  else if(n <= 0xff)
+  {
+    out.push_back(char(mt | 24));
+    out.push_back(char(n));
+  }
+  else if(n <= 0xffff)
+  {
+    out.push_back(char(mt | 25));
+    write_big(out, uint16_t(n));
+  }
+  else if(n <= 0xffffffff)
+  {
+    out.push_back(char(mt | 26));
+    write_big(out, uint32_t(n));
+  }
+  else
+  {
+    out.push_back(char(mt | 27));
+    write_big(out, uint64_t(n));
+  }
+}
+
+struct encoder
+{
+  std::string& out;
+
+  void operator()() const { out.push_back(char(null_value)); }
+  void operator()(ossia::impulse) const { out.push_back(char(null_value)); }
+  void operator()(int v) const
+  {
+    if(v >= 0)
+      write_head(out, unsigned_int, uint64_t(v));
+    else
+      write_head(out, negative_int, uint64_t(-(int64_t(v) + 1)));
+  }
+  void operator()(float v) const
+  {
+    out.push_back(char(single_float));
+    write_big(out, std::bit_cast<uint32_t>(v));
+  }
+  void operator()(bool v) const { out.push_back(char(v ? true_value : false_value)); }
+  void operator()(const std::string& v) const
+  {
+    write_head(out, text_string, v.size());
+    out.append(v);
+  }
+  template <std::size_t N>
+  void operator()(const std::array<float, N>& v) const
+  {
+    write_head(out, array, N);
+    for(float f : v)
+      (*this)(f);
+  }
+  void operator()(const std::vector<ossia::value>& v) const
+  {
+    write_head(out, array, v.size());
+    for(const auto& e : v)
+      e.apply(*this);
+  }
+  void operator()(const ossia::value_map_type& v) const
+  {
+    write_head(out, map, v.size());
+    for(const auto& [k, e] : v)
+    {
+      (*this)(k);
+      e.apply(*this);
+    }
+  }
+};
+
+float half_to_float(uint16_t h)
+{
+  const uint32_t sign = uint32_t(h & 0x8000) << 16;
+  const int exp = (h >> 10) & 0x1f;
+  const uint32_t mant = h & 0x3ff;
+  if(exp == 0)
+  {
+    // Subnormal or zero
+    const float f = std::ldexp(float(mant), -24);
+    return sign ? -f : f;
+  }
+  else if(exp == 31)
+  {
+    return std::bit_cast<float>(sign | 0x7f800000 | (mant << 13));
+  }
+  return std::bit_cast<float>(sign | uint32_t(exp + 112) << 23 | (mant << 13));
+}
+
+struct decoder
+{
+  const char* cur{};
+  const char* end{};
+  int depth{};
+
+  static constexpr int max_depth = 64;
+
+  bool has(std::size_t n) const noexcept { return std::size_t(end - cur) >= n; }
+
+  bool read_argument(uint8_t info, uint64_t& n)
+  {
+    if(info < 24)
+    {
+      n = info;
+      return true;
+    }
+    switch(info)
+    {
+      case 24:
+        if(!has(1))
+          return false;
+        n = uint8_t(*cur);
+        cur += 1;
+        return true;
+      case 25:
+        if(!has(2))
+          return false;
+        n = read_big<uint16_t>(cur);
+        cur += 2;
+        return true;
+      case 26:
+        if(!has(4))
+          return false;
+        n = read_big<uint32_t>(cur);
+        cur += 4;
+        return true;
+      case 27:
+        if(!has(8))
+          return false;
+        n = read_big<uint64_t>(cur);
+        cur += 8;
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  bool at_break() const noexcept { return cur != end && uint8_t(*cur) == break_code; }
+
+  bool read_string(uint8_t info, major m, std::string& str)
+  {
+    if(info == indefinite)
+    {
+      // Concatenation of definite-length chunks
+      while(!at_break())
+      {
+        if(!has(1) || uint8_t(*cur) >> 5 != m)
+          return false;
+        const uint8_t chunk_info = uint8_t(*cur++) & 0x1f;
+        if(chunk_info == indefinite || !read_string(chunk_info, m, str))
+          return false;
+      }
+      ++cur;
+      return true;
+    }
+
+    uint64_t n{};
+    if(!read_argument(info, n) || !has(n))
+      return false;
+    str.append(cur, n);
+    cur += n;
+    return true;
+  }
+
+  bool read(ossia::value& res)
+  {
+    if(!has(1) || depth > max_depth)
+      return false;
+
+    const uint8_t initial = uint8_t(*cur++);
+    const auto m = major(initial >> 5);
+    const uint8_t info = initial & 0x1f;
+    switch(m)
+    {
+      case unsigned_int: {
+        uint64_t n{};
+        if(!read_argument(info, n))
+          return false;
+        res = int(std::min(n, uint64_t(std::numeric_limits<int>::max())));
+        return true;
+      }
+      case negative_int: {
+        uint64_t n{};
+        if(!read_argument(info, n))
+          return false;
+        res = int(-1 - int64_t(std::min(n, uint64_t(std::numeric_limits<int>::max()))));
+        return true;
+      }
+      case byte_string:
+      case text_string: {
+        std::string str;
+        if(!read_string(info, m, str))
+          return false;
+        res = std::move(str);
+        return true;
+      }
+      case array: {
+        std::vector<ossia::value> list;
+        depth++;
+        if(info == indefinite)
+        {
+          while(!at_break())
+            if(!read(list.emplace_back()))
+              return false;
+          ++cur;
+        }
+        else
+        {
+          uint64_t n{};
+          if(!read_argument(info, n) || !has(n))
+            return false;
+          list.resize(n);
+          for(auto& e : list)
+            if(!read(e))
+              return false;
+        }
+        depth--;
+        res = std::move(list);
+        return true;
+      }
+      case map: {
+        ossia::value_map_type map;
+        depth++;
+        auto read_pair = [&] {
+          ossia::value k;
+          if(!read(k))
+            return false;
+          auto& [key, val] = map.emplace_back();
+          key = ossia::convert<std::string>(k);
+          return read(val);
+        };
+        if(info == indefinite)
+        {
+          while(!at_break())
+            if(!read_pair())
+              return false;
+          ++cur;
+        }
+        else
+        {
+          uint64_t n{};
+          if(!read_argument(info, n) || !has(n))
+            return false;
+          map.reserve(n);
+          for(uint64_t i = 0; i < n; i++)
+            if(!read_pair())
+              return false;
+        }
+        depth--;
+        res = std::move(map);
+        return true;
+      }
+      case tag: {
+        // Tags are ignored, we only keep the tagged value
+        uint64_t n{};
+        if(!read_argument(info, n))
+          return false;
+        depth++;
+        const bool ok = read(res);
+        depth--;
+        return ok;
+      }
+      case simple: {
+        switch(initial)
+        {
+          case false_value:
+            res = false;
+            return true;
+          case true_value:
+            res = true;
+            return true;
+          case null_value:
+          case undefined_value:
+            res = ossia::impulse{};
+            return true;
+          case half_float:
+            if(!has(2))
+              return false;
+            res = half_to_float(read_big<uint16_t>(cur));
+            cur += 2;
+            return true;
+          case single_float:
+            if(!has(4))
+              return false;
+            res = std::bit_cast<float>(read_big<uint32_t>(cur));
+            cur += 4;
+            return true;
+          case double_float:
+            if(!has(8))
+              return false;
+            res = float(std::bit_cast<double>(read_big<uint64_t>(cur)));
+            cur += 8;
+            return true;
+          default:
+            return false;
+        }
+      }
+    }
+    return false;
+  }
+};
+}
+
+/// Raw little-endian ///
+struct raw_encoder
+{
+  std::string& out;
+
+  void operator()() const { }
+  void operator()(ossia::impulse) const { }
+  void operator()(int v) const { write_little(out, int32_t(v)); }
+  void operator()(float v) const { write_little_float(out, v); }
+  void operator()(bool v) const { out.push_back(char(v ? 1 : 0)); }
+  void operator()(const std::string& v) const { out.append(v); }
+  template <std::size_t N>
+  void operator()(const std::array<float, N>& v) const
+  {
+    for(float f : v)
+      write_little_float(out, f);
+  }
+  void operator()(const std::vector<ossia::value>& v) const
+  {
+    for(const auto& e : v)
+      write_little_float(out, ossia::convert<float>(e));
+  }
+  void operator()(const ossia::value_map_type& v) const { cbor::encoder{out}(v); }
+};
+
+template <std::size_t N>
+ossia::value read_raw_vec(std::string_view payload)
+{
+  std::array<float, N> res{};
+  const std::size_t count = std::min(N, payload.size() / sizeof(float));
+  for(std::size_t i = 0; i < count; i++)
+    res[i] = read_little_float(payload.data() + i * sizeof(float));
+  return res;
+}
+
+ossia::value read_raw(std::string_view payload, ossia::val_type type)
+{
+  const char* data = payload.data();
+  const std::size_t sz = payload.size();
+  switch(type)
+  {
+    case ossia::val_type::FLOAT:
+      // Doubles are also accepted
+      if(sz == 8)
+        return float(std::bit_cast<double>(read_little<uint64_t>(data)));
+      if(sz >= 4)
+        return read_little_float(data);
+      return ossia::value{};
+    case ossia::val_type::INT:
+      // Sensors commonly send 8, 16 or 32 bit integers
+      switch(sz)
+      {
+        case 1:
+          return int(int8_t(data[0]));
+        case 2:
+          return int(read_little<int16_t>(data));
+        case 0:
+        case 3:
+          return ossia::value{};
+        default:
+          return int(read_little<int32_t>(data));
+      }
+    case ossia::val_type::BOOL:
+      return sz > 0 && data[0] != 0;
+    case ossia::val_type::VEC2F:
+      return read_raw_vec<2>(payload);
+    case ossia::val_type::VEC3F:
+      return read_raw_vec<3>(payload);
+    case ossia::val_type::VEC4F:
+      return read_raw_vec<4>(payload);
+    case ossia::val_type::LIST: {
+      std::vector<ossia::value> res;
+      res.reserve(sz / sizeof(float));
+      for(std::size_t i = 0; i + sizeof(float) <= sz; i += sizeof(float))
+        res.emplace_back(read_little_float(data + i));
+      return res;
+    }
+    case ossia::val_type::MAP:
+      return mqtt5_decode(mqtt5_payload_codec::cbor, payload, type);
+    case ossia::val_type::IMPULSE:
+      return ossia::impulse{};
+    case ossia::val_type::STRING:
+    case ossia::val_type::NONE:
+    default:
+      return std::string(payload);
+  }
+}
+}
+
+void mqtt5_encode(mqtt5_payload_codec codec, const ossia::value& v, std::string& out)
+{
+  switch(codec)
+  {
+    case mqtt5_payload_codec::text:
+      out += ossia::convert<std::string>(v);
+      break;
+    case mqtt5_payload_codec::raw:
+      v.apply(raw_encoder{out});
+      break;
+    case mqtt5_payload_codec::cbor:
+      v.apply(cbor::encoder{out});
+      break;
+  }
+}
+
+ossia::value
+mqtt5_decode(mqtt5_payload_codec codec, std::string_view payload, ossia::val_type type)
+{
+  ossia::value res;
+  switch(codec)
+  {
+    case mqtt5_payload_codec::text:
+      res = std::string(payload);
+      break;
+
+    case mqtt5_payload_codec::raw:
+      return read_raw(payload, type);
+
+    case mqtt5_payload_codec::cbor: {
+      cbor::decoder dec{payload.data(), payload.data() + payload.size()};
+      if(!dec.read(res))
+        return ossia::value{};
+      break;
+    }
+  }
+
+  if(type != ossia::val_type::NONE && res.valid())
+    return ossia::convert(res, type);
+  return res;
+}
+}
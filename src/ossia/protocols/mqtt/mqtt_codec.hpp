@@ -0,0 +1,35 @@
+#pragma once
+#include <ossia/network/common/parameter_properties.hpp>
+#include <ossia/network/value/value.hpp>
+
+#include <string>
+#include <string_view>
+
+namespace ossia::net
+{
+/**
+ * @brief How values are written in the payload of MQTT messages
+ */
+enum class mqtt5_payload_codec : int8_t
+{
+  //! Values are converted to their textual representation
+  text,
+
+  //! Numbers and vectors are sent as little-endian binary:
+  //! int32 for ints, float32 for floats, vectors and lists, one byte for bools.
+  //! Strings are sent as-is, maps use CBOR.
+  raw,
+
+  //! CBOR (RFC 8949) encoding of the value
+  cbor
+};
+
+//! Appends the encoded value to out
+OSSIA_EXPORT
+void mqtt5_encode(mqtt5_payload_codec codec, const ossia::value& v, std::string& out);
+
+//! Decodes a payload, and converts it to type unless it is val_type::NONE
+OSSIA_EXPORT
+ossia::value
+mqtt5_decode(mqtt5_payload_codec codec, std::string_view payload, ossia::val_type type);
+}
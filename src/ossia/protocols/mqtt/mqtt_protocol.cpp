@@ -1,6 +1,7 @@
 #include "mqtt_protocol.hpp"
 
 #include <ossia/network/base/device.hpp>
+#include <ossia/network/base/node_attributes.hpp>
 
 #include <boost/asio/as_tuple.hpp>
 #include <boost/asio/awaitable.hpp>
@@ -19,6 +20,21 @@
 
 namespace ossia::net
 {
+std::string_view text_mqtt_qos()
+{
+  constexpr_return(ossia::make_string_view("mqttQos"));
+}
+
+std::optional<int> get_mqtt_qos(const ossia::net::node_base& n)
+{
+  return ossia::get_optional_attribute<int>(n, text_mqtt_qos());
+}
+
+void set_mqtt_qos(ossia::net::node_base& n, std::optional<int> qos)
+{
+  n.set(text_mqtt_qos(), std::move(qos));
+}
+
 using topics_type
     = boost::unordered::concurrent_flat_map<std::string, ossia::net::parameter_base*>;
 using strand_type
@@ -30,7 +46,8 @@ struct mqtt5_client_base
 {
   virtual ~mqtt5_client_base() = default;
   virtual void connect(const ossia::net::mqtt5_configuration& m_conf) = 0;
-  virtual boost::asio::awaitable<bool> publish(ossia::net::parameter_base& param) = 0;
+  virtual boost::asio::awaitable<bool>
+  publish(std::string topic, std::string payload, int qos) = 0;
   virtual boost::asio::awaitable<bool> subscribe(std::string topic) = 0;
   virtual boost::asio::awaitable<bool> unsubscribe(std::string topic) = 0;
   virtual boost::asio::awaitable<void> receive(mqtt5_protocol& self) = 0;
@@ -68,15 +85,33 @@ struct mqtt5_client : mqtt5_client_base
     }
   }
 
-  boost::asio::awaitable<bool> publish(ossia::net::parameter_base& param) override
+  boost::asio::awaitable<bool>
+  publish(std::string topic, std::string payload, int qos) override
   {
-    auto&& [ec, rc, props]
-        = co_await client.template async_publish<async_mqtt5::qos_e::at_least_once>(
-            param.get_node().osc_address(), ossia::convert<std::string>(param.value()),
-            async_mqtt5::retain_e::no, async_mqtt5::publish_props{},
-            use_nothrow_awaitable);
-
-    co_return ec || !rc;
+    switch(qos)
+    {
+      case 0: {
+        auto&& [ec]
+            = co_await client.template async_publish<async_mqtt5::qos_e::at_most_once>(
+                std::move(topic), std::move(payload), async_mqtt5::retain_e::no,
+                async_mqtt5::publish_props{}, use_nothrow_awaitable);
+        co_return !ec;
+      }
+      case 2: {
+        auto&& [ec, rc, props]
+            = co_await client.template async_publish<async_mqtt5::qos_e::exactly_once>(
+                std::move(topic), std::move(payload), async_mqtt5::retain_e::no,
+                async_mqtt5::publish_props{}, use_nothrow_awaitable);
+        co_return !ec && !rc;
+      }
+      default: {
+        auto&& [ec, rc, props]
+            = co_await client.template async_publish<async_mqtt5::qos_e::at_least_once>(
+                std::move(topic), std::move(payload), async_mqtt5::retain_e::no,
+                async_mqtt5::publish_props{}, use_nothrow_awaitable);
+        co_return !ec && !rc;
+      }
+    }
   }
 
   boost::asio::awaitable<bool> subscribe(std::string topic) override
@@ -173,6 +208,37 @@ struct mqtt5_protocol::subscribe_state
   } state{created};
 };
 
+// Values pushed while a publish is in flight for the same topic
+// replace each other: only the latest one is published afterwards.
+struct mqtt5_publish_state
+{
+  std::string topic;
+  ossia::value pending;
+  int qos{1};
+  bool in_flight{};
+};
+
+static boost::asio::awaitable<void> publish_latest(
+    mqtt5_client_base& client, mqtt5_payload_codec codec,
+    std::shared_ptr<mqtt5_publish_state> st)
+{
+  while(st->pending.valid())
+  {
+    ossia::value v = std::move(st->pending);
+    st->pending = ossia::value{};
+
+    std::string payload;
+    mqtt5_encode(codec, v, payload);
+    if(!co_await client.publish(st->topic, std::move(payload), st->qos))
+    {
+      // Also happens when the client is being destroyed
+      st->pending = ossia::value{};
+      break;
+    }
+  }
+  st->in_flight = false;
+}
+
 static auto make_mqtt_client(const mqtt5_configuration& conf, strand_type& strand)
 {
   struct
@@ -208,12 +274,37 @@ bool mqtt5_protocol::pull(ossia::net::parameter_base&)
 
 bool mqtt5_protocol::push(const ossia::net::parameter_base& p, const ossia::value& v)
 {
-  co_spawn(
-      m_strand, m_client->publish(const_cast<ossia::net::parameter_base&>(p)),
-      boost::asio::detached);
+  if(!v.valid())
+    return false;
+
+  boost::asio::post(
+      boost::asio::bind_executor(m_strand, [this, &p, v]() mutable {
+    publish_value(p, std::move(v));
+  }));
   return false;
 }
 
+void mqtt5_protocol::publish_value(const ossia::net::parameter_base& p, ossia::value&& v)
+{
+  if(!m_client)
+    return;
+
+  auto& st = m_publishes[&p];
+  if(!st)
+  {
+    st = std::make_shared<mqtt5_publish_state>();
+    st->topic = p.get_node().osc_address();
+    st->qos = std::clamp(get_mqtt_qos(p.get_node()).value_or(1), 0, 2);
+  }
+
+  st->pending = std::move(v);
+  if(!st->in_flight)
+  {
+    st->in_flight = true;
+    co_spawn(m_strand, publish_latest(*m_client, m_conf.codec, st), boost::asio::detached);
+  }
+}
+
 bool mqtt5_protocol::push_raw(const ossia::net::full_parameter_data&)
 {
   return false;
@@ -253,6 +344,25 @@ void mqtt5_protocol::on_removed_param(const ossia::net::parameter_base& p)
   if(!m_client)
     return;
   on_unsubscribe(p);
+
+  boost::asio::post(
+      boost::asio::bind_executor(m_strand, [this, &p] { m_publishes.erase(&p); }));
+}
+
+void mqtt5_protocol::on_attribute_modified(
+    ossia::net::node_base& node, const std::string& attr)
+{
+  if(attr != text_mqtt_qos())
+    return;
+
+  if(auto p = node.get_parameter())
+  {
+    auto qos = std::clamp(get_mqtt_qos(node).value_or(1), 0, 2);
+    boost::asio::post(boost::asio::bind_executor(m_strand, [this, p, qos] {
+      if(auto it = m_publishes.find(p); it != m_publishes.end())
+        it->second->qos = qos;
+    }));
+  }
 }
 
 void mqtt5_protocol::on_subscribe(ossia::net::parameter_base& p)
@@ -277,6 +387,7 @@ void mqtt5_protocol::set_device(device_base& dev)
   m_device = &dev;
   dev.on_parameter_created.connect<&mqtt5_protocol::on_new_param>(*this);
   dev.on_parameter_removing.connect<&mqtt5_protocol::on_removed_param>(*this);
+  dev.on_attribute_modified.connect<&mqtt5_protocol::on_attribute_modified>(*this);
 
   // Connect to the broker
   m_client->connect(m_conf);
@@ -308,9 +419,10 @@ void mqtt5_protocol::on_message(const std::string& topic, const std::string& pay
     return;
   }
 
-  m_topics.visit(topic, [&payload = payload](auto& v) {
+  m_topics.visit(topic, [&payload = payload, codec = m_conf.codec](auto& v) {
     auto& param = *v.second;
-    param.set_value(ossia::convert(payload, param.get_value_type()));
+    if(auto res = mqtt5_decode(codec, payload, param.get_value_type()); res.valid())
+      param.set_value(std::move(res));
   });
 }
 
@@ -339,6 +451,17 @@ void mqtt5_protocol::on_learn(const std::string& topic, const std::string& paylo
   {
     return;
   }
+  if(m_conf.codec == mqtt5_payload_codec::cbor)
+  {
+    // CBOR payloads carry their type
+    if(auto v = mqtt5_decode(m_conf.codec, payload, ossia::val_type::NONE); v.valid())
+    {
+      auto addr = n->create_parameter(v.get_type());
+      addr->set_value(std::move(v));
+      return;
+    }
+  }
+
   auto addr = n->create_parameter(ossia::val_type::STRING);
   addr->set_value(payload);
 }
@@ -348,9 +471,12 @@ void mqtt5_protocol::stop()
   assert(m_device);
   m_device->on_parameter_created.disconnect<&mqtt5_protocol::on_new_param>(*this);
   m_device->on_parameter_removing.disconnect<&mqtt5_protocol::on_removed_param>(*this);
+  m_device->on_attribute_modified.disconnect<&mqtt5_protocol::on_attribute_modified>(
+      *this);
 
   std::future<void> wait = boost::asio::dispatch(
       boost::asio::bind_executor(m_strand, std::packaged_task<void()>([this] {
+    m_publishes.clear();
     m_client.reset();
 
     m_root->cancellation.emit(boost::asio::cancellation_type::all);
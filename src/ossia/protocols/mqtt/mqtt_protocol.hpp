@@ -1,13 +1,18 @@
 #pragma once
 #include <ossia/detail/audio_spin_mutex.hpp>
+#include <ossia/detail/hash_map.hpp>
 #include <ossia/detail/variant.hpp>
 #include <ossia/network/base/protocol.hpp>
 #include <ossia/network/context.hpp>
 #include <ossia/network/sockets/configuration.hpp>
+#include <ossia/protocols/mqtt/mqtt_codec.hpp>
 
 #include <boost/asio/cancellation_signal.hpp>
 #include <boost/asio/strand.hpp>
 #include <boost/unordered/concurrent_flat_map.hpp>
+
+#include <optional>
+
 namespace ossia::net
 {
 using strand_type
@@ -16,9 +21,16 @@ using strand_type
 struct mqtt5_configuration
 {
   ossia::variant<tcp_client_configuration, ws_client_configuration> transport;
+  mqtt5_payload_codec codec{mqtt5_payload_codec::text};
 };
 
+//! QoS (0, 1 or 2) with which a parameter is published. Default is 1.
+OSSIA_EXPORT std::string_view text_mqtt_qos();
+OSSIA_EXPORT std::optional<int> get_mqtt_qos(const ossia::net::node_base& n);
+OSSIA_EXPORT void set_mqtt_qos(ossia::net::node_base& n, std::optional<int> qos);
+
 struct mqtt5_client_base;
+struct mqtt5_publish_state;
 
 class OSSIA_EXPORT mqtt5_protocol
     : public ossia::net::can_learn<ossia::net::protocol_base>
@@ -47,12 +59,18 @@ private:
   void on_removed_param(const parameter_base& param);
   void on_subscribe(parameter_base& param);
   void on_unsubscribe(const parameter_base& param);
+  void on_attribute_modified(node_base& node, const std::string& attr);
+  void publish_value(const parameter_base& param, ossia::value&& v);
 
   ossia::net::network_context_ptr m_context;
   ossia::net::device_base* m_device{};
   mqtt5_configuration m_conf{};
   std::unique_ptr<mqtt5_client_base> m_client;
 
+  // Only accessed from m_strand
+  ossia::hash_map<const parameter_base*, std::shared_ptr<mqtt5_publish_state>>
+      m_publishes;
+
   struct subscribe_state;
   boost::unordered::concurrent_flat_map<std::string, ossia::net::parameter_base*>
       m_topics;
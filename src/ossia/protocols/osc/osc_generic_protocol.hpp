@@ -37,7 +37,7 @@ public:
   osc_generic_bidir_protocol(
       network_context_ptr ctx, const send_fd_configuration& send_conf,
       const receive_fd_configuration& recv_conf)
-      : can_learn<ossia::net::protocol_base>{flags{SupportsMultiplex}}
+      : can_learn<ossia::net::protocol_base>{flags(SupportsMultiplex | SupportsBundles)}
       , m_ctx{std::move(ctx)}
       , m_id{*this}
       , from_client{recv_conf, m_ctx->context}
@@ -57,7 +57,7 @@ public:
   osc_generic_bidir_protocol(
       network_context_ptr ctx, const outbound_socket_configuration& send_conf,
       const inbound_socket_configuration& recv_conf)
-      : can_learn<ossia::net::protocol_base>{flags{SupportsMultiplex}}
+      : can_learn<ossia::net::protocol_base>{flags(SupportsMultiplex | SupportsBundles)}
       , m_ctx{std::move(ctx)}
       , m_id{*this}
       , from_client{recv_conf, m_ctx->context}
@@ -76,7 +76,7 @@ public:
 
   osc_generic_bidir_protocol(
       network_context_ptr ctx, const outbound_socket_configuration& send_conf)
-      : can_learn<ossia::net::protocol_base>{flags{SupportsMultiplex}}
+      : can_learn<ossia::net::protocol_base>{flags(SupportsMultiplex | SupportsBundles)}
       , m_ctx{std::move(ctx)}
       , m_id{*this}
       , to_client{send_conf, m_ctx->context}
@@ -86,7 +86,7 @@ public:
 
   osc_generic_bidir_protocol(
       network_context_ptr ctx, const inbound_socket_configuration& recv_conf)
-      : can_learn<ossia::net::protocol_base>{flags{SupportsMultiplex}}
+      : can_learn<ossia::net::protocol_base>{flags(SupportsMultiplex | SupportsBundles)}
       , m_ctx{std::move(ctx)}
       , m_id{*this}
       , from_client{recv_conf, m_ctx->context}
@@ -103,7 +103,7 @@ public:
 
   osc_generic_bidir_protocol(
       network_context_ptr ctx, const send_fd_configuration& send_conf)
-      : can_learn<ossia::net::protocol_base>{flags{SupportsMultiplex}}
+      : can_learn<ossia::net::protocol_base>{flags(SupportsMultiplex | SupportsBundles)}
       , m_ctx{std::move(ctx)}
       , m_id{*this}
       , to_client{send_conf, m_ctx->context}
@@ -113,7 +113,7 @@ public:
 
   osc_generic_bidir_protocol(
       network_context_ptr ctx, const receive_fd_configuration& recv_conf)
-      : can_learn<ossia::net::protocol_base>{flags{SupportsMultiplex}}
+      : can_learn<ossia::net::protocol_base>{flags(SupportsMultiplex | SupportsBundles)}
       , m_ctx{std::move(ctx)}
       , m_id{*this}
       , from_client{recv_conf, m_ctx->context}
@@ -295,7 +295,7 @@ public:
   template <typename Configuration>
     requires(requires(Configuration conf) { Socket{conf, network_context_ptr{}}; })
   osc_generic_server_protocol(network_context_ptr ctx, const Configuration& conf)
-      : can_learn<ossia::net::protocol_base>{flags{SupportsMultiplex}}
+      : can_learn<ossia::net::protocol_base>{flags(SupportsMultiplex | SupportsBundles)}
       , m_ctx{std::move(ctx)}
       , m_id{*this}
       , m_server{conf, m_ctx}
@@ -409,7 +409,7 @@ public:
 
   template <typename Configuration>
   osc_generic_client_protocol(network_context_ptr ctx, const Configuration& conf)
-      : can_learn<ossia::net::protocol_base>{flags{SupportsMultiplex}}
+      : can_learn<ossia::net::protocol_base>{flags(SupportsMultiplex | SupportsBundles)}
       , m_ctx{std::move(ctx)}
       , m_id{*this}
       , m_client{conf, m_ctx->context}
@@ -0,0 +1,748 @@
+#include <ossia/detail/algorithms.hpp>
+#include <ossia/detail/logger.hpp>
+#include <ossia/network/base/device.hpp>
+#include <ossia/network/base/node_functions.hpp>
+#include <ossia/network/value/value_array.hpp>
+#include <ossia/protocols/shmem/shmem_protocol.hpp>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+namespace ossia::net
+{
+namespace
+{
+static constexpr uint32_t shmem_magic = 0x6f737368; // "ossh"
+static constexpr uint32_t shmem_version = 1;
+static constexpr int shmem_max_path = 256;
+
+static constexpr std::size_t align_line(std::size_t sz) noexcept
+{
+  return (sz + 63) & ~std::size_t(63);
+}
+
+static bool pid_alive(int32_t pid) noexcept
+{
+  return ::kill(pid, 0) == 0 || errno != ESRCH;
+}
+
+enum shmem_slot_state : uint32_t
+{
+  slot_free,
+  slot_published,
+  slot_removed
+};
+
+struct shmem_header
+{
+  std::atomic<uint32_t> magic; // Written last, once the segment is initialized
+  uint32_t version;
+  int32_t server; // pid of the server which created the segment
+  uint32_t max_parameters;
+  uint32_t max_value_size;
+  uint32_t max_clients;
+  uint32_t ring_size;
+
+  // Slots are allocated in order and never reused
+  std::atomic<uint32_t> parameter_count;
+  std::atomic<uint32_t> structure_version;
+};
+
+struct alignas(64) shmem_slot
+{
+  // Written once, before the slot is counted in parameter_count
+  std::atomic<uint32_t> state;
+  char path[shmem_max_path];
+
+  // Protected by the seqlock: odd while the server writes the value
+  std::atomic<uint32_t> seq;
+  int32_t type;
+  uint32_t size;
+  // Followed by max_value_size bytes of value
+};
+
+struct alignas(64) shmem_ring
+{
+  // pid of the client which reads the ring, 0 if free
+  std::atomic<int32_t> owner;
+  // Set when the server had to drop changes: the client reads all the values
+  std::atomic<uint32_t> overflow;
+  alignas(64) std::atomic<uint64_t> write_index;
+  alignas(64) std::atomic<uint64_t> read_index;
+  // Followed by ring_size slot indices
+};
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free);
+static_assert(std::atomic<uint64_t>::is_always_lock_free);
+}
+
+struct shmem_segment
+{
+  std::string name;
+  unsigned char* data{};
+  std::size_t size{};
+  bool owner{};
+
+  std::size_t slot_stride{};
+  std::size_t ring_stride{};
+  std::size_t rings_offset{};
+
+  static std::size_t compute_layout(
+      const shmem_header& h, std::size_t& slot_stride, std::size_t& ring_stride,
+      std::size_t& rings_offset) noexcept
+  {
+    slot_stride = align_line(sizeof(shmem_slot) + h.max_value_size);
+    ring_stride = align_line(sizeof(shmem_ring) + sizeof(uint32_t) * h.ring_size);
+    rings_offset = align_line(sizeof(shmem_header)) + slot_stride * h.max_parameters;
+    return rings_offset + ring_stride * h.max_clients;
+  }
+
+  // pid of the server of an existing segment, 0 if it is not a valid segment
+  static int32_t existing_server(int fd) noexcept
+  {
+    struct stat st;
+    if(::fstat(fd, &st) < 0 || std::size_t(st.st_size) < sizeof(shmem_header))
+      return 0;
+
+    void* ptr = ::mmap(nullptr, sizeof(shmem_header), PROT_READ, MAP_SHARED, fd, 0);
+    if(ptr == MAP_FAILED)
+      return 0;
+
+    auto& hdr = *static_cast<const shmem_header*>(ptr);
+    int32_t pid = 0;
+    if(hdr.magic.load(std::memory_order_acquire) == shmem_magic
+       && hdr.version == shmem_version)
+      pid = hdr.server;
+    ::munmap(ptr, sizeof(shmem_header));
+    return pid;
+  }
+
+  // Creates a new segment, replacing a segment left by a server which exited
+  // without removing it
+  static std::unique_ptr<shmem_segment> create(const shmem_configuration& conf)
+  {
+    if(conf.max_parameters <= 0 || conf.max_value_size <= 0 || conf.max_clients <= 0
+       || conf.ring_size <= 0)
+      throw std::runtime_error("shmem: invalid configuration");
+
+    auto seg = std::make_unique<shmem_segment>();
+    seg->name = conf.name;
+
+    shmem_header h{};
+    h.max_parameters = conf.max_parameters;
+    h.max_value_size = align_line(conf.max_value_size);
+    h.max_clients = conf.max_clients;
+    h.ring_size = conf.ring_size;
+    seg->size
+        = compute_layout(h, seg->slot_stride, seg->ring_stride, seg->rings_offset);
+
+    if(int fd = ::shm_open(conf.name.c_str(), O_RDONLY, 0); fd >= 0)
+    {
+      const int32_t server = existing_server(fd);
+      ::close(fd);
+      if(server == 0)
+        throw std::runtime_error("shmem: segment already exists " + conf.name);
+      if(pid_alive(server))
+        throw std::runtime_error("shmem: segment already in use " + conf.name);
+
+      ossia::logger().warn(
+          "shmem: replacing the segment {} of server {}, which is not running",
+          conf.name, server);
+      ::shm_unlink(conf.name.c_str());
+    }
+
+    int fd = ::shm_open(conf.name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if(fd < 0)
+      throw std::runtime_error("shmem: cannot create segment " + conf.name);
+    if(::ftruncate(fd, seg->size) < 0)
+    {
+      ::close(fd);
+      ::shm_unlink(conf.name.c_str());
+      throw std::runtime_error("shmem: cannot allocate segment " + conf.name);
+    }
+    seg->map(fd);
+    seg->owner = true;
+
+    // The memory is zero-filled by ftruncate
+    auto& hdr = *new(seg->data) shmem_header{};
+    hdr.version = shmem_version;
+    hdr.server = ::getpid();
+    hdr.max_parameters = h.max_parameters;
+    hdr.max_value_size = h.max_value_size;
+    hdr.max_clients = h.max_clients;
+    hdr.ring_size = h.ring_size;
+    for(uint32_t i = 0; i < h.max_parameters; i++)
+      new(&seg->slot(i)) shmem_slot{};
+    for(uint32_t i = 0; i < h.max_clients; i++)
+      new(&seg->ring(i)) shmem_ring{};
+
+    hdr.magic.store(shmem_magic, std::memory_order_release);
+    return seg;
+  }
+
+  // Opens the segment of a running server
+  static std::unique_ptr<shmem_segment> open(const shmem_configuration& conf)
+  {
+    auto seg = std::make_unique<shmem_segment>();
+    seg->name = conf.name;
+
+    int fd = ::shm_open(conf.name.c_str(), O_RDWR, 0);
+    if(fd < 0)
+      throw std::runtime_error("shmem: cannot open segment " + conf.name);
+
+    struct stat st;
+    if(::fstat(fd, &st) < 0 || std::size_t(st.st_size) < sizeof(shmem_header))
+    {
+      ::close(fd);
+      throw std::runtime_error("shmem: invalid segment " + conf.name);
+    }
+    seg->size = st.st_size;
+    seg->map(fd);
+
+    auto& hdr = seg->header();
+    if(hdr.magic.load(std::memory_order_acquire) != shmem_magic
+       || hdr.version != shmem_version
+       || compute_layout(hdr, seg->slot_stride, seg->ring_stride, seg->rings_offset)
+              > seg->size)
+      throw std::runtime_error("shmem: invalid segment " + conf.name);
+    return seg;
+  }
+
+  ~shmem_segment()
+  {
+    if(data)
+      ::munmap(data, size);
+    if(owner)
+      ::shm_unlink(name.c_str());
+  }
+
+  void map(int fd)
+  {
+    void* ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if(ptr == MAP_FAILED)
+      throw std::runtime_error("shmem: cannot map segment " + name);
+    data = static_cast<unsigned char*>(ptr);
+  }
+
+  shmem_header& header() const noexcept
+  {
+    return *reinterpret_cast<shmem_header*>(data);
+  }
+
+  shmem_slot& slot(uint32_t i) const noexcept
+  {
+    return *reinterpret_cast<shmem_slot*>(
+        data + align_line(sizeof(shmem_header)) + i * slot_stride);
+  }
+
+  unsigned char* slot_data(uint32_t i) const noexcept
+  {
+    return reinterpret_cast<unsigned char*>(&slot(i)) + sizeof(shmem_slot);
+  }
+
+  shmem_ring& ring(uint32_t i) const noexcept
+  {
+    return *reinterpret_cast<shmem_ring*>(data + rings_offset + i * ring_stride);
+  }
+
+  uint32_t* ring_data(uint32_t i) const noexcept
+  {
+    return reinterpret_cast<uint32_t*>(
+        reinterpret_cast<unsigned char*>(&ring(i)) + sizeof(shmem_ring));
+  }
+};
+
+namespace
+{
+// Writes the value in the format stored in the slots, returns the size or -1
+static int encode_value(const ossia::value& v, unsigned char* out, int max) noexcept
+{
+  auto write = [&](const void* data, std::size_t sz) {
+    if(sz > std::size_t(max))
+      return -1;
+    std::memcpy(out, data, sz);
+    return int(sz);
+  };
+
+  switch(v.get_type())
+  {
+    case ossia::val_type::IMPULSE:
+      return 0;
+    case ossia::val_type::INT:
+      return write(v.target<int>(), sizeof(int));
+    case ossia::val_type::FLOAT:
+      return write(v.target<float>(), sizeof(float));
+    case ossia::val_type::BOOL: {
+      const unsigned char b = *v.target<bool>();
+      return write(&b, 1);
+    }
+    case ossia::val_type::VEC2F:
+      return write(v.target<ossia::vec2f>()->data(), sizeof(ossia::vec2f));
+    case ossia::val_type::VEC3F:
+      return write(v.target<ossia::vec3f>()->data(), sizeof(ossia::vec3f));
+    case ossia::val_type::VEC4F:
+      return write(v.target<ossia::vec4f>()->data(), sizeof(ossia::vec4f));
+    case ossia::val_type::STRING: {
+      auto& str = *v.target<std::string>();
+      return write(str.data(), str.size());
+    }
+    case ossia::val_type::LIST: {
+      auto& list = *v.target<std::vector<ossia::value>>();
+      if(list.size() * sizeof(float) > std::size_t(max) || !ossia::is_numeric_list(list))
+        return -1;
+      for(const auto& e : list)
+      {
+        const float f = e.get_type() == ossia::val_type::FLOAT ? *e.target<float>()
+                                                                : *e.target<int>();
+        std::memcpy(out, &f, sizeof(float));
+        out += sizeof(float);
+      }
+      return list.size() * sizeof(float);
+    }
+    default:
+      return -1;
+  }
+}
+
+static ossia::value
+decode_value(ossia::val_type type, const unsigned char* data, uint32_t size)
+{
+  auto read = [&]<typename T>(T t) -> ossia::value {
+    if(size != sizeof(T))
+      return {};
+    std::memcpy(&t, data, sizeof(T));
+    return t;
+  };
+
+  switch(type)
+  {
+    case ossia::val_type::IMPULSE:
+      return ossia::impulse{};
+    case ossia::val_type::INT:
+      return read(int{});
+    case ossia::val_type::FLOAT:
+      return read(float{});
+    case ossia::val_type::BOOL:
+      return size == 1 ? ossia::value{data[0] != 0} : ossia::value{};
+    case ossia::val_type::VEC2F:
+      return read(ossia::vec2f{});
+    case ossia::val_type::VEC3F:
+      return read(ossia::vec3f{});
+    case ossia::val_type::VEC4F:
+      return read(ossia::vec4f{});
+    case ossia::val_type::STRING:
+      return std::string(reinterpret_cast<const char*>(data), size);
+    case ossia::val_type::LIST:
+      return ossia::make_numeric_list(tcb::span<const float>(
+          reinterpret_cast<const float*>(data), size / sizeof(float)));
+    default:
+      return {};
+  }
+}
+
+}
+
+//// Server ////
+
+shmem_server_protocol::shmem_server_protocol(const shmem_configuration& conf)
+    : m_segment{shmem_segment::create(conf)}
+{
+  m_buffer.resize(m_segment->header().max_value_size);
+}
+
+shmem_server_protocol::~shmem_server_protocol()
+{
+  if(m_device)
+    stop();
+}
+
+bool shmem_server_protocol::pull(parameter_base&)
+{
+  return false;
+}
+
+bool shmem_server_protocol::push(const parameter_base& p, const value& v)
+{
+  auto& seg = *m_segment;
+  auto& hdr = seg.header();
+
+  std::lock_guard lock{m_mutex};
+  auto it = m_slots.find(&p);
+  if(it == m_slots.end())
+    return false;
+  const uint32_t index = it->second;
+
+  // Values which cannot be stored in a slot leave the previous value in place
+  const int sz = encode_value(v, m_buffer.data(), hdr.max_value_size);
+  if(sz < 0)
+    return false;
+
+  // Write the value under the seqlock
+  auto& s = seg.slot(index);
+  const uint32_t seq = s.seq.load(std::memory_order_relaxed);
+  s.seq.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  s.type = int32_t(v.get_type());
+  s.size = sz;
+  std::memcpy(seg.slot_data(index), m_buffer.data(), sz);
+  s.seq.store(seq + 2, std::memory_order_release);
+
+  // Notify the clients
+  for(uint32_t i = 0; i < hdr.max_clients; i++)
+  {
+    auto& r = seg.ring(i);
+    if(r.owner.load(std::memory_order_relaxed) == 0)
+      continue;
+
+    const uint64_t w = r.write_index.load(std::memory_order_relaxed);
+    const uint64_t rd = r.read_index.load(std::memory_order_acquire);
+    if(w - rd < hdr.ring_size)
+    {
+      seg.ring_data(i)[w % hdr.ring_size] = index;
+      r.write_index.store(w + 1, std::memory_order_release);
+    }
+    else
+    {
+      r.overflow.store(1, std::memory_order_release);
+    }
+  }
+  return true;
+}
+
+bool shmem_server_protocol::push_raw(const full_parameter_data&)
+{
+  return false;
+}
+
+bool shmem_server_protocol::observe(parameter_base&, bool)
+{
+  return false;
+}
+
+bool shmem_server_protocol::update(node_base&)
+{
+  return false;
+}
+
+void shmem_server_protocol::set_device(device_base& dev)
+{
+  m_device = &dev;
+  dev.on_parameter_created.connect<&shmem_server_protocol::on_new_param>(*this);
+  dev.on_parameter_removing.connect<&shmem_server_protocol::on_removed_param>(*this);
+
+  ossia::net::iterate_all_children(
+      &dev.get_root_node(),
+      [this](ossia::net::parameter_base& param) { on_new_param(param); });
+}
+
+void shmem_server_protocol::stop()
+{
+  assert(m_device);
+  m_device->on_parameter_created.disconnect<&shmem_server_protocol::on_new_param>(
+      *this);
+  m_device->on_parameter_removing.disconnect<&shmem_server_protocol::on_removed_param>(
+      *this);
+  m_device = nullptr;
+}
+
+void shmem_server_protocol::on_new_param(const parameter_base& param)
+{
+  auto& seg = *m_segment;
+  auto& hdr = seg.header();
+  const auto path = param.get_node().osc_address();
+  if(path.size() >= shmem_max_path)
+  {
+    ossia::logger().warn("shmem: address too long: {}", path);
+    return;
+  }
+
+  {
+    std::lock_guard lock{m_mutex};
+    if(m_slots.find(&param) != m_slots.end())
+      return;
+
+    const uint32_t index = hdr.parameter_count.load(std::memory_order_relaxed);
+    if(index >= hdr.max_parameters)
+    {
+      ossia::logger().warn("shmem: no slot left for {}", path);
+      return;
+    }
+
+    auto& s = seg.slot(index);
+    std::memcpy(s.path, path.data(), path.size());
+    s.path[path.size()] = 0;
+
+    // The declared type, until a value is written:
+    // the zero-filled slot would otherwise read as a float
+    const uint32_t seq = s.seq.load(std::memory_order_relaxed);
+    s.seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    s.type = int32_t(param.get_value_type());
+    s.size = 0;
+    s.seq.store(seq + 2, std::memory_order_release);
+
+    s.state.store(slot_published, std::memory_order_relaxed);
+    m_slots[&param] = index;
+
+    hdr.parameter_count.store(index + 1, std::memory_order_release);
+    hdr.structure_version.fetch_add(1, std::memory_order_release);
+  }
+
+  push(param, param.value());
+}
+
+void shmem_server_protocol::on_removed_param(const parameter_base& param)
+{
+  auto& hdr = m_segment->header();
+
+  std::lock_guard lock{m_mutex};
+  auto it = m_slots.find(&param);
+  if(it == m_slots.end())
+    return;
+
+  m_segment->slot(it->second).state.store(slot_removed, std::memory_order_release);
+  hdr.structure_version.fetch_add(1, std::memory_order_release);
+  m_slots.erase(it);
+}
+
+//// Client ////
+
+shmem_client_protocol::shmem_client_protocol(
+    ossia::net::network_context_ptr ctx, const shmem_configuration& conf)
+    : m_context{std::move(ctx)}
+    , m_segment{shmem_segment::open(conf)}
+    , m_timer{m_context->context}
+{
+  auto& seg = *m_segment;
+  auto& hdr = seg.header();
+  m_buffer.resize(hdr.max_value_size);
+
+  // Claim a free ring, or the ring of a client which exited without releasing it
+  const int32_t pid = ::getpid();
+  for(uint32_t i = 0; i < hdr.max_clients && m_ring < 0; i++)
+  {
+    auto& r = seg.ring(i);
+    int32_t owner = r.owner.load(std::memory_order_relaxed);
+    if(owner != 0 && pid_alive(owner))
+      continue;
+
+    if(r.owner.compare_exchange_strong(owner, pid, std::memory_order_acq_rel))
+    {
+      // Changes pushed before the ring was claimed are read in update_structure
+      r.read_index.store(
+          r.write_index.load(std::memory_order_acquire), std::memory_order_release);
+      r.overflow.store(0, std::memory_order_relaxed);
+      m_ring = i;
+    }
+  }
+
+  if(m_ring < 0)
+    throw std::runtime_error("shmem: too many clients for " + conf.name);
+
+  // The timer has a millisecond resolution: a shorter delay would make it spin
+  m_polling = conf.interval.count() > 0;
+  m_timer.set_delay(std::max(
+      std::chrono::duration_cast<std::chrono::milliseconds>(conf.interval),
+      std::chrono::milliseconds{1}));
+}
+
+shmem_client_protocol::~shmem_client_protocol()
+{
+  if(m_device)
+    stop();
+  m_segment->ring(m_ring).owner.store(0, std::memory_order_release);
+}
+
+bool shmem_client_protocol::pull(parameter_base& param)
+{
+  auto it = ossia::find(m_params, &param);
+  if(it == m_params.end())
+    return false;
+  read_value(it - m_params.begin());
+  return true;
+}
+
+bool shmem_client_protocol::push(const parameter_base&, const value&)
+{
+  return false;
+}
+
+bool shmem_client_protocol::push_raw(const full_parameter_data&)
+{
+  return false;
+}
+
+bool shmem_client_protocol::observe(parameter_base&, bool)
+{
+  return false;
+}
+
+bool shmem_client_protocol::update(node_base&)
+{
+  update_structure();
+  return true;
+}
+
+void shmem_client_protocol::set_device(device_base& dev)
+{
+  m_device = &dev;
+  dev.on_parameter_removing.connect<&shmem_client_protocol::on_removed_param>(*this);
+
+  update_structure();
+  if(m_polling)
+    m_timer.start([this] { poll(); });
+}
+
+void shmem_client_protocol::stop()
+{
+  assert(m_device);
+  if(m_polling)
+    m_timer.stop();
+  m_device->on_parameter_removing.disconnect<&shmem_client_protocol::on_removed_param>(
+      *this);
+  m_device = nullptr;
+}
+
+void shmem_client_protocol::poll()
+{
+  if(!m_device)
+    return;
+
+  auto& seg = *m_segment;
+  auto& hdr = seg.header();
+  if(hdr.structure_version.load(std::memory_order_acquire) != m_structure_version)
+    update_structure();
+
+  auto& r = seg.ring(m_ring);
+  const bool overflow = r.overflow.exchange(0, std::memory_order_acquire);
+  const uint64_t w = r.write_index.load(std::memory_order_acquire);
+  const uint32_t* indices = seg.ring_data(m_ring);
+
+  if(overflow)
+  {
+    // Changes were dropped: read all the values instead
+    for(uint32_t i = 0; i < m_params.size(); i++)
+      read_value(i);
+  }
+  else
+  {
+    for(uint64_t i = r.read_index.load(std::memory_order_relaxed); i < w; i++)
+      read_value(indices[i % hdr.ring_size]);
+  }
+  r.read_index.store(w, std::memory_order_release);
+}
+
+// A server which exits while writing a slot leaves its sequence odd:
+// the slot is considered unreadable once this many attempts failed
+static constexpr int shmem_read_attempts = 1 << 16;
+
+// Calls read under the seqlock of the slot, returns false if the slot is unreadable
+template <typename F>
+static bool read_slot(const shmem_slot& s, F&& read) noexcept
+{
+  for(int i = 0; i < shmem_read_attempts; i++)
+  {
+    const uint32_t seq = s.seq.load(std::memory_order_acquire);
+    if(seq & 1)
+    {
+      ossia_rwlock_pause();
+      continue;
+    }
+
+    read();
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if(s.seq.load(std::memory_order_relaxed) == seq)
+      return true;
+  }
+  return false;
+}
+
+void shmem_client_protocol::update_structure()
+{
+  if(!m_device)
+    return;
+
+  auto& seg = *m_segment;
+  auto& hdr = seg.header();
+  m_structure_version = hdr.structure_version.load(std::memory_order_acquire);
+  const uint32_t count = hdr.parameter_count.load(std::memory_order_acquire);
+
+  // Parameters removed from the server
+  for(uint32_t i = 0; i < m_params.size(); i++)
+  {
+    if(auto p = m_params[i];
+       p && seg.slot(i).state.load(std::memory_order_acquire) == slot_removed)
+    {
+      m_params[i] = nullptr;
+      auto& node = p->get_node();
+      if(auto parent = node.get_parent())
+        parent->remove_child(node);
+    }
+  }
+
+  // Parameters added to the server
+  auto& root = m_device->get_root_node();
+  for(uint32_t i = m_params.size(); i < count; i++)
+  {
+    auto& s = seg.slot(i);
+    m_params.push_back(nullptr);
+    if(s.state.load(std::memory_order_acquire) != slot_published)
+      continue;
+
+    int32_t type{};
+    if(!read_slot(s, [&] { type = s.type; }))
+      continue;
+
+    auto& node = ossia::net::find_or_create_node(root, s.path);
+    auto p = node.get_parameter();
+    if(!p)
+    {
+      p = node.create_parameter(
+          ossia::val_type(type) == ossia::val_type::NONE ? ossia::val_type::IMPULSE
+                                                         : ossia::val_type(type));
+    }
+    m_params[i] = p;
+    read_value(i);
+  }
+}
+
+void shmem_client_protocol::read_value(uint32_t index)
+{
+  if(index >= m_params.size() || !m_params[index])
+    return;
+
+  auto& seg = *m_segment;
+  auto& s = seg.slot(index);
+  const uint32_t max = seg.header().max_value_size;
+
+  int32_t type{};
+  uint32_t size{};
+  if(!read_slot(s, [&] {
+       type = s.type;
+       size = std::min(s.size, max);
+       std::memcpy(m_buffer.data(), seg.slot_data(index), size);
+     }))
+    return;
+
+  if(auto v = decode_value(ossia::val_type(type), m_buffer.data(), size); v.valid())
+    m_params[index]->set_value(std::move(v));
+}
+
+void shmem_client_protocol::on_removed_param(const parameter_base& param)
+{
+  if(auto it = ossia::find(m_params, &param); it != m_params.end())
+    *it = nullptr;
+}
+}
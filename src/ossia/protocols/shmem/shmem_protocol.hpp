@@ -0,0 +1,128 @@
+#pragma once
+#include <ossia/detail/audio_spin_mutex.hpp>
+#include <ossia/detail/hash_map.hpp>
+#include <ossia/detail/timer.hpp>
+#include <ossia/network/base/protocol.hpp>
+#include <ossia/network/context.hpp>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+/**
+ * \file shmem_protocol.hpp
+ *
+ * Exchange of parameter values between processes of the same machine,
+ * through a POSIX shared memory segment.
+ *
+ * The server creates the segment and removes it when it is destroyed.
+ * A segment left by a server which did not exit cleanly is replaced, but
+ * creating a server fails if the segment belongs to a running server.
+ *
+ * The server publishes the parameters of its device in the segment:
+ * each parameter has a fixed-size slot, whose value is protected by a seqlock.
+ * Each client claims a ring in the segment, in which the server writes the
+ * indices of the slots whose value changed; clients read the values directly
+ * from the slots, without any serialization nor system call.
+ *
+ * Values flow from the server to the clients only.
+ * Impulses, ints, floats, bools, vecNf, strings and lists of numbers are
+ * supported, as long as they fit in a slot.
+ */
+namespace ossia::net
+{
+struct shmem_segment;
+
+struct shmem_configuration
+{
+  //! Name of the segment, e.g. "/my_device"
+  std::string name;
+
+  //! Only used by the server: size of the segment
+  int max_parameters{1024};
+  int max_value_size{256}; //!< In bytes
+  int max_clients{8};
+  int ring_size{1024};
+
+  //! Only used by the clients: period at which the rings are read from the
+  //! network context, rounded down to milliseconds and at least 1 ms.
+  //! Zero disables the timer: poll() must then be called by the application,
+  //! e.g. for sub-millisecond latency.
+  std::chrono::microseconds interval{std::chrono::milliseconds{1}};
+};
+
+class OSSIA_EXPORT shmem_server_protocol final
+    : public ossia::net::protocol_base
+    , public Nano::Observer
+{
+public:
+  explicit shmem_server_protocol(const shmem_configuration& conf);
+  ~shmem_server_protocol();
+
+  bool pull(parameter_base&) override;
+  bool push(const parameter_base&, const value& v) override;
+  bool push_raw(const full_parameter_data&) override;
+  bool observe(parameter_base&, bool) override;
+  bool update(node_base& node_base) override;
+  void set_device(device_base& dev) override;
+  void stop() override;
+
+private:
+  void on_new_param(const parameter_base& param);
+  void on_removed_param(const parameter_base& param);
+
+  ossia::net::device_base* m_device{};
+  std::unique_ptr<shmem_segment> m_segment;
+
+  // The server is the only writer of the slots and rings of the segment
+  ossia::audio_spin_mutex m_mutex;
+  ossia::hash_map<const parameter_base*, uint32_t> m_slots TS_GUARDED_BY(m_mutex);
+  std::vector<unsigned char> m_buffer TS_GUARDED_BY(m_mutex);
+};
+
+class OSSIA_EXPORT shmem_client_protocol final
+    : public ossia::net::protocol_base
+    , public Nano::Observer
+{
+public:
+  explicit shmem_client_protocol(
+      ossia::net::network_context_ptr, const shmem_configuration& conf);
+  ~shmem_client_protocol();
+
+  bool pull(parameter_base&) override;
+  bool push(const parameter_base&, const value& v) override;
+  bool push_raw(const full_parameter_data&) override;
+  bool observe(parameter_base&, bool) override;
+  bool update(node_base& node_base) override;
+  void set_device(device_base& dev) override;
+  void stop() override;
+
+  /**
+   * @brief Applies the values changed since the last call.
+   *
+   * Called periodically from the network context, unless the interval of the
+   * configuration is zero: it must then be called directly, e.g. from a thread
+   * dedicated to the device for lower latency.
+   * It must not be called directly while the timer is enabled, as both would
+   * read the ring concurrently.
+   */
+  void poll();
+
+private:
+  void on_removed_param(const parameter_base& param);
+  void update_structure();
+  void read_value(uint32_t slot);
+
+  ossia::net::network_context_ptr m_context;
+  ossia::net::device_base* m_device{};
+  std::unique_ptr<shmem_segment> m_segment;
+  int m_ring{-1};
+
+  std::vector<parameter_base*> m_params;
+  std::vector<unsigned char> m_buffer;
+  uint32_t m_structure_version{};
+
+  ossia::timer m_timer;
+  bool m_polling{};
+};
+}
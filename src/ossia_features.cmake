@@ -30,6 +30,11 @@ if(IOS OR EMSCRIPTEN)
   set(OSSIA_PROTOCOL_MQTT5 FALSE CACHE INTERNAL "")
   set(OSSIA_PROTOCOL_COAP FALSE CACHE INTERNAL "")
   set(OSSIA_PROTOCOL_MQTT5 FALSE CACHE INTERNAL "")
+  set(OSSIA_PROTOCOL_SHMEM FALSE CACHE INTERNAL "")
+endif()
+
+if(WIN32)
+  set(OSSIA_PROTOCOL_SHMEM FALSE CACHE INTERNAL "")
 endif()
 
 if(NOT OSSIA_QML)
@@ -177,6 +182,14 @@ if (OSSIA_PROTOCOL_COAP)
     set(OSSIA_PROTOCOLS ${OSSIA_PROTOCOLS} coap)
 endif()
 
+if (OSSIA_PROTOCOL_SHMEM)
+    target_sources(ossia PRIVATE ${OSSIA_SHMEM_SRCS} ${OSSIA_SHMEM_HEADERS})
+    if(CMAKE_SYSTEM_NAME STREQUAL "Linux")
+      target_link_libraries(ossia PRIVATE rt)
+    endif()
+    set(OSSIA_PROTOCOLS ${OSSIA_PROTOCOLS} shmem)
+endif()
+
 # Additional features
 if(OSSIA_C)
   target_sources(ossia PRIVATE ${OSSIA_C_HEADERS} ${OSSIA_C_SRCS})
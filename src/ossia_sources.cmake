@@ -77,6 +77,7 @@ set(API_HEADERS
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/common/node_visitor.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/common/parameter_properties.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/common/value_bounding.hpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/common/value_codec.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/common/value_mapping.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/common/websocket_log_sink.hpp"
 
@@ -88,6 +89,7 @@ set(API_HEADERS
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/sockets/null_socket.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/sockets/framing.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/sockets/no_framing.hpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/sockets/framing_buffer.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/sockets/line_framing.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/sockets/size_prefix_framing.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/sockets/slip_framing.hpp"
@@ -122,6 +124,8 @@ set(API_HEADERS
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/base/parameter.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/base/address_scope.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/base/parameter_data.hpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/base/parameter_inbox.hpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/base/fuzzysearch_index.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/base/device.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/base/node.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/base/message_origin_identifier.hpp"
@@ -162,6 +166,7 @@ set(API_HEADERS
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/value/detail/value_conversion_impl.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/value/detail/value_parse_impl.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/value/value.hpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/value/value_array.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/value/value_traits.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/value/value_algorithms.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/value/value_variant_impl.hpp"
@@ -217,6 +222,8 @@ set(SRCS
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/domain/wrap.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/domain/fold.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/base/parameter.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/base/parameter_inbox.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/base/fuzzysearch_index.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/base/device.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/base/name_validation.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/base/node.cpp"
@@ -229,6 +236,7 @@ set(SRCS
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/common/complex_type.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/common/debug.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/common/device_parameter.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/common/value_codec.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/common/value_mapping.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/generic/generic_parameter.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/network/generic/generic_device.cpp"
@@ -543,9 +551,11 @@ set(OSSIA_ARTNET_SRCS
 )
 
 set(OSSIA_MQTT5_HEADERS
+    "${CMAKE_CURRENT_SOURCE_DIR}/ossia/protocols/mqtt/mqtt_codec.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/protocols/mqtt/mqtt_protocol.hpp")
 
 set(OSSIA_MQTT5_SRCS
+    "${CMAKE_CURRENT_SOURCE_DIR}/ossia/protocols/mqtt/mqtt_codec.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/protocols/mqtt/mqtt_protocol.cpp")
 
 set(OSSIA_COAP_HEADERS
@@ -562,6 +572,14 @@ set(OSSIA_COAP_SRCS
 
 
 
+set(OSSIA_SHMEM_HEADERS
+    "${CMAKE_CURRENT_SOURCE_DIR}/ossia/protocols/shmem/shmem_protocol.hpp"
+)
+
+set(OSSIA_SHMEM_SRCS
+    "${CMAKE_CURRENT_SOURCE_DIR}/ossia/protocols/shmem/shmem_protocol.cpp"
+)
+
 set(OSSIA_WS_CLIENT_HEADERS
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia-qt/websocket-generic-client/ws_generic_client_protocol.hpp")
 
@@ -686,6 +704,7 @@ set(OSSIA_DATAFLOW_HEADERS
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/audio/dummy_protocol.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/audio/jack_protocol.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/audio/libasound.hpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/ossia/audio/offline_protocol.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/audio/pipewire_protocol.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/audio/portaudio_protocol.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/audio/pulseaudio_protocol.hpp"
@@ -718,10 +737,12 @@ set(OSSIA_DATAFLOW_HEADERS
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/graph_edge.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/graph_edge_helpers.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/graph_node.hpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/midi_event_buffer.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/midi_port.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/node_chain_process.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/node_process.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/port.hpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/sample_conversion.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/sample_to_float.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/timed_value.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/token_request.hpp"
@@ -759,6 +780,7 @@ set(OSSIA_DATAFLOW_HEADERS
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/nodes/simple_mapper.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/nodes/sine.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/nodes/sound.hpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/nodes/sound_cache.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/nodes/spline.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/nodes/state.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/nodes/step.hpp"
@@ -781,6 +803,7 @@ set(OSSIA_DATAFLOW_HEADERS
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/graph/graph_utils.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/graph/graph_interface.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/graph/node_executors.hpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/graph/replay_capture.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/graph/small_graph.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/graph/tick_methods.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/graph/tick_setup.hpp"
@@ -806,9 +829,12 @@ set(OSSIA_DATAFLOW_SRCS
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/graph_node.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/execution_state.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/nodes/state.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/nodes/sound_cache.cpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/control_inlets.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/sample_conversion.cpp"
 
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/graph/graph.cpp"
+    "${CMAKE_CURRENT_SOURCE_DIR}/ossia/dataflow/graph/replay_capture.cpp"
 )
 
 
@@ -830,10 +856,12 @@ set(OSSIA_EXECLOG_SRCS
 )
 
 set(OSSIA_FFT_HEADERS
+    "${CMAKE_CURRENT_SOURCE_DIR}/ossia/audio/builtin_fft.hpp"
     "${CMAKE_CURRENT_SOURCE_DIR}/ossia/audio/fft.hpp"
 )
 
 set(OSSIA_FFT_SRCS
+  "${CMAKE_CURRENT_SOURCE_DIR}/ossia/audio/builtin_fft.cpp"
   "${CMAKE_CURRENT_SOURCE_DIR}/ossia/audio/fft.cpp"
 )
 
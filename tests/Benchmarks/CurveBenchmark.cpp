@@ -0,0 +1,101 @@
+#include <ossia/editor/curve/curve.hpp>
+#include <ossia/editor/curve/curve_segment/linear.hpp>
+#include <ossia/editor/curve/curve_segment/power.hpp>
+
+#include <benchmark/benchmark.h>
+
+// One automation evaluated at audio rate: one value per sample
+static constexpr int frames = 512;
+
+enum segment_kind
+{
+  linear,
+  power,
+  ease,
+  type_erased
+};
+
+static ossia::curve<double, float> make_curve(segment_kind kind, int points)
+{
+  ossia::curve<double, float> c;
+  c.set_x0(0.);
+  c.set_y0(0.);
+  for(int i = 1; i <= points; i++)
+  {
+    const double x = double(i) / points;
+    const float y = i % 2;
+    switch(kind)
+    {
+      case linear:
+        c.add_point(ossia::curve_segment_linear<float>{}, x, y);
+        break;
+      case power: {
+        ossia::curve_segment_power<float, double> seg;
+        seg.gamma = 2.5;
+        c.add_point(seg, x, y);
+        break;
+      }
+      case ease:
+        c.add_point(
+            ossia::curve_segment_ease<float, ossia::easing::sineInOut>{}, x, y);
+        break;
+      case type_erased:
+        c.add_point(
+            ossia::curve_segment<float>{ossia::curve_segment_linear<float>{}}, x, y);
+        break;
+    }
+  }
+  return c;
+}
+
+// Abscissae of the samples of a tick, somewhere in the middle of the curve
+static std::vector<double> make_abscissae()
+{
+  std::vector<double> xs(frames);
+  for(int i = 0; i < frames; i++)
+    xs[i] = 0.3 + i * (0.01 / frames);
+  return xs;
+}
+
+static void BM_curve_value_at(benchmark::State& state)
+{
+  const auto c = make_curve((segment_kind)state.range(0), state.range(1));
+  const auto xs = make_abscissae();
+  std::vector<float> out(frames);
+
+  for(auto _ : state)
+  {
+    for(int i = 0; i < frames; i++)
+      out[i] = c.value_at(xs[i]);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * frames);
+}
+
+static void BM_curve_values_at(benchmark::State& state)
+{
+  const auto c = make_curve((segment_kind)state.range(0), state.range(1));
+  const auto xs = make_abscissae();
+  std::vector<float> out(frames);
+
+  for(auto _ : state)
+  {
+    c.values_at(xs, out);
+    benchmark::DoNotOptimize(out.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * frames);
+}
+
+static void curve_args(benchmark::internal::Benchmark* b)
+{
+  for(int kind : {linear, power, ease, type_erased})
+    for(int points : {1, 16, 256})
+      b->Args({kind, points});
+}
+
+BENCHMARK(BM_curve_value_at)->Apply(curve_args);
+BENCHMARK(BM_curve_values_at)->Apply(curve_args);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,150 @@
+#include <ossia/audio/builtin_fft.hpp>
+#include <ossia/audio/fft.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <vector>
+
+// ossia::fft and ossia::rfft run on whichever backend the library is built with
+// (FFTW, KFR or the built-in one); builtin_fft_plan is always available,
+// which allows comparing it with FFTW in the same build.
+
+static std::vector<float> make_signal(std::size_t n, float freq)
+{
+  std::vector<float> v(n);
+  for(std::size_t i = 0; i < n; i++)
+    v[i] = std::sin(freq * i) + 0.25f * std::cos(3.1f * freq * i);
+  return v;
+}
+
+static void BM_fft_forward(benchmark::State& state)
+{
+  const std::size_t n = state.range(0);
+  ossia::fft fft{n};
+  auto input = make_signal(n, 0.1f);
+
+  for(auto _ : state)
+  {
+    auto res = fft.execute(input.data(), n);
+    benchmark::DoNotOptimize(res);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void BM_rfft_inverse(benchmark::State& state)
+{
+  const std::size_t n = state.range(0);
+  ossia::fft fft{n};
+  ossia::rfft rfft{n};
+  auto input = make_signal(n, 0.1f);
+  auto spectrum = fft.execute(input.data(), n);
+  std::vector<ossia::fft_real> bins(2 * (n / 2 + 1));
+  std::copy_n(&spectrum[0][0], bins.size(), bins.data());
+
+  for(auto _ : state)
+  {
+    // The inverse transform may overwrite its input
+    std::copy_n(bins.data(), bins.size(), &rfft.input()[0][0]);
+    auto res = rfft.execute();
+    benchmark::DoNotOptimize(res);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+// Eight channels with one plan
+static void BM_fft_forward_batch(benchmark::State& state)
+{
+  static constexpr std::size_t channels = 8;
+  const std::size_t n = state.range(0);
+  ossia::fft fft{n};
+
+  std::vector<std::vector<float>> inputs;
+  std::vector<std::vector<ossia::fft_real>> outputs(channels);
+  std::vector<const float*> in_ptrs;
+  std::vector<ossia::fft_complex*> out_ptrs;
+  for(std::size_t c = 0; c < channels; c++)
+  {
+    inputs.push_back(make_signal(n, 0.01f * (c + 1)));
+    outputs[c].resize(2 * (n / 2 + 1));
+    in_ptrs.push_back(inputs[c].data());
+    out_ptrs.push_back(reinterpret_cast<ossia::fft_complex*>(outputs[c].data()));
+  }
+
+  for(auto _ : state)
+  {
+    fft.execute(in_ptrs.data(), out_ptrs.data(), channels, n);
+    benchmark::DoNotOptimize(out_ptrs.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n * channels);
+}
+
+// Creating a transform once its plan is cached only allocates the buffers
+static void BM_fft_create(benchmark::State& state)
+{
+  const std::size_t n = state.range(0);
+  ossia::fft warmup{n};
+
+  for(auto _ : state)
+  {
+    ossia::fft fft{n};
+    benchmark::DoNotOptimize(fft.input());
+  }
+}
+
+static void BM_builtin_forward(benchmark::State& state)
+{
+  const std::size_t n = state.range(0);
+  ossia::builtin_fft_plan plan{n};
+  std::vector<double> input(n);
+  auto sig = make_signal(n, 0.1f);
+  std::copy_n(sig.data(), n, input.data());
+  std::vector<double> temp(plan.temp_size());
+  std::vector<double> output(2 * (n / 2 + 1));
+
+  for(auto _ : state)
+  {
+    plan.forward(input.data(), (double(*)[2])output.data(), temp.data());
+    benchmark::DoNotOptimize(output.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void BM_builtin_inverse(benchmark::State& state)
+{
+  const std::size_t n = state.range(0);
+  ossia::builtin_fft_plan plan{n};
+  std::vector<double> input(n);
+  auto sig = make_signal(n, 0.1f);
+  std::copy_n(sig.data(), n, input.data());
+  std::vector<double> temp(plan.temp_size());
+  std::vector<double> spectrum(2 * (n / 2 + 1));
+  plan.forward(input.data(), (double(*)[2])spectrum.data(), temp.data());
+
+  for(auto _ : state)
+  {
+    plan.inverse(
+        (const double(*)[2])spectrum.data(), input.data(), temp.data());
+    benchmark::DoNotOptimize(input.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void fft_sizes(benchmark::internal::Benchmark* b)
+{
+  b->RangeMultiplier(2)->Range(64, 16384);
+}
+
+BENCHMARK(BM_fft_forward)->Apply(fft_sizes);
+BENCHMARK(BM_rfft_inverse)->Apply(fft_sizes);
+BENCHMARK(BM_fft_forward_batch)->Apply(fft_sizes);
+BENCHMARK(BM_fft_create)->Apply(fft_sizes);
+BENCHMARK(BM_builtin_forward)->Apply(fft_sizes);
+BENCHMARK(BM_builtin_inverse)->Apply(fft_sizes);
+
+BENCHMARK_MAIN();
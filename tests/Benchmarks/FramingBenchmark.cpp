@@ -0,0 +1,127 @@
+#include <ossia/network/sockets/line_framing.hpp>
+#include <ossia/network/sockets/size_prefix_framing.hpp>
+#include <ossia/network/sockets/slip_framing.hpp>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <thread>
+
+// Measures how many framed messages per second a decoder can extract
+// from a local stream socket.
+namespace
+{
+struct counting_processor
+{
+  std::size_t& count;
+  void operator()(const unsigned char*, std::size_t) const { ++count; }
+  bool validate_stream(boost::system::error_code ec) const
+  {
+    return ec != boost::asio::error::operation_aborted
+           && ec != boost::asio::error::eof;
+  }
+};
+
+template <typename Framing, typename Socket>
+void run_framing_benchmark(
+    benchmark::State& state, boost::asio::io_context& ctx, Socket& writer,
+    Socket& reader)
+{
+  const int message_size = state.range(0);
+  constexpr int messages_per_iteration = 10000;
+  std::string message(message_size, 'x');
+
+  using encoder = typename Framing::template encoder<Socket>;
+  using decoder = typename Framing::template decoder<Socket>;
+
+  decoder dec{reader};
+  if constexpr(requires { dec.delimiter; })
+  {
+    std::strcpy(dec.delimiter, "\r\n");
+  }
+
+  std::size_t received = 0;
+  dec.receive(counting_processor{received});
+
+  for(auto _ : state)
+  {
+    const std::size_t expected = received + messages_per_iteration;
+    std::thread t{[&] {
+      encoder enc{writer};
+      if constexpr(requires { enc.delimiter; })
+      {
+        std::strcpy(enc.delimiter, "\r\n");
+      }
+
+      for(int i = 0; i < messages_per_iteration; i++)
+        enc.write(message.data(), message.size());
+    }};
+
+    while(received < expected)
+      ctx.run_one();
+    t.join();
+  }
+
+  state.SetItemsProcessed(state.iterations() * messages_per_iteration);
+  state.SetBytesProcessed(
+      state.iterations() * messages_per_iteration * int64_t(message_size));
+
+  reader.close();
+  ctx.run();
+}
+
+template <typename Framing>
+void BM_tcp_framing(benchmark::State& state)
+{
+  using proto = boost::asio::ip::tcp;
+  boost::asio::io_context ctx;
+
+  proto::acceptor acceptor{ctx, proto::endpoint{boost::asio::ip::make_address("127.0.0.1"), 0}};
+  proto::socket writer{ctx};
+  proto::socket reader{ctx};
+  writer.connect(acceptor.local_endpoint());
+  acceptor.accept(reader);
+  writer.set_option(proto::no_delay{true});
+
+  run_framing_benchmark<Framing>(state, ctx, writer, reader);
+}
+
+template <typename Framing>
+void BM_unix_framing(benchmark::State& state)
+{
+  using proto = boost::asio::local::stream_protocol;
+  boost::asio::io_context ctx;
+
+  proto::socket writer{ctx};
+  proto::socket reader{ctx};
+  boost::asio::local::connect_pair(writer, reader);
+
+  run_framing_benchmark<Framing>(state, ctx, writer, reader);
+}
+}
+
+BENCHMARK_TEMPLATE(BM_tcp_framing, ossia::net::size_prefix_framing)
+    ->RangeMultiplier(4)
+    ->Range(16, 4096);
+BENCHMARK_TEMPLATE(BM_tcp_framing, ossia::net::slip_framing)
+    ->RangeMultiplier(4)
+    ->Range(16, 4096);
+BENCHMARK_TEMPLATE(BM_tcp_framing, ossia::net::line_framing)
+    ->RangeMultiplier(4)
+    ->Range(16, 4096);
+
+BENCHMARK_TEMPLATE(BM_unix_framing, ossia::net::size_prefix_framing)
+    ->RangeMultiplier(4)
+    ->Range(16, 4096);
+BENCHMARK_TEMPLATE(BM_unix_framing, ossia::net::slip_framing)
+    ->RangeMultiplier(4)
+    ->Range(16, 4096);
+BENCHMARK_TEMPLATE(BM_unix_framing, ossia::net::line_framing)
+    ->RangeMultiplier(4)
+    ->Range(16, 4096);
+
+BENCHMARK_MAIN();
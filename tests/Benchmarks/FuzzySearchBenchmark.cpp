@@ -0,0 +1,91 @@
+#include <ossia/network/base/fuzzysearch_index.hpp>
+#include <ossia/network/base/node_functions.hpp>
+#include <ossia/network/generic/generic_device.hpp>
+
+#include <benchmark/benchmark.h>
+
+// A namespace like the one of a large show: groups of tracks with their controls
+static void make_namespace(ossia::net::generic_device& dev, int nodes)
+{
+  static const char* controls[]
+      = {"Volume", "pan", "mute", "solo", "send.1", "send.2", "filter/cutoff",
+         "filter/resonance", "eq/low", "eq/mid", "eq/high"};
+  int count = 0;
+  for(int g = 0; count < nodes; g++)
+  {
+    auto group = dev.create_child("group." + std::to_string(g));
+    count++;
+    for(int t = 0; t < 64 && count < nodes; t++)
+    {
+      auto track = group->create_child("track." + std::to_string(t));
+      count++;
+      for(auto ctl : controls)
+      {
+        if(count >= nodes)
+          break;
+        ossia::net::create_node(*track, ctl).create_parameter(ossia::val_type::FLOAT);
+        count++;
+      }
+    }
+  }
+}
+
+// What an operator types in the search box, one search per keystroke
+static const std::vector<std::string> keystrokes
+    = {"f", "fi", "fil", "filt", "filte", "filter", "filter/", "filter/c", "filter/cu"};
+
+static void BM_fuzzysearch(benchmark::State& state)
+{
+  ossia::net::generic_device dev{"bench"};
+  make_namespace(dev, state.range(0));
+
+  ossia::net::fuzzysearch_options opt;
+  opt.case_sensitive = false;
+  std::vector<ossia::net::fuzzysearch_result> res;
+  for(auto _ : state)
+  {
+    for(const auto& k : keystrokes)
+    {
+      ossia::net::fuzzysearch({&dev.get_root_node()}, {k}, res, opt);
+      benchmark::DoNotOptimize(res.data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * keystrokes.size());
+}
+
+static void BM_fuzzysearch_index(benchmark::State& state)
+{
+  ossia::net::generic_device dev{"bench"};
+  make_namespace(dev, state.range(0));
+  ossia::net::fuzzysearch_index index{dev};
+
+  ossia::net::fuzzysearch_options opt;
+  opt.case_sensitive = false;
+  opt.max_results = state.range(1);
+  std::vector<ossia::net::fuzzysearch_result> res;
+  for(auto _ : state)
+  {
+    for(const auto& k : keystrokes)
+    {
+      index.search({k}, res, opt);
+      benchmark::DoNotOptimize(res.data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * keystrokes.size());
+}
+
+BENCHMARK(BM_fuzzysearch)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_fuzzysearch_index)
+    ->Args({1000, 0})
+    ->Args({10000, 0})
+    ->Args({100000, 0})
+    ->Args({1000, 20})
+    ->Args({10000, 20})
+    ->Args({100000, 20})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
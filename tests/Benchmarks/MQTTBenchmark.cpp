@@ -0,0 +1,80 @@
+#include <ossia/network/base/node_functions.hpp>
+#include <ossia/network/context.hpp>
+#include <ossia/network/generic/generic_device.hpp>
+#include <ossia/network/generic/generic_parameter.hpp>
+#include <ossia/protocols/mqtt/mqtt_protocol.hpp>
+
+#include <benchmark/benchmark.h>
+
+// Requires a MQTT broker (e.g. mosquitto) running on localhost:1883.
+// Measures the time to deliver one update of every parameter of a device
+// to a mirror subscribing to the same topics.
+static void BM_mqtt_telemetry(benchmark::State& state)
+{
+  using namespace ossia::net;
+  const int num_params = state.range(0);
+  const auto codec = (mqtt5_payload_codec)state.range(1);
+  const int qos = state.range(2);
+
+  auto ctx = std::make_shared<network_context>();
+  mqtt5_configuration conf{tcp_client_configuration{{"127.0.0.1", 1883}}, codec};
+
+  generic_device sender{std::make_unique<mqtt5_protocol>(ctx, conf), "bench"};
+  generic_device receiver{std::make_unique<mqtt5_protocol>(ctx, conf), "bench"};
+
+  std::vector<parameter_base*> sent;
+  std::vector<parameter_base*> received;
+  for(int i = 0; i < num_params; i++)
+  {
+    auto name = "sensor/" + std::to_string(i);
+    auto& s = create_node(sender.get_root_node(), name);
+    set_mqtt_qos(s, qos);
+    auto p = s.create_parameter(ossia::val_type::VEC3F);
+    p->set_access(ossia::access_mode::SET);
+    sent.push_back(p);
+
+    auto& r = create_node(receiver.get_root_node(), name);
+    auto rp = r.create_parameter(ossia::val_type::VEC3F);
+    rp->set_access(ossia::access_mode::GET);
+    received.push_back(rp);
+  }
+
+  // Wait for the connections and subscriptions
+  ctx->context.run_for(std::chrono::seconds(1));
+
+  float t = 0.f;
+  for(auto _ : state)
+  {
+    t += 1.f;
+    const ossia::vec3f v{t, t * 0.5f, t * 0.25f};
+    for(auto p : sent)
+      p->push_value(v);
+
+    // Wait until the mirror has the latest value of every parameter
+    auto all_received = [&] {
+      for(auto p : received)
+        if(p->value() != ossia::value{v})
+          return false;
+      return true;
+    };
+    while(!all_received())
+      ctx->context.run_for(std::chrono::microseconds(100));
+  }
+
+  state.SetItemsProcessed(state.iterations() * num_params);
+
+  sender.get_protocol().stop();
+  receiver.get_protocol().stop();
+}
+
+BENCHMARK(BM_mqtt_telemetry)
+    ->ArgsProduct(
+        {{100, 2000},
+         {(int)ossia::net::mqtt5_payload_codec::text,
+          (int)ossia::net::mqtt5_payload_codec::raw,
+          (int)ossia::net::mqtt5_payload_codec::cbor},
+         {0, 1}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
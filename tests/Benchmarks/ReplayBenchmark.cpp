@@ -0,0 +1,129 @@
+#include <ossia/dataflow/graph/replay_capture.hpp>
+#include <ossia/dataflow/port.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+// Replays the capture given in OSSIA_REPLAY_CAPTURE, or a synthetic one:
+// one iteration is one tick, and the tick-time distribution is given as counters.
+// The nodes of the capture are replaced by nodes which do nothing,
+// hence this measures the cost of the graph and of the inputs.
+static ossia::replay_capture make_capture(int nodes, int ticks)
+{
+  ossia::replay_capture cap;
+  cap.sample_rate = 48000;
+  for(int i = 0; i < nodes; i++)
+  {
+    cap.parameters.push_back(
+        {"bench:/in." + std::to_string(i), ossia::val_type::FLOAT});
+
+    ossia::replay_capture::node n;
+    n.label = "node";
+    n.inlets.push_back({ossia::value_port::which, true, uint32_t(i)});
+    n.inlets.push_back({ossia::value_port::which, false});
+    n.outlets.push_back({ossia::value_port::which, false});
+    cap.nodes.push_back(std::move(n));
+
+    if(i > 0)
+      cap.edges.push_back({uint32_t(i - 1), 0, uint32_t(i), 1});
+  }
+
+  const int64_t frames = 512;
+  for(int t = 0; t < ticks; t++)
+  {
+    ossia::replay_capture::tick tick;
+    tick.frames = frames;
+
+    const ossia::token_request tk{
+        ossia::time_value{frames * t},
+        ossia::time_value{frames * (t + 1)},
+        ossia::time_value{},
+        ossia::time_value{},
+        1.,
+        {},
+        ossia::root_tempo};
+    for(int i = 0; i < nodes; i++)
+    {
+      tick.tokens.push_back({uint32_t(i), tk});
+      if((t + i) % 4 == 0)
+        tick.values.push_back({uint32_t(i), {ossia::value{float(t)}}});
+    }
+    cap.ticks.push_back(std::move(tick));
+  }
+  return cap;
+}
+
+static const ossia::replay_capture& capture()
+{
+  static const ossia::replay_capture cap = [] {
+    if(auto path = std::getenv("OSSIA_REPLAY_CAPTURE"))
+    {
+      std::ifstream f{path, std::ios::binary};
+      try
+      {
+        return ossia::replay_capture::read(f);
+      }
+      catch(const std::exception& e)
+      {
+        std::cerr << path << ": " << e.what() << "\n";
+        std::exit(1);
+      }
+    }
+    return make_capture(64, 1000);
+  }();
+  return cap;
+}
+
+static void BM_replay(benchmark::State& state)
+{
+  using clk = std::chrono::steady_clock;
+  const auto& cap = capture();
+  if(cap.ticks.empty())
+  {
+    state.SkipWithError("empty capture");
+    return;
+  }
+
+  ossia::graph_setup_options opt;
+  opt.scheduling = decltype(opt.scheduling)(state.range(0));
+  ossia::replay_player player{cap, opt};
+
+  std::vector<double> times;
+  times.reserve(cap.ticks.size());
+
+  std::size_t i = 0;
+  for(auto _ : state)
+  {
+    const auto t0 = clk::now();
+    player.tick(i);
+    const double t = std::chrono::duration<double>(clk::now() - t0).count();
+    state.SetIterationTime(t);
+    times.push_back(t);
+
+    if(++i == player.size())
+      i = 0;
+  }
+
+  std::sort(times.begin(), times.end());
+  auto percentile = [&](double p) {
+    return times[std::min(std::size_t(p * times.size()), times.size() - 1)] * 1e6;
+  };
+  state.counters["p50_us"] = percentile(0.5);
+  state.counters["p99_us"] = percentile(0.99);
+  state.counters["max_us"] = times.back() * 1e6;
+  state.counters["nodes"] = cap.nodes.size();
+}
+
+BENCHMARK(BM_replay)
+    ->Arg(ossia::graph_setup_options::StaticFixed)
+    ->Arg(ossia::graph_setup_options::StaticBFS)
+    ->Arg(ossia::graph_setup_options::StaticTC)
+    ->Arg(ossia::graph_setup_options::Dynamic)
+    ->UseManualTime();
+
+BENCHMARK_MAIN();
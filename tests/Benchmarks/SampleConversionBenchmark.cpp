@@ -0,0 +1,142 @@
+#include <ossia/dataflow/float_to_sample.hpp>
+#include <ossia/dataflow/sample_conversion.hpp>
+#include <ossia/dataflow/sample_to_float.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+static constexpr int64_t frames = 512;
+
+using read_fn_t = void (*)(ossia::mutable_audio_span<float>&, void*, int64_t);
+static const read_fn_t reference_readers[]
+    = {ossia::read_u8,  ossia::read_s16, ossia::read_s24,
+       ossia::read_s32, ossia::read_f32, ossia::read_f64};
+
+struct sound_buffers
+{
+  explicit sound_buffers(ossia::sample_format fmt, int channels)
+      : interleaved(frames * channels * ossia::sample_size(fmt))
+      , channels(channels, std::vector<float>(frames))
+  {
+    std::mt19937 rng{1234};
+    std::uniform_int_distribution<int> byte{0, 255};
+    for(auto& b : interleaved)
+      b = byte(rng);
+
+    // Keep floating-point samples in a sensible range
+    if(fmt == ossia::sample_format::f32)
+      for(int64_t i = 0; i < frames * channels; i++)
+        reinterpret_cast<float*>(interleaved.data())[i] = 0.5f;
+    else if(fmt == ossia::sample_format::f64)
+      for(int64_t i = 0; i < frames * channels; i++)
+        reinterpret_cast<double*>(interleaved.data())[i] = 0.5;
+
+    for(auto& c : this->channels)
+      pointers.push_back(c.data());
+  }
+
+  std::vector<uint8_t> interleaved;
+  std::vector<std::vector<float>> channels;
+  std::vector<float*> pointers;
+};
+
+// Per-sample conversion from sample_to_float.hpp
+static void BM_deinterleave_scalar(benchmark::State& state)
+{
+  const auto fmt = (ossia::sample_format)state.range(0);
+  const int channels = state.range(1);
+  sound_buffers buf{fmt, channels};
+
+  ossia::mutable_audio_span<float> span(channels);
+  for(int c = 0; c < channels; c++)
+    span[c] = buf.channels[c];
+
+  const auto read = reference_readers[(int)fmt];
+  for(auto _ : state)
+  {
+    read(span, buf.interleaved.data(), frames);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * frames * channels);
+}
+
+static void BM_deinterleave_simd(benchmark::State& state)
+{
+  const auto fmt = (ossia::sample_format)state.range(0);
+  const int channels = state.range(1);
+  sound_buffers buf{fmt, channels};
+
+  const auto read = ossia::get_deinterleaver(fmt);
+  for(auto _ : state)
+  {
+    read(buf.interleaved.data(), buf.pointers.data(), channels, frames);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * frames * channels);
+}
+
+static void BM_interleave_scalar(benchmark::State& state)
+{
+  const auto fmt = (ossia::sample_format)state.range(0);
+  const int channels = state.range(1);
+  sound_buffers buf{fmt, channels};
+
+  for(auto _ : state)
+  {
+    switch(fmt)
+    {
+      case ossia::sample_format::s16:
+        ossia::interleave<int16_t, 16, 2>(
+            buf.pointers.data(), (int16_t*)buf.interleaved.data(), channels, frames);
+        break;
+      case ossia::sample_format::s24:
+        ossia::interleave<int32_t, 24, 3>(
+            buf.pointers.data(), (int32_t*)buf.interleaved.data(), channels, frames);
+        break;
+      case ossia::sample_format::s32:
+        ossia::interleave<int32_t, 32, 4>(
+            buf.pointers.data(), (int32_t*)buf.interleaved.data(), channels, frames);
+        break;
+      default:
+        break;
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * frames * channels);
+}
+
+static void BM_interleave_simd(benchmark::State& state)
+{
+  const auto fmt = (ossia::sample_format)state.range(0);
+  const int channels = state.range(1);
+  sound_buffers buf{fmt, channels};
+
+  const auto write = ossia::get_interleaver(fmt);
+  for(auto _ : state)
+  {
+    write(buf.pointers.data(), buf.interleaved.data(), channels, frames);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * frames * channels);
+}
+
+#define DEINTERLEAVE_ARGS                                                         \
+  ArgsProduct(                                                                    \
+      {{(int)ossia::sample_format::u8, (int)ossia::sample_format::s16,            \
+        (int)ossia::sample_format::s24, (int)ossia::sample_format::s32,           \
+        (int)ossia::sample_format::f32, (int)ossia::sample_format::f64},          \
+       {1, 2, 8, 64}})
+
+#define INTERLEAVE_ARGS                                                           \
+  ArgsProduct(                                                                    \
+      {{(int)ossia::sample_format::s16, (int)ossia::sample_format::s24,           \
+        (int)ossia::sample_format::s32},                                          \
+       {1, 2, 8, 64}})
+
+BENCHMARK(BM_deinterleave_scalar)->DEINTERLEAVE_ARGS;
+BENCHMARK(BM_deinterleave_simd)->DEINTERLEAVE_ARGS;
+BENCHMARK(BM_interleave_scalar)->INTERLEAVE_ARGS;
+BENCHMARK(BM_interleave_simd)->INTERLEAVE_ARGS;
+
+BENCHMARK_MAIN();
@@ -0,0 +1,117 @@
+#include <ossia/audio/builtin_fft.hpp>
+#include <ossia/detail/math.hpp>
+
+#include "include_catch.hpp"
+
+#include <cmath>
+#include <complex>
+#include <random>
+#include <vector>
+
+using namespace ossia;
+
+namespace
+{
+using bins = std::vector<std::complex<double>>;
+
+bins naive_dft(const std::vector<double>& in)
+{
+  const std::size_t n = in.size();
+  bins out(n / 2 + 1);
+  for(std::size_t k = 0; k < out.size(); k++)
+    for(std::size_t j = 0; j < n; j++)
+      out[k] += in[j] * std::polar(1., -2. * ossia::pi * double(j * k % n) / n);
+  return out;
+}
+
+// The bins past n / 2 are the conjugates of the first ones
+std::vector<double> naive_idft(const bins& in, std::size_t n)
+{
+  std::vector<double> out(n);
+  for(std::size_t j = 0; j < n; j++)
+  {
+    for(std::size_t k = 0; k < n; k++)
+    {
+      const auto x = k < in.size() ? in[k] : std::conj(in[n - k]);
+      out[j] += (x * std::polar(1., 2. * ossia::pi * double(j * k % n) / n)).real();
+    }
+  }
+  return out;
+}
+
+std::vector<double> random_signal(std::size_t n)
+{
+  std::mt19937 gen(n);
+  std::uniform_real_distribution<double> dist(-1., 1.);
+  std::vector<double> s(n);
+  for(auto& x : s)
+    x = dist(gen);
+  return s;
+}
+
+// Bins of a real signal: the imaginary parts of the first one,
+// and of the middle one for even sizes, are zero
+bins random_bins(std::size_t n)
+{
+  const auto re = random_signal(n / 2 + 1);
+  const auto im = random_signal(n / 2 + 2);
+  bins b(n / 2 + 1);
+  for(std::size_t k = 0; k < b.size(); k++)
+    b[k] = {re[k], im[k]};
+  b[0].imag(0.);
+  if(n % 2 == 0)
+    b[n / 2].imag(0.);
+  return b;
+}
+}
+
+TEST_CASE("test_builtin_fft_forward", "test_builtin_fft_forward")
+{
+  for(std::size_t n : {2, 4, 8, 64, 1024, 3, 6, 12, 15, 100})
+  {
+    const builtin_fft_plan plan{n};
+    const auto in = random_signal(n);
+    std::vector<double> out(2 * (n / 2 + 1)), temp(plan.temp_size());
+    plan.forward(in.data(), reinterpret_cast<double(*)[2]>(out.data()), temp.data());
+
+    const auto expected = naive_dft(in);
+    for(std::size_t k = 0; k < expected.size(); k++)
+    {
+      REQUIRE(std::abs(out[2 * k] - expected[k].real()) < 1e-9 * n);
+      REQUIRE(std::abs(out[2 * k + 1] - expected[k].imag()) < 1e-9 * n);
+    }
+  }
+}
+
+TEST_CASE("test_builtin_fft_inverse", "test_builtin_fft_inverse")
+{
+  for(std::size_t n : {2, 4, 8, 64, 1024, 3, 6, 12, 15, 100})
+  {
+    const builtin_fft_plan plan{n};
+    const auto in = random_bins(n);
+    std::vector<double> out(n), temp(plan.temp_size());
+    plan.inverse(
+        reinterpret_cast<const double(*)[2]>(in.data()), out.data(), temp.data());
+
+    const auto expected = naive_idft(in, n);
+    for(std::size_t j = 0; j < n; j++)
+      REQUIRE(std::abs(out[j] - expected[j]) < 1e-9 * n);
+  }
+}
+
+TEST_CASE("test_builtin_fft_round_trip", "test_builtin_fft_round_trip")
+{
+  for(std::size_t n : {16, 4096, 10, 441})
+  {
+    const builtin_fft_plan plan{n};
+    const auto in = random_signal(n);
+    std::vector<double> freq(2 * (n / 2 + 1)), out(n), temp(plan.temp_size());
+    auto bins = reinterpret_cast<double(*)[2]>(freq.data());
+    plan.forward(in.data(), bins, temp.data());
+    plan.inverse(bins, out.data(), temp.data());
+
+    // Neither direction is normalized
+    for(std::size_t j = 0; j < n; j++)
+      REQUIRE(std::abs(out[j] / n - in[j]) < 1e-12 * n);
+  }
+}
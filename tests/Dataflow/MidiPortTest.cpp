@@ -0,0 +1,221 @@
+#include <ossia/dataflow/connection.hpp>
+#include <ossia/dataflow/data_copy.hpp>
+#include <ossia/dataflow/graph/tick_methods.hpp>
+#include <ossia/dataflow/midi_port.hpp>
+#include <ossia/dataflow/nodes/midi.hpp>
+
+#include "include_catch.hpp"
+
+using namespace ossia;
+
+static libremidi::message make_message(std::vector<unsigned char> bytes, int64_t ts)
+{
+  libremidi::message m;
+  m.bytes.assign(bytes.begin(), bytes.end());
+  m.timestamp = ts;
+  return m;
+}
+
+namespace
+{
+// Writes two control changes as messages in the first tick
+struct message_source final : ossia::graph_node
+{
+  bool done{};
+  message_source() { m_outlets.push_back(new ossia::midi_outlet); }
+
+  std::string label() const noexcept override { return "message_source"; }
+  void run(const ossia::token_request&, ossia::exec_state_facade) noexcept override
+  {
+    if(std::exchange(done, true))
+      return;
+    auto& mp = *m_outlets[0]->target<ossia::midi_port>();
+    mp.control_change(1, 7, 100).timestamp = 5;
+    mp.control_change(1, 7, 50).timestamp = 40;
+  }
+};
+
+// Records the timestamp and status of what it receives
+struct midi_sink final : ossia::graph_node
+{
+  std::vector<std::pair<int64_t, int>> messages, events;
+  explicit midi_sink(bool compact)
+  {
+    auto in = new ossia::midi_inlet;
+    (*in)->compact = compact;
+    m_inlets.push_back(in);
+  }
+
+  std::string label() const noexcept override { return "midi_sink"; }
+  void run(const ossia::token_request&, ossia::exec_state_facade) noexcept override
+  {
+    auto& mp = *m_inlets[0]->target<ossia::midi_port>();
+    for(auto& m : mp.messages)
+      messages.emplace_back(m.timestamp, m.bytes[0] & 0xF0);
+    for(auto& e : mp.events)
+      events.emplace_back(e.timestamp, e.status() & 0xF0);
+  }
+};
+
+std::shared_ptr<ossia::nodes::midi> make_midi_node()
+{
+  auto n = std::make_shared<ossia::nodes::midi>(1);
+  n->set_channel(1);
+  ossia::nodes::midi::note_set notes;
+  notes.insert(ossia::nodes::note_data{10_tv, 100_tv, 60, 100});
+  n->set_notes(std::move(notes));
+  return n;
+}
+
+void connect_midi(
+    ossia::graph_interface& g, const ossia::node_ptr& out, const ossia::node_ptr& in)
+{
+  g.connect(g.allocate_edge(
+      ossia::immediate_glutton_connection{}, out->root_outputs()[0],
+      in->root_inputs()[0], out, in));
+}
+}
+
+TEST_CASE("test_midi_event_buffer", "test_midi_event_buffer")
+{
+  midi_event_buffer buf;
+  buf.push_back(make_message({0x91, 60, 100}, 12));
+  buf.push_back(make_message({0xC2, 5}, 13));
+  buf.push_back(make_message({0xF8}, 14));
+  buf.push_back(make_message({0xF0, 0x7E, 0x01, 0x02, 0xF7}, 15));
+
+  REQUIRE(buf.size() == 4);
+  REQUIRE(!buf[0].is_raw());
+  REQUIRE(buf[0].status() == 0x91);
+  REQUIRE(buf[0].channel() == 2);
+  REQUIRE(buf[0].data1() == 60);
+  REQUIRE(buf[0].data2() == 100);
+  REQUIRE((buf[0].word >> 28) == midi_event::ump_channel_voice);
+  REQUIRE((buf[2].word >> 28) == midi_event::ump_system);
+  REQUIRE(buf[3].is_raw());
+  REQUIRE(buf.raw(buf[3]).size() == 5);
+
+  // The round-trip through libremidi::message is lossless
+  value_vector<libremidi::message> msgs;
+  buf.append_to(msgs);
+  REQUIRE(msgs.size() == 4);
+  REQUIRE(msgs[0].bytes == make_message({0x91, 60, 100}, 0).bytes);
+  REQUIRE(msgs[1].bytes == make_message({0xC2, 5}, 0).bytes);
+  REQUIRE(msgs[2].bytes == make_message({0xF8}, 0).bytes);
+  REQUIRE(msgs[3].bytes == make_message({0xF0, 0x7E, 0x01, 0x02, 0xF7}, 0).bytes);
+  REQUIRE(msgs[3].timestamp == 15);
+
+  // Sysex offsets are kept valid when appending
+  midi_event_buffer other;
+  other.push_back(make_message({0xF0, 0x01, 0xF7}, 0));
+  other.append(buf);
+  REQUIRE(other.size() == 5);
+  REQUIRE(other.to_message(other[4]).bytes == msgs[3].bytes);
+}
+
+TEST_CASE("test_midi_port_compact", "test_midi_port_compact")
+{
+  midi_port out;
+  out.note_on(1, 64, 127);
+  out.events.push_back(3, 0x80, 64, 0);
+
+  // A port which reads messages gets everything as messages
+  midi_port in;
+  copy_data{}(out, in);
+  REQUIRE(in.messages.size() == 2);
+  REQUIRE(in.events.empty());
+
+  // A compact port gets everything as events
+  midi_port compact_in;
+  compact_in.compact = true;
+  copy_data{}(out, compact_in);
+  REQUIRE(compact_in.messages.empty());
+  REQUIRE(compact_in.events.size() == 2);
+  REQUIRE(compact_in.events[1].timestamp == 3);
+
+  midi_port moved_in;
+  moved_in.compact = true;
+  move_data{}(out, moved_in);
+  REQUIRE(moved_in.messages.empty());
+  REQUIRE(moved_in.events.size() == 2);
+
+  clear_data{}(moved_in);
+  REQUIRE(moved_in.empty());
+}
+
+TEST_CASE("test_midi_port_graph", "test_midi_port_graph")
+{
+  using events = std::vector<std::pair<int64_t, int>>;
+  execution_state st;
+  auto g = make_graph({});
+
+  // The midi node writes compact events
+  auto notes = make_midi_node();
+  auto source = std::make_shared<message_source>();
+  auto compact_sink = std::make_shared<midi_sink>(true);
+  auto sink = std::make_shared<midi_sink>(false);
+  g->add_node(notes);
+  g->add_node(source);
+  g->add_node(compact_sink);
+  g->add_node(sink);
+  connect_midi(*g, notes, compact_sink);
+  connect_midi(*g, source, compact_sink);
+  connect_midi(*g, notes, sink);
+
+  // A second graph where the data is moved instead of copied
+  auto moved_notes = make_midi_node();
+  auto moved_sink = std::make_shared<midi_sink>(true);
+  auto g2 = make_graph({});
+  g2->add_node(moved_notes);
+  g2->add_node(moved_sink);
+  connect_midi(*g2, moved_notes, moved_sink);
+
+  execution_state st2;
+  for(int i = 0; i < 2; i++)
+  {
+    tick_all_nodes{st, *g}(64, 0.);
+    tick_all_nodes{st2, *g2}(64, 0.);
+  }
+
+  // Events and messages are merged by timestamp
+  REQUIRE(compact_sink->messages.empty());
+  REQUIRE(compact_sink->events == events{{5, 0xB0}, {10, 0x90}, {40, 0xB0}, {46, 0x80}});
+
+  // Inlets which read messages get messages
+  REQUIRE(sink->events.empty());
+  REQUIRE(sink->messages == events{{10, 0x90}, {46, 0x80}});
+
+  REQUIRE(moved_sink->messages.empty());
+  REQUIRE(moved_sink->events == events{{10, 0x90}, {46, 0x80}});
+}
+
+TEST_CASE("test_midi_port_merge", "test_midi_port_merge")
+{
+  midi_port out;
+  out.note_on(1, 64, 127).timestamp = 20;
+  out.events.push_back(3, 0x80, 64, 0);
+  out.events.push_back(30, 0x80, 65, 0);
+
+  // Messages and events are merged by timestamp, in both directions
+  midi_port in;
+  in.append(out);
+  REQUIRE(in.messages.size() == 3);
+  REQUIRE(in.messages[0].timestamp == 3);
+  REQUIRE(in.messages[1].timestamp == 20);
+  REQUIRE(in.messages[2].timestamp == 30);
+
+  midi_port compact_in;
+  compact_in.compact = true;
+  compact_in.append(out);
+  REQUIRE(compact_in.events.size() == 3);
+  REQUIRE(compact_in.events[0].timestamp == 3);
+  REQUIRE(compact_in.events[1].timestamp == 20);
+  REQUIRE(compact_in.events[2].timestamp == 30);
+
+  midi_port moved = out;
+  moved.normalize();
+  REQUIRE(moved.events.empty());
+  REQUIRE(moved.messages.size() == 3);
+  REQUIRE(moved.messages[0].timestamp == 3);
+  REQUIRE(moved.messages[2].timestamp == 30);
+}
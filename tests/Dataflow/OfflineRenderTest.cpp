@@ -0,0 +1,208 @@
+#include <ossia/audio/offline_protocol.hpp>
+#include <ossia/dataflow/connection.hpp>
+#include <ossia/dataflow/graph/tick_methods.hpp>
+#include <ossia/dataflow/node_process.hpp>
+#include <ossia/dataflow/nodes/rand_float.hpp>
+#include <ossia/detail/flicks.hpp>
+#include <ossia/editor/expression/expression.hpp>
+#include <ossia/editor/scenario/time_event.hpp>
+#include <ossia/editor/scenario/time_sync.hpp>
+
+#include "include_catch.hpp"
+
+#include <random>
+
+using namespace ossia;
+
+namespace
+{
+// Records the first output channel of every tick
+struct recorder
+{
+  std::mt19937 gen;
+  std::vector<float> samples;
+  std::vector<double> times;
+};
+
+std::shared_ptr<void> setup_recorder(offline_engine& e, const offline_render_job& job)
+{
+  auto rec = std::make_shared<recorder>();
+  rec->gen.seed(job.seed);
+  e.set_tick([r = rec.get()](const ossia::audio_tick_state& st) {
+    std::uniform_real_distribution<float> dist(-1.f, 1.f);
+    for(std::size_t i = 0; i < st.frames; i++)
+    {
+      st.outputs[0][i] = dist(r->gen);
+      r->samples.push_back(st.outputs[0][i]);
+    }
+    r->times.push_back(st.seconds);
+  });
+  return rec;
+}
+
+// Keeps the values it receives
+struct value_sink final : ossia::graph_node
+{
+  std::vector<float> received;
+  value_sink() { m_inlets.push_back(new ossia::value_inlet); }
+
+  std::string label() const noexcept override { return "value_sink"; }
+  void run(const ossia::token_request&, ossia::exec_state_facade) noexcept override
+  {
+    for(auto& v : m_inlets[0]->target<ossia::value_port>()->get_data())
+      received.push_back(v.value.get<float>());
+  }
+};
+
+// A scenario with an interval playing a seeded rand_float connected to a
+// value_sink, ticked with buffer_tick. The latest random value is written to
+// the first output channel.
+struct rand_session
+{
+  ossia::execution_state st;
+  std::shared_ptr<ossia::graph_interface> g = ossia::make_graph({});
+  std::shared_ptr<ossia::scenario> scenar = std::make_shared<ossia::scenario>();
+  std::shared_ptr<ossia::nodes::rand_float> rand
+      = std::make_shared<ossia::nodes::rand_float>(-1.f, 1.f);
+  std::shared_ptr<value_sink> sink = std::make_shared<value_sink>();
+  std::vector<float> samples;
+
+  explicit rand_session(const offline_render_job& job)
+  {
+    st.sampleRate = job.rate;
+    st.samplesToModelRatio = ossia::flicks_per_second<double> / job.rate;
+    st.modelToSamplesRatio = 1. / st.samplesToModelRatio;
+    rand->seed(job.seed);
+
+    auto& start = *scenar->get_start_time_sync();
+    auto e0 = std::make_shared<time_event>(
+        time_event::exec_callback{}, start, expressions::make_expression_true());
+    start.insert(start.get_time_events().end(), e0);
+
+    auto end = std::make_shared<time_sync>();
+    scenar->add_time_sync(end);
+    auto e1 = std::make_shared<time_event>(
+        time_event::exec_callback{}, *end, expressions::make_expression_true());
+    end->insert(end->get_time_events().end(), e1);
+
+    const time_value dur{100 * ossia::flicks_per_second<int64_t>};
+    auto itv = time_interval::create({}, *e0, *e1, dur, dur, dur);
+    itv->add_time_process(std::make_shared<node_process>(rand));
+    itv->add_time_process(std::make_shared<node_process>(sink));
+    scenar->add_time_interval(itv);
+
+    for(auto& n : {scenar->node, itv->node})
+      if(n)
+        g->add_node(n);
+    g->add_node(rand);
+    g->add_node(sink);
+    g->connect(g->allocate_edge(
+        immediate_glutton_connection{}, &rand->value_out, sink->root_inputs()[0], rand,
+        sink));
+
+    scenar->start();
+  }
+};
+
+std::shared_ptr<void> setup_rand_session(offline_engine& e, const offline_render_job& job)
+{
+  auto s = std::make_shared<rand_session>(job);
+  e.set_tick([s = s.get()](const ossia::audio_tick_state& st) {
+    buffer_tick{s->st, *s->g, *s->scenar, {}}(st);
+    const float v = s->sink->received.empty() ? 0.f : s->sink->received.back();
+    for(std::size_t i = 0; i < st.frames; i++)
+    {
+      st.outputs[0][i] = v;
+      s->samples.push_back(v);
+    }
+  });
+  return s;
+}
+}
+
+TEST_CASE("test_offline_render", "test_offline_render")
+{
+  offline_render_job job;
+  job.rate = 1000;
+  job.buffer_size = 64;
+  job.frames = 1000;
+  job.seed = 1234;
+
+  std::shared_ptr<void> ctx;
+  job.setup = [&](offline_engine& e, const offline_render_job& j) {
+    return ctx = setup_recorder(e, j);
+  };
+  render_offline(job);
+
+  auto& rec = *static_cast<recorder*>(ctx.get());
+  REQUIRE(job.stats.frames == 1000);
+  REQUIRE(job.stats.duration == 1.);
+  REQUIRE(rec.samples.size() == 1000);
+
+  // The transport time follows the rendered frames, and the last buffer is partial
+  REQUIRE(rec.times.size() == 16);
+  REQUIRE(rec.times[0] == 0.);
+  REQUIRE(rec.times[1] == 0.064);
+  REQUIRE(rec.times[15] == 0.960);
+}
+
+TEST_CASE("test_offline_render_parallel", "test_offline_render_parallel")
+{
+  static constexpr int n = 8;
+  std::vector<offline_render_job> jobs(n);
+  std::vector<std::shared_ptr<void>> contexts(n);
+  for(int i = 0; i < n; i++)
+  {
+    jobs[i].frames = 10000;
+    jobs[i].buffer_size = 128;
+    jobs[i].outputs = 1;
+    jobs[i].seed = i % 2;
+    jobs[i].setup = [&contexts, i](offline_engine& e, const offline_render_job& j) {
+      return contexts[i] = setup_recorder(e, j);
+    };
+  }
+
+  render_offline(jobs, 4);
+
+  // The same seed gives the same render, whatever the thread
+  for(int i = 0; i < n; i++)
+  {
+    REQUIRE(jobs[i].stats.frames == 10000);
+    REQUIRE(jobs[i].stats.realtime_factor() > 0.);
+    auto& a = static_cast<recorder*>(contexts[i].get())->samples;
+    auto& b = static_cast<recorder*>(contexts[i % 2].get())->samples;
+    REQUIRE(a == b);
+  }
+  REQUIRE(
+      static_cast<recorder*>(contexts[0].get())->samples
+      != static_cast<recorder*>(contexts[1].get())->samples);
+}
+
+TEST_CASE("test_offline_render_graph", "test_offline_render_graph")
+{
+  auto render = [](uint64_t seed) {
+    offline_render_job job;
+    job.rate = 1000;
+    job.buffer_size = 64;
+    job.frames = 1000;
+    job.seed = seed;
+
+    std::shared_ptr<void> ctx;
+    job.setup = [&](offline_engine& e, const offline_render_job& j) {
+      return ctx = setup_rand_session(e, j);
+    };
+    render_offline(job);
+
+    auto& s = *static_cast<rand_session*>(ctx.get());
+    REQUIRE(s.sink->received.size() == 16);
+    REQUIRE(s.samples.size() == 1000);
+    return s.samples;
+  };
+
+  // A graph with a seeded random node renders the same output every time
+  const auto a = render(1234);
+  const auto b = render(1234);
+  REQUIRE(a == b);
+  REQUIRE(a.front() != a.back());
+  REQUIRE(render(4321) != a);
+}
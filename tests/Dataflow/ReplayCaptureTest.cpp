@@ -0,0 +1,237 @@
+#include <ossia/dataflow/execution_state.hpp>
+#include <ossia/dataflow/graph/replay_capture.hpp>
+#include <ossia/dataflow/graph_edge.hpp>
+#include <ossia/dataflow/graph_node.hpp>
+#include <ossia/dataflow/port.hpp>
+#include <ossia/network/exceptions.hpp>
+#include <ossia/network/generic/generic_device.hpp>
+#include <ossia/network/generic/generic_parameter.hpp>
+#include <ossia/network/value/value_conversion.hpp>
+
+#include "include_catch.hpp"
+
+#include <sstream>
+
+using namespace ossia;
+
+namespace
+{
+// Sums what it receives, and writes the sum plus the date of the token
+class sum_node final : public ossia::graph_node
+{
+public:
+  std::vector<float> received;
+
+  sum_node()
+  {
+    auto event = new value_inlet;
+    (*event)->is_event = true;
+    m_inlets.push_back(event);
+    m_inlets.push_back(new value_inlet);
+    m_outlets.push_back(new value_outlet);
+  }
+
+  std::string label() const noexcept override { return "sum"; }
+
+  void run(const token_request& t, exec_state_facade) noexcept override
+  {
+    float sum = 0.f;
+    for(auto in : m_inlets)
+      for(auto& v : in->target<value_port>()->get_data())
+        sum += ossia::convert<float>(v.value);
+    received.push_back(sum);
+
+    m_outlets[0]->target<value_port>()->write_value(sum + float(t.date.impl), 0);
+  }
+};
+
+struct recorded_session
+{
+  ossia::net::generic_device dev{"test"};
+  ossia::net::parameter_base* in{};
+  ossia::net::parameter_base* ctl{};
+  ossia::net::parameter_base* out{};
+
+  ossia::execution_state e;
+  std::shared_ptr<replay_recorder> rec;
+  std::shared_ptr<sum_node> a = std::make_shared<sum_node>();
+  std::shared_ptr<sum_node> b = std::make_shared<sum_node>();
+
+  recorded_session(const graph_setup_options& opt)
+      : rec{std::make_shared<replay_recorder>(make_graph(opt))}
+  {
+    in = dev.create_child("in")->create_parameter(val_type::FLOAT);
+    ctl = dev.create_child("ctl")->create_parameter(val_type::FLOAT);
+    out = dev.create_child("out")->create_parameter(val_type::FLOAT);
+    e.register_device(&dev);
+    e.apply_device_changes();
+
+    a->root_inputs()[0]->address = in;
+    e.register_port(*a->root_inputs()[0]);
+    a->root_inputs()[1]->address = ctl;
+    b->root_outputs()[0]->address = out;
+
+    rec->add_node(a);
+    rec->add_node(b);
+    rec->connect(rec->allocate_edge(
+        immediate_glutton_connection{}, a->root_outputs()[0], b->root_inputs()[0], a,
+        b));
+  }
+
+  void tick(int i)
+  {
+    in->push_value(float(i));
+    if(i % 2)
+      in->push_value(0.5f);
+    if(i % 3 == 0)
+      ctl->push_value(10.f * i);
+
+    e.begin_tick();
+    e.bufferSize = 64;
+    e.samples_since_start += 64;
+
+    const token_request tk{
+        time_value{64 * i}, time_value{64 * (i + 1)}, 0_tv, 0_tv, 1., {},
+        ossia::root_tempo};
+    a->request(tk);
+    b->request(tk);
+
+    rec->state(e);
+    e.commit();
+  }
+};
+}
+
+TEST_CASE("test_replay_capture", "test_replay_capture")
+{
+  graph_setup_options opt;
+  recorded_session s{opt};
+
+  // Not recorded
+  s.tick(0);
+
+  s.rec->start();
+  for(int i = 1; i < 9; i++)
+    s.tick(i);
+  s.rec->stop();
+  s.tick(9);
+
+  auto& cap = s.rec->capture();
+  REQUIRE(cap.nodes.size() == 2);
+  REQUIRE(cap.edges.size() == 1);
+  REQUIRE(cap.parameters.size() == 3);
+  REQUIRE(cap.ticks.size() == 8);
+  REQUIRE(cap.ticks[0].tokens.size() == 2);
+  REQUIRE(cap.ticks[0].frames == 64);
+
+  std::stringstream ss;
+  cap.write(ss);
+  const auto copy = replay_capture::read(ss);
+  REQUIRE(copy.ticks.size() == cap.ticks.size());
+  REQUIRE(copy.parameters[0].address == cap.parameters[0].address);
+  for(std::size_t i = 0; i < cap.ticks.size(); i++)
+  {
+    REQUIRE(copy.ticks[i].tokens.size() == cap.ticks[i].tokens.size());
+    REQUIRE(copy.ticks[i].tokens[0].request == cap.ticks[i].tokens[0].request);
+    REQUIRE(copy.ticks[i].values.size() == cap.ticks[i].values.size());
+    for(std::size_t k = 0; k < cap.ticks[i].values.size(); k++)
+      REQUIRE(copy.ticks[i].values[k].values == cap.ticks[i].values[k].values);
+  }
+
+  // The replayed nodes receive the same values and tokens
+  std::vector<sum_node*> nodes;
+  replay_player player{
+      copy, opt, [&](const replay_capture::node&, const execution_state&) {
+    auto node = std::make_shared<sum_node>();
+    nodes.push_back(node.get());
+    return node;
+  }};
+  REQUIRE(player.placeholders() == 0);
+  REQUIRE(nodes.size() == 2);
+
+  for(std::size_t i = 0; i < player.size(); i++)
+    player.tick(i);
+
+  // Without the first and last ticks, which were not recorded
+  auto recorded = [](const std::vector<float>& v) {
+    return std::vector<float>(v.begin() + 1, v.end() - 1);
+  };
+  REQUIRE(nodes[0]->received == recorded(s.a->received));
+  REQUIRE(nodes[1]->received == recorded(s.b->received));
+}
+
+TEST_CASE("test_replay_capture_placeholders", "test_replay_capture_placeholders")
+{
+  graph_setup_options opt;
+  recorded_session s{opt};
+  s.rec->start();
+  for(int i = 0; i < 4; i++)
+    s.tick(i);
+  s.rec->stop();
+
+  std::stringstream ss;
+  s.rec->capture().write(ss);
+  const auto bytes = ss.str();
+
+  // Unknown nodes are replaced by nodes with the same ports
+  std::stringstream in{bytes};
+  const auto copy = replay_capture::read(in);
+  replay_player player{copy, opt};
+  REQUIRE(player.placeholders() == 2);
+  REQUIRE(player.nodes()[0]->root_inputs().size() == 2);
+  for(std::size_t i = 0; i < player.size(); i++)
+    player.tick(i);
+
+  std::stringstream truncated{bytes.substr(0, bytes.size() / 2)};
+  REQUIRE_THROWS(replay_capture::read(truncated));
+
+  std::stringstream garbage{std::string(64, 'x')};
+  REQUIRE_THROWS(replay_capture::read(garbage));
+}
+
+TEST_CASE("test_replay_capture_nesting", "test_replay_capture_nesting")
+{
+  auto nested = [](int depth) {
+    ossia::value v{1.f};
+    for(int i = 0; i < depth; i++)
+      v = std::vector<ossia::value>{std::move(v)};
+    return v;
+  };
+  auto write = [](const ossia::value& v) {
+    replay_capture c;
+    c.parameters.push_back({"test:/a", val_type::LIST});
+    c.ticks.emplace_back().values.push_back({0, {v}});
+    std::stringstream ss;
+    c.write(ss);
+    return ss.str();
+  };
+
+  {
+    std::stringstream in{write(nested(8))};
+    const auto c = replay_capture::read(in);
+    REQUIRE(c.ticks[0].values[0].values[0] == nested(8));
+  }
+
+  // A corrupted capture cannot exhaust the stack
+  std::stringstream in{write(nested(1000))};
+  REQUIRE_THROWS_AS(replay_capture::read(in), ossia::parse_error);
+}
+
+TEST_CASE("test_replay_capture_temporary", "test_replay_capture_temporary")
+{
+  graph_setup_options opt;
+  recorded_session s{opt};
+  s.rec->start();
+  for(int i = 0; i < 4; i++)
+    s.tick(i);
+  s.rec->stop();
+
+  std::stringstream ss;
+  s.rec->capture().write(ss);
+
+  // The player keeps its own copy of the capture
+  replay_player player{replay_capture::read(ss), opt};
+  REQUIRE(player.size() == 4);
+  for(std::size_t i = 0; i < player.size(); i++)
+    player.tick(i);
+}
@@ -0,0 +1,108 @@
+#include <ossia/dataflow/sample_conversion.hpp>
+#include <ossia/dataflow/sample_to_float.hpp>
+
+#include "include_catch.hpp"
+
+#include <random>
+
+using read_fn_t = void (*)(ossia::mutable_audio_span<float>&, void*, int64_t);
+
+static void check_deinterleave(ossia::sample_format fmt, read_fn_t reference)
+{
+  std::mt19937 rng{1234};
+  std::uniform_int_distribution<int> byte{0, 255};
+  std::uniform_real_distribution<double> flt{-1., 1.};
+
+  for(int channels : {1, 2, 3, 8, 64})
+  {
+    for(int frames : {0, 1, 7, 33, 1000, 4099})
+    {
+      const int n = channels * frames;
+      std::vector<uint8_t> data(n * ossia::sample_size(fmt) + 16);
+      if(fmt == ossia::sample_format::f32)
+        for(int i = 0; i < n; i++)
+          reinterpret_cast<float*>(data.data())[i] = flt(rng);
+      else if(fmt == ossia::sample_format::f64)
+        for(int i = 0; i < n; i++)
+          reinterpret_cast<double*>(data.data())[i] = flt(rng);
+      else
+        for(auto& b : data)
+          b = byte(rng);
+
+      std::vector<std::vector<float>> expected(channels, std::vector<float>(frames));
+      std::vector<std::vector<float>> actual(channels, std::vector<float>(frames));
+      ossia::mutable_audio_span<float> expected_span(channels);
+      std::vector<float*> actual_ptrs(channels);
+      for(int c = 0; c < channels; c++)
+      {
+        expected_span[c] = expected[c];
+        actual_ptrs[c] = actual[c].data();
+      }
+
+      reference(expected_span, data.data(), frames);
+      ossia::get_deinterleaver(fmt)(data.data(), actual_ptrs.data(), channels, frames);
+      REQUIRE(expected == actual);
+    }
+  }
+}
+
+TEST_CASE("test_deinterleave", "test_deinterleave")
+{
+  check_deinterleave(ossia::sample_format::u8, ossia::read_u8);
+  check_deinterleave(ossia::sample_format::s16, ossia::read_s16);
+  check_deinterleave(ossia::sample_format::s24, ossia::read_s24);
+  check_deinterleave(ossia::sample_format::s32, ossia::read_s32);
+  check_deinterleave(ossia::sample_format::f32, ossia::read_f32);
+  check_deinterleave(ossia::sample_format::f64, ossia::read_f64);
+}
+
+TEST_CASE("test_interleave_roundtrip", "test_interleave_roundtrip")
+{
+  using fmt = ossia::sample_format;
+  for(auto [format, precision] :
+      {std::pair{fmt::u8, 1e-2f}, std::pair{fmt::s16, 1e-4f}, std::pair{fmt::s24, 1e-6f},
+       std::pair{fmt::s32, 1e-7f}, std::pair{fmt::f32, 0.f}, std::pair{fmt::f64, 0.f}})
+  {
+    for(int channels : {1, 2, 5})
+    {
+      const int frames = 1031;
+      std::vector<std::vector<float>> in(channels, std::vector<float>(frames));
+      std::vector<std::vector<float>> out(channels, std::vector<float>(frames));
+      std::vector<const float*> in_ptrs(channels);
+      std::vector<float*> out_ptrs(channels);
+      for(int c = 0; c < channels; c++)
+      {
+        for(int k = 0; k < frames; k++)
+          in[c][k] = std::sin(k * 0.01f + c) * 0.99f;
+        in_ptrs[c] = in[c].data();
+        out_ptrs[c] = out[c].data();
+      }
+
+      std::vector<uint8_t> data(frames * channels * ossia::sample_size(format));
+      ossia::get_interleaver(format)(in_ptrs.data(), data.data(), channels, frames);
+      ossia::get_deinterleaver(format)(data.data(), out_ptrs.data(), channels, frames);
+
+      for(int c = 0; c < channels; c++)
+        for(int k = 0; k < frames; k++)
+          REQUIRE(std::abs(in[c][k] - out[c][k]) <= precision);
+    }
+  }
+}
+
+TEST_CASE("test_interleave_saturation", "test_interleave_saturation")
+{
+  const float in[4] = {-2.f, -1.f, 1.f, 2.f};
+  const float* ptr = in;
+
+  int16_t s16[4];
+  ossia::get_interleaver(ossia::sample_format::s16)(&ptr, s16, 1, 4);
+  REQUIRE(s16[0] == -32768);
+  REQUIRE(s16[3] == 32767);
+
+  int32_t s32[4];
+  ossia::get_interleaver(ossia::sample_format::s32)(&ptr, s32, 1, 4);
+  REQUIRE(s32[0] == INT32_MIN);
+  REQUIRE(s32[1] == INT32_MIN);
+  REQUIRE(s32[2] == INT32_MAX);
+  REQUIRE(s32[3] == INT32_MAX);
+}
@@ -0,0 +1,105 @@
+#include <ossia/dataflow/nodes/sound_cache.hpp>
+#include <ossia/dataflow/nodes/sound_ref.hpp>
+
+#include "include_catch.hpp"
+
+#include <atomic>
+
+static ossia::audio_handle make_sound(std::size_t channels, std::size_t frames)
+{
+  auto d = std::make_shared<ossia::audio_data>();
+  d->data.resize(channels);
+  for(auto& chan : d->data)
+    chan.resize(frames, 0.5f);
+  d->rate = 44100;
+  return d;
+}
+
+TEST_CASE("test_sound_cache_shared", "test_sound_cache_shared")
+{
+  ossia::sound_cache cache;
+  int decodes = 0;
+  auto load = [&](const ossia::sound_cache_key&) {
+    decodes++;
+    return make_sound(8, 1000);
+  };
+
+  auto a = cache.get({"foo.wav"}, load);
+  auto b = cache.get({"foo.wav"}, load);
+  REQUIRE(a);
+  REQUIRE(a == b);
+  REQUIRE(decodes == 1);
+  REQUIRE(cache.memory_usage() == 8 * 1000 * sizeof(ossia::audio_sample));
+
+  // Different decoding parameters are different entries
+  auto c = cache.get({"foo.wav", 48000}, load);
+  REQUIRE(c != a);
+  REQUIRE(decodes == 2);
+}
+
+TEST_CASE("test_sound_cache_budget", "test_sound_cache_budget")
+{
+  constexpr std::size_t sound_size = 1000 * sizeof(ossia::audio_sample);
+  ossia::sound_cache cache{2 * sound_size};
+  int decodes = 0;
+  auto load = [&](const ossia::sound_cache_key&) {
+    decodes++;
+    return make_sound(1, 1000);
+  };
+
+  // Used sounds are never released
+  auto a = cache.get({"a.wav"}, load);
+  cache.get({"b.wav"}, load);
+  cache.get({"c.wav"}, load);
+  REQUIRE(decodes == 3);
+  REQUIRE(cache.memory_usage() == 2 * sound_size);
+  REQUIRE(cache.find({"a.wav"}) == a);
+  REQUIRE(!cache.find({"b.wav"}));
+  REQUIRE(cache.find({"c.wav"}));
+
+  // Once released, a is the least recently used
+  a.reset();
+  cache.get({"d.wav"}, load);
+  REQUIRE(!cache.find({"a.wav"}));
+  REQUIRE(cache.find({"c.wav"}));
+  REQUIRE(cache.find({"d.wav"}));
+
+  cache.clear_unused();
+  REQUIRE(cache.memory_usage() == 0);
+}
+
+TEST_CASE("test_sound_cache_request", "test_sound_cache_request")
+{
+  ossia::sound_cache cache;
+  std::promise<ossia::audio_handle> loaded;
+  cache.request(
+      {"foo.wav"}, [](const ossia::sound_cache_key&) { return make_sound(2, 10); },
+      [&](ossia::audio_handle h) { loaded.set_value(std::move(h)); });
+
+  auto h = loaded.get_future().get();
+  REQUIRE(h);
+  REQUIRE(h->data.size() == 2);
+  REQUIRE(cache.find({"foo.wav"}) == h);
+}
+
+TEST_CASE("test_sound_cache_nodes", "test_sound_cache_nodes")
+{
+  ossia::sound_cache cache;
+  int decodes = 0;
+  auto load = [&](const ossia::sound_cache_key&) {
+    decodes++;
+    return make_sound(2, 1000);
+  };
+
+  ossia::nodes::sound_ref a, b;
+  a.load_sound({"foo.wav"}, load, cache);
+  b.load_sound({"foo.wav"}, load, cache);
+  REQUIRE(decodes == 1);
+  REQUIRE(a.m_sampler.channels() == 2);
+  REQUIRE(a.m_sampler.duration() == 1000);
+
+  // Both nodes read from the same buffer
+  REQUIRE(a.m_sampler.m_handle == b.m_sampler.m_handle);
+  REQUIRE(a.m_sampler.m_handle == cache.find({"foo.wav"}));
+  REQUIRE(cache.memory_usage() == 2 * 1000 * sizeof(ossia::audio_sample));
+}
@@ -0,0 +1,156 @@
+#include <ossia/dataflow/graph/graph_parallel_impl.hpp>
+#include <ossia/dataflow/port.hpp>
+#include <ossia/network/generic/generic_device.hpp>
+
+#include "include_catch.hpp"
+
+#include <mutex>
+
+using namespace ossia;
+
+namespace
+{
+class chain_node final : public ossia::graph_node
+{
+public:
+  explicit chain_node(int i, bool threadable = true)
+      : index{i}
+  {
+    m_not_threadable = !threadable;
+    m_inlets.push_back(new value_inlet);
+    m_outlets.push_back(new value_outlet);
+    request(token_request{});
+  }
+
+  std::string label() const noexcept override { return "chain"; }
+
+  int index{};
+};
+
+struct flow
+{
+  std::vector<std::unique_ptr<chain_node>> nodes;
+  std::vector<ossia::task*> tasks;
+  ossia::taskflow tf;
+
+  flow() { tf.reserve(16); }
+
+  // The nodes must be added in topological order
+  chain_node& add(bool threadable = true)
+  {
+    auto& n = *nodes.emplace_back(
+        std::make_unique<chain_node>(nodes.size(), threadable));
+    tasks.push_back(tf.emplace(n));
+    return n;
+  }
+
+  void connect(int a, int b) { tasks[a]->precede(*tasks[b]); }
+};
+}
+
+TEST_CASE("test_fuse_linear_chain", "test_fuse_linear_chain")
+{
+  flow f;
+  for(int i = 0; i < 4; i++)
+    f.add();
+  f.connect(0, 1);
+  f.connect(1, 2);
+  f.connect(2, 3);
+
+  f.tf.fuse_chains();
+  REQUIRE(f.tf.size() == 1);
+  REQUIRE(f.tf[0].size() == 4);
+}
+
+TEST_CASE("test_fuse_branches", "test_fuse_branches")
+{
+  //     1 - 2
+  //   /       \ .
+  // 0           5 - 6
+  //   \       /
+  //     3 - 4
+  flow f;
+  for(int i = 0; i < 7; i++)
+    f.add();
+  f.connect(0, 1);
+  f.connect(1, 2);
+  f.connect(0, 3);
+  f.connect(3, 4);
+  f.connect(2, 5);
+  f.connect(4, 5);
+  f.connect(5, 6);
+
+  f.tf.fuse_chains();
+  REQUIRE(f.tf.size() == 4);
+  REQUIRE(f.tf[0].size() == 1);
+  REQUIRE(f.tf[1].size() == 2);
+  REQUIRE(f.tf[2].size() == 2);
+  REQUIRE(f.tf[3].size() == 2);
+}
+
+TEST_CASE("test_fuse_boundaries", "test_fuse_boundaries")
+{
+  ossia::net::generic_device dev;
+  auto param = dev.create_child("foo")->create_parameter(val_type::FLOAT);
+
+  // 0 - 1 - 2 - 3 - 4, with 2 not threadable and 4 reading a parameter
+  flow f;
+  f.add();
+  f.add();
+  f.add(false);
+  f.add();
+  f.add().root_inputs()[0]->address = param;
+  for(int i = 0; i < 4; i++)
+    f.connect(i, i + 1);
+
+  f.tf.fuse_chains();
+  REQUIRE(f.tf.size() == 4);
+  REQUIRE(f.tf[0].size() == 2);
+  REQUIRE(f.tf[1].size() == 1);
+  REQUIRE(f.tf[2].size() == 1);
+  REQUIRE(f.tf[3].size() == 1);
+}
+
+TEST_CASE("test_fused_execution_order", "test_fused_execution_order")
+{
+  // Two chains joined in a last node
+  flow f;
+  for(int i = 0; i < 9; i++)
+    f.add();
+  for(int i = 0; i < 3; i++)
+    f.connect(i, i + 1);
+  for(int i = 4; i < 7; i++)
+    f.connect(i, i + 1);
+  f.connect(3, 8);
+  f.connect(7, 8);
+
+  // A disabled node does not prevent the rest of its chain from running
+  f.nodes[4]->disable();
+
+  f.tf.fuse_chains();
+  REQUIRE(f.tf.size() == 3);
+
+  std::mutex mut;
+  std::vector<int> order;
+  ossia::executor ex{2};
+  ex.set_task_executor([&](ossia::graph_node& n) {
+    if(!n.enabled())
+      return;
+    std::lock_guard _{mut};
+    order.push_back(static_cast<chain_node&>(n).index);
+  });
+
+  for(int k = 0; k < 10; k++)
+  {
+    order.clear();
+    ex.run(f.tf);
+
+    REQUIRE(order.size() == 8);
+    auto pos = [&](int i) { return std::find(order.begin(), order.end(), i); };
+    REQUIRE(pos(4) == order.end());
+    for(int i : {0, 1, 2, 5, 6})
+      REQUIRE(pos(i) < pos(i + 1));
+    REQUIRE(pos(3) < pos(8));
+    REQUIRE(pos(7) < pos(8));
+  }
+}
@@ -1,6 +1,13 @@
 #include <ossia/detail/config.hpp>
 
 #include <ossia/dataflow/graph/tick_methods.hpp>
+#include <ossia/dataflow/graph/graph_interface.hpp>
+#include <ossia/dataflow/node_process.hpp>
+#include <ossia/editor/expression/expression.hpp>
+#include <ossia/editor/scenario/scenario.hpp>
+#include <ossia/editor/scenario/time_event.hpp>
+#include <ossia/editor/scenario/time_interval.hpp>
+#include <ossia/editor/scenario/time_sync.hpp>
 
 #include "include_catch.hpp"
 
@@ -22,3 +29,217 @@ TEST_CASE("test_cuts", "test_cuts")
   // from 9 to 10
   // from 10
 }
+
+TEST_CASE("test_split_cuts", "test_split_cuts")
+{
+  using namespace ossia;
+  // 1 sample = 100 flicks
+  const double ratio = 0.01;
+
+  ossia::token_request_vec tokens;
+  // Starts in the middle of the buffer
+  tokens.push_back(token_request{0_tv, 3000_tv, 0_tv, 2000_tv, 1., {}, 120.});
+  // Stops at sample 10
+  tokens.push_back(token_request{500_tv, 1500_tv, 0_tv, 0_tv, 1., {}, 120.});
+  // Ends with the buffer
+  tokens.push_back(token_request{0_tv, 6400_tv, 0_tv, 0_tv, 1., {}, 120.});
+
+  std::vector<int64_t> cuts;
+  split_score_tick::add_cuts(cuts, tokens, ratio, 64);
+  std::sort(cuts.begin(), cuts.end());
+  REQUIRE(cuts == std::vector<int64_t>{10, 20, 50});
+}
+
+TEST_CASE("test_split_token", "test_split_token")
+{
+  using namespace ossia;
+  const double ratio = 0.01;
+
+  // Samples [20, 50) of the buffer
+  token_request tk{1000_tv, 4000_tv, 0_tv, 2000_tv, 1., {}, 120.};
+  tk.start_discontinuous = true;
+
+  REQUIRE(!split_score_tick::split_token(tk, 0, 20, ratio));
+  REQUIRE(!split_score_tick::split_token(tk, 50, 64, ratio));
+
+  // Whole token in the sub-block
+  {
+    auto part = split_score_tick::split_token(tk, 10, 64, ratio);
+    REQUIRE(part);
+    REQUIRE(part->prev_date == 1000_tv);
+    REQUIRE(part->date == 4000_tv);
+    REQUIRE(part->physical_start(ratio) == 10);
+    REQUIRE(part->start_discontinuous);
+  }
+
+  // Cut at 30 and 40
+  auto first = split_score_tick::split_token(tk, 0, 30, ratio);
+  auto middle = split_score_tick::split_token(tk, 30, 40, ratio);
+  auto last = split_score_tick::split_token(tk, 40, 64, ratio);
+  REQUIRE(first);
+  REQUIRE(middle);
+  REQUIRE(last);
+
+  REQUIRE(first->prev_date == 1000_tv);
+  REQUIRE(first->date == 2000_tv);
+  REQUIRE(first->physical_start(ratio) == 20);
+  REQUIRE(first->start_discontinuous);
+
+  REQUIRE(middle->prev_date == 2000_tv);
+  REQUIRE(middle->date == 3000_tv);
+  REQUIRE(middle->physical_start(ratio) == 0);
+  REQUIRE(!middle->start_discontinuous);
+
+  REQUIRE(last->prev_date == 3000_tv);
+  REQUIRE(last->date == 4000_tv);
+  REQUIRE(last->physical_start(ratio) == 0);
+  REQUIRE(last->physical_write_duration(ratio) == 10);
+
+  // Paused tokens stay whole in the sub-block where they start
+  token_request paused{1000_tv, 1000_tv, 0_tv, 3000_tv, 1., {}, 120.};
+  REQUIRE(!split_score_tick::split_token(paused, 0, 30, ratio));
+  auto p = split_score_tick::split_token(paused, 30, 64, ratio);
+  REQUIRE(p);
+  REQUIRE(p->physical_start(ratio) == 0);
+}
+
+namespace
+{
+// Records the tokens and buffer sizes a node is run with
+struct token_recorder final : ossia::graph_node
+{
+  struct run_info
+  {
+    ossia::time_value prev_date;
+    ossia::time_value date;
+    int64_t start{};
+    int64_t duration{};
+    int buffer_size{};
+    bool operator==(const run_info&) const noexcept = default;
+  };
+  std::vector<run_info> runs;
+
+  std::string label() const noexcept override { return "recorder"; }
+  void run(const ossia::token_request& t, ossia::exec_state_facade e) noexcept override
+  {
+    const double ratio = e.modelToSamples();
+    runs.push_back(
+        {t.prev_date, t.date, t.physical_start(ratio), t.physical_write_duration(ratio),
+         e.bufferSize()});
+  }
+};
+
+// A scenario with two intervals one after the other, each playing a recorder.
+// One sample is 100 flicks.
+struct tick_session
+{
+  ossia::execution_state st;
+  std::shared_ptr<ossia::graph_interface> g = ossia::make_graph({});
+  std::shared_ptr<ossia::scenario> scenar = std::make_shared<ossia::scenario>();
+  std::shared_ptr<token_recorder> a = std::make_shared<token_recorder>();
+  std::shared_ptr<token_recorder> b = std::make_shared<token_recorder>();
+
+  explicit tick_session(ossia::time_value first_duration)
+  {
+    using namespace ossia;
+    st.sampleRate = 1000;
+    st.modelToSamplesRatio = 0.01;
+    st.samplesToModelRatio = 100.;
+
+    auto event = [&](time_sync& sync) {
+      auto ev = std::make_shared<time_event>(
+          time_event::exec_callback{}, sync, expressions::make_expression_true());
+      sync.insert(sync.get_time_events().end(), ev);
+      return ev;
+    };
+    auto e0 = event(*scenar->get_start_time_sync());
+    auto sync = [&] {
+      auto s = std::make_shared<time_sync>();
+      s->set_expression(expressions::make_expression_true());
+      scenar->add_time_sync(s);
+      return s;
+    };
+    auto s1 = sync(), s2 = sync();
+    auto e1 = event(*s1), e2 = event(*s2);
+
+    auto itv0 = time_interval::create(
+        {}, *e0, *e1, first_duration, first_duration, first_duration);
+    itv0->add_time_process(std::make_shared<node_process>(a));
+    auto itv1 = time_interval::create({}, *e1, *e2, 100000_tv, 100000_tv, 100000_tv);
+    itv1->add_time_process(std::make_shared<node_process>(b));
+    scenar->add_time_interval(itv0);
+    scenar->add_time_interval(itv1);
+
+    for(auto& n : {scenar->node, itv0->node, itv1->node})
+      if(n)
+        g->add_node(n);
+    g->add_node(a);
+    g->add_node(b);
+
+    scenar->start();
+  }
+};
+}
+
+TEST_CASE("test_split_score_tick_no_cuts", "test_split_score_tick_no_cuts")
+{
+  using namespace ossia;
+  // The first interval lasts 1000 samples: nothing happens inside the buffers
+  tick_session buf{100000_tv}, split{100000_tv};
+  buffer_tick buf_tick{buf.st, *buf.g, *buf.scenar, {}};
+  split_score_tick split_tick{split.st, *split.g, *split.scenar, {}};
+
+  for(int i = 0; i < 5; i++)
+  {
+    buf_tick(64, i * 0.064);
+    split_tick(64, i * 0.064);
+  }
+
+  REQUIRE(buf.a->runs.size() == 5);
+  REQUIRE(buf.a->runs == split.a->runs);
+  REQUIRE(buf.b->runs.empty());
+  REQUIRE(split.b->runs.empty());
+  REQUIRE(buf.st.samples_since_start == split.st.samples_since_start);
+}
+
+TEST_CASE("test_split_score_tick_cuts", "test_split_score_tick_cuts")
+{
+  using namespace ossia;
+  // The first interval ends, and the second starts, at sample 10
+  tick_session buf{1000_tv}, split{1000_tv};
+  buffer_tick buf_tick{buf.st, *buf.g, *buf.scenar, {}};
+  split_score_tick split_tick{split.st, *split.g, *split.scenar, {}};
+
+  buf_tick(64, 0.);
+  split_tick(64, 0.);
+
+  // Same dates in both cases
+  REQUIRE(buf.a->runs.size() == 1);
+  REQUIRE(split.a->runs.size() == 1);
+  REQUIRE(buf.b->runs.size() == 1);
+  REQUIRE(split.b->runs.size() == 1);
+  REQUIRE(buf.a->runs[0].date == split.a->runs[0].date);
+  REQUIRE(buf.b->runs[0].prev_date == split.b->runs[0].prev_date);
+  REQUIRE(buf.b->runs[0].date == split.b->runs[0].date);
+
+  // One buffer for everything
+  REQUIRE(buf.a->runs[0].start == 0);
+  REQUIRE(buf.a->runs[0].duration == 10);
+  REQUIRE(buf.a->runs[0].buffer_size == 64);
+  REQUIRE(buf.b->runs[0].start == 10);
+  REQUIRE(buf.b->runs[0].duration == 54);
+  REQUIRE(buf.b->runs[0].buffer_size == 64);
+
+  // Each interval in its own sub-block
+  REQUIRE(split.a->runs[0].start == 0);
+  REQUIRE(split.a->runs[0].duration == 10);
+  REQUIRE(split.a->runs[0].buffer_size == 10);
+  REQUIRE(split.b->runs[0].start == 0);
+  REQUIRE(split.b->runs[0].duration == 54);
+  REQUIRE(split.b->runs[0].buffer_size == 54);
+
+  REQUIRE(buf.st.samples_since_start == split.st.samples_since_start);
+#if defined(OSSIA_SCENARIO_DATAFLOW)
+  REQUIRE(split.scenar->node->requested_tokens.empty());
+#endif
+}
@@ -172,6 +172,52 @@ TEMPLATE_TEST_CASE(
     }
   }
 
+  GIVEN("A value port with a unit")
+  {
+    ossia::value_port p;
+    p.type = ossia::millimeter_u{};
+    TestDevice dev;
+
+    WHEN("A value is added through a parameter with the same unit")
+    {
+      add_func(p, *dev.millimeter, 123.f);
+
+      THEN("It is in the data of the port, unchanged")
+      {
+        REQUIRE(p.get_data().size() == 1);
+        REQUIRE(p.get_data()[0].value == 123.f);
+      }
+    }
+
+    WHEN("A value is added through a parameter with another unit")
+    {
+      add_func(p, *dev.meter, 1.5f);
+
+      THEN("It is converted to the unit of the port")
+      {
+        REQUIRE(p.get_data().size() == 1);
+        REQUIRE(*p.get_data()[0].value.target<float>() == Catch::Approx(1500.));
+      }
+    }
+
+    WHEN("A list is added through a parameter with another unit")
+    {
+      auto list_m = dev.device.create_child("list_m")->create_parameter(val_type::LIST);
+      list_m->set_unit(ossia::meter_u{});
+      add_func(p, *list_m, ossia::value{std::vector<ossia::value>{1.f, 0.25f}});
+
+      THEN("Each element is converted to the unit of the port")
+      {
+        REQUIRE(p.get_data().size() == 1);
+        auto list = p.get_data()[0].value.target<std::vector<ossia::value>>();
+        REQUIRE(list);
+        REQUIRE(list->size() == 2);
+        REQUIRE(*(*list)[0].target<float>() == Catch::Approx(1000.));
+        REQUIRE(*(*list)[1].target<float>() == Catch::Approx(250.));
+      }
+    }
+  }
+
   GIVEN("A value port with a domain")
   {
     ossia::value_port p;
@@ -110,6 +110,41 @@ TEST_CASE("test_float_int", "test_float_int")
   REQUIRE(c->value_at(10.) == 10);
 }
 
+TEST_CASE("test_values_at", "test_values_at")
+{
+  curve<double, float> c;
+  c.set_x0(0.);
+  c.set_y0(0.);
+  c.add_point(curve_segment_linear<float>{}, 1., 1.);
+  curve_segment_power<float, double> power;
+  power.gamma = 3.;
+  c.add_point(power, 2., -1.);
+  // Type-erased segment
+  c.add_point(
+      curve_segment<float>{[](double r, float s, float e) { return r < 0.5 ? s : e; }},
+      3., 0.5);
+  c.add_point(curve_segment_ease<float, easing::sineInOut>{}, 4., 2.);
+
+  std::vector<double> xs;
+  for(double x = -0.5; x <= 4.5; x += 1. / 64.)
+    xs.push_back(x);
+  // Some unsorted abscissae too
+  xs.push_back(2.5);
+  xs.push_back(0.25);
+  xs.push_back(1.);
+
+  std::vector<float> values(xs.size());
+  c.values_at(xs, values);
+  for(std::size_t i = 0; i < xs.size(); i++)
+    REQUIRE(values[i] == c.value_at(xs[i]));
+
+  curve<double, float> empty;
+  empty.set_y0(3.f);
+  empty.values_at(xs, values);
+  for(float v : values)
+    REQUIRE(v == 3.f);
+}
+
 TEST_CASE("test_destination", "test_destination")
 {
   ossia::net::generic_device device{"test"};
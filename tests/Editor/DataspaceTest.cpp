@@ -483,6 +483,81 @@ TEST_CASE("test_convertible", "test_convertible")
   REQUIRE(!check_units_convertible(ossia::rgb_u{}, ossia::cartesian_3d_u{}));
 }
 
+TEST_CASE("test_convert_array", "test_convert_array")
+{
+  using namespace ossia;
+  {
+    std::vector<vec3f> colors;
+    for(int i = 0; i < 100; i++)
+      colors.push_back(make_vec(i / 100.f, 1.f - i / 100.f, 0.5f));
+    auto expected = colors;
+
+    REQUIRE(convert(tcb::span<vec3f>(colors), rgb_u{}, hsv_u{}));
+    for(std::size_t i = 0; i < colors.size(); i++)
+    {
+      auto res = convert(rgb{expected[i]}, hsv_u{});
+      REQUIRE(to_value(res) == value{colors[i]});
+    }
+  }
+
+  {
+    std::vector<float> dist{1.f, 2.5f, -3.f};
+    REQUIRE(convert(tcb::span<float>(dist), meter_u{}, centimeter_u{}));
+    REQUIRE(dist == std::vector<float>{100.f, 250.f, -300.f});
+
+    // Same unit: nothing to do
+    REQUIRE(convert(tcb::span<float>(dist), centimeter_u{}, centimeter_u{}));
+    REQUIRE(dist == std::vector<float>{100.f, 250.f, -300.f});
+  }
+
+  {
+    // Mismatching dataspaces or value types
+    std::vector<vec3f> v{make_vec(1.f, 2.f, 3.f)};
+    REQUIRE(!convert(tcb::span<vec3f>(v), rgb_u{}, meter_u{}));
+    REQUIRE(!convert(tcb::span<vec3f>(v), rgb_u{}, rgba_u{}));
+    REQUIRE(!convert(tcb::span<vec3f>(v), unit_t{}, rgb_u{}));
+    REQUIRE(v.front() == make_vec(1.f, 2.f, 3.f));
+  }
+}
+
+TEST_CASE("test_convert_list", "test_convert_list")
+{
+  using namespace ossia;
+  {
+    // Each element of a list of positions is converted
+    std::vector<value> positions{
+        make_vec(1.f, 0.f, 0.f), make_vec(0.f, 1.f, 0.f), make_vec(0.f, 0.f, 1.f)};
+    auto res = convert(value{positions}, cartesian_3d_u{}, aed_u{});
+    auto list = res.target<std::vector<value>>();
+    REQUIRE(list);
+    REQUIRE(list->size() == 3);
+    for(int i = 0; i < 3; i++)
+    {
+      REQUIRE(
+          (*list)[i]
+          == to_value(convert(cartesian_3d{positions[i].get<vec3f>()}, aed_u{})));
+    }
+  }
+
+  {
+    // Lists of floats for a float unit used to give an invalid value
+    std::vector<value> gains{0.f, 0.5f, 1.f};
+    auto res = convert(value{gains}, linear_u{}, midigain_u{});
+    auto list = res.target<std::vector<value>>();
+    REQUIRE(list);
+    REQUIRE(list->size() == 3);
+    for(int i = 0; i < 3; i++)
+      REQUIRE((*list)[i] == to_value(convert(linear{gains[i].get<float>()}, midigain_u{})));
+  }
+
+  {
+    // A list of floats for a vec3f unit is still a single value
+    std::vector<value> color{1.f, 0.f, 0.f};
+    auto res = convert(value{color}, rgb_u{}, hsv_u{});
+    REQUIRE(res == to_value(convert(rgb{make_vec(1.f, 0.f, 0.f)}, hsv_u{})));
+  }
+}
+
 TEST_CASE("convert_benchmark", "convert_benchmark")
 {
   const int N = 100000;
@@ -708,6 +708,108 @@ TEST_CASE("test_get_min_max", "test_get_min_max")
 }
 }
 
+TEST_CASE("test_bulk_apply_domain", "test_bulk_apply_domain")
+{
+  using namespace ossia;
+  const std::vector<domain> domains{
+      make_domain(-1.5f, 2.5f),
+      make_domain(-3, 7),
+      [] {
+        domain d = domain_base<float>{};
+        set_min(d, 0.25f);
+        return d;
+      }(),
+      [] {
+        domain d = domain_base<int32_t>{};
+        set_max(d, 4);
+        return d;
+      }()};
+  const bounding_mode modes[]{bounding_mode::FREE,      bounding_mode::CLIP,
+                              bounding_mode::WRAP,      bounding_mode::FOLD,
+                              bounding_mode::CLAMP_LOW, bounding_mode::CLAMP_HIGH};
+
+  for(const auto& dom : domains)
+  {
+    for(auto mode : modes)
+    {
+      std::vector<float> floats;
+      std::vector<int32_t> ints;
+      std::vector<ossia::value> list;
+      for(int i = -20; i <= 20; i++)
+      {
+        floats.push_back(i * 0.37f);
+        ints.push_back(i);
+        list.push_back(i * 0.37f);
+        list.push_back(i);
+      }
+      list.push_back(std::string("foo"));
+
+      auto expected_floats = floats;
+      for(auto& f : expected_floats)
+        f = apply_domain(dom, mode, value{f}).get<float>();
+      REQUIRE(apply_domain(dom, mode, tcb::span<float>(floats)));
+      REQUIRE(floats == expected_floats);
+
+      auto expected_ints = ints;
+      for(auto& i : expected_ints)
+        i = apply_domain(dom, mode, value{i}).get<int32_t>();
+      REQUIRE(apply_domain(dom, mode, tcb::span<int32_t>(ints)));
+      REQUIRE(ints == expected_ints);
+
+      // Lists: the elements of the domain's type are bound,
+      // the others are left as is
+      auto expected_list = list;
+      auto dom_type = dom.v.target<domain_base<float>>() ? val_type::FLOAT
+                                                          : val_type::INT;
+      for(auto& v : expected_list)
+        if(v.get_type() == dom_type)
+          v = apply_domain(dom, mode, v);
+      REQUIRE(apply_domain(dom, mode, value{list}) == value{expected_list});
+      REQUIRE(apply_domain(dom, mode, value{std::move(list)}) == value{expected_list});
+    }
+  }
+
+  {
+    // Sets of values are not handled in bulk
+    domain d = domain_base<float>{};
+    set_values(d, {0.f, 1.f});
+    std::vector<float> floats{0.f, 0.5f};
+    REQUIRE(!apply_domain(d, bounding_mode::CLIP, tcb::span<float>(floats)));
+    REQUIRE(floats == std::vector<float>{0.f, 0.5f});
+  }
+}
+
+TEST_CASE("test_bulk_apply_domain_unbounded", "test_bulk_apply_domain_unbounded")
+{
+  using namespace ossia;
+  // Floats going through an integer domain are only truncated when a bound
+  // applies to them
+  const domain int_dom = make_domain(-3, 7);
+  domain int_max_dom = domain_base<int32_t>{};
+  set_max(int_max_dom, 4);
+
+  for(auto mode : {bounding_mode::FREE, bounding_mode::CLAMP_LOW})
+  {
+    const auto& dom = mode == bounding_mode::FREE ? int_dom : int_max_dom;
+
+    std::vector<float> floats{-5.5f, 1.5f, 9.25f};
+    REQUIRE(apply_domain(dom, mode, tcb::span<float>(floats)));
+    REQUIRE(floats == std::vector<float>{-5.5f, 1.5f, 9.25f});
+
+    const value v{1.5f};
+    REQUIRE(apply_domain(dom, mode, v) == value{1.5f});
+    REQUIRE(apply_domain(dom, mode, value{1.5f}) == value{1.5f});
+
+    const value list{std::vector<ossia::value>{1.5f, 2, 9}};
+    REQUIRE(apply_domain(dom, mode, list) == list);
+  }
+
+  // When a bound applies they are converted as before
+  std::vector<float> floats{-5.5f, 1.5f, 9.25f};
+  REQUIRE(apply_domain(int_dom, bounding_mode::CLIP, tcb::span<float>(floats)));
+  REQUIRE(floats == std::vector<float>{-3.f, 1.f, 7.f});
+}
+
 TEST_CASE("test_string", "test_string")
 {
   using namespace ossia;
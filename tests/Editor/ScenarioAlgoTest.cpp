@@ -1154,6 +1154,99 @@ TEST_CASE("test_offset", "test_offset")
   //        }
 }
 
+TEST_CASE("test_transport", "test_transport")
+{
+  using namespace ossia;
+  root_scenario s;
+
+  ossia::scenario& scenario = *s.scenario;
+  std::shared_ptr<time_event> e0 = start_event(scenario);
+  std::shared_ptr<time_event> e1 = create_event(scenario);
+  std::shared_ptr<time_event> e2 = create_event(scenario);
+  std::shared_ptr<time_event> e3 = create_event(scenario);
+
+  std::shared_ptr<time_interval> c0
+      = create_interval({}, *e0, *e1, 5000_tv, 5000_tv, 5000_tv);
+  s.scenario->add_time_interval(c0);
+  std::shared_ptr<time_interval> c1
+      = create_interval({}, *e1, *e2, 5000_tv, 5000_tv, 5000_tv);
+  s.scenario->add_time_interval(c1);
+  std::shared_ptr<time_interval> c2
+      = create_interval({}, *e2, *e3, 5000_tv, 5000_tv, 5000_tv);
+  s.scenario->add_time_interval(c2);
+
+  start_and_tick(s.interval);
+  s.interval->tick(1000_tv, default_request());
+  REQUIRE(c0->get_date() == 1000_tv);
+
+  s.scenario->transport(7000_tv);
+  REQUIRE(c0->get_date() == 0_tv);
+  REQUIRE(c1->get_date() == 2000_tv);
+  REQUIRE(c2->get_date() == 0_tv);
+
+  s.scenario->transport(12000_tv);
+  REQUIRE(c0->get_date() == 0_tv);
+  REQUIRE(c1->get_date() == 0_tv);
+  REQUIRE(c1->get_offset() == 0_tv);
+  REQUIRE(c2->get_date() == 2000_tv);
+
+  s.scenario->transport(3000_tv);
+  REQUIRE(c0->get_date() == 3000_tv);
+  REQUIRE(c1->get_date() == 0_tv);
+  REQUIRE(c2->get_date() == 0_tv);
+  REQUIRE(c2->get_offset() == 0_tv);
+}
+
+TEST_CASE("test_transport_after_playback", "test_transport_after_playback")
+{
+  using namespace ossia;
+  root_scenario s;
+
+  ossia::scenario& scenario = *s.scenario;
+  std::shared_ptr<time_event> e0 = start_event(scenario);
+  std::shared_ptr<time_event> e1 = create_event(scenario);
+  std::shared_ptr<time_event> e2 = create_event(scenario);
+  std::shared_ptr<time_event> e3 = create_event(scenario);
+
+  std::shared_ptr<time_interval> c0
+      = create_interval({}, *e0, *e1, 5000_tv, 5000_tv, 5000_tv);
+  s.scenario->add_time_interval(c0);
+  std::shared_ptr<time_interval> c1
+      = create_interval({}, *e1, *e2, 5000_tv, 5000_tv, 5000_tv);
+  s.scenario->add_time_interval(c1);
+  std::shared_ptr<time_interval> c2
+      = create_interval({}, *e2, *e3, 5000_tv, 5000_tv, 5000_tv);
+  s.scenario->add_time_interval(c2);
+
+  // Play through c0 and into c1 without any seek
+  start_and_tick(s.interval);
+  s.interval->tick(3000_tv, default_request());
+  s.interval->tick(4000_tv, default_request());
+  REQUIRE(e1->get_status() == time_event::status::HAPPENED);
+  REQUIRE(c1->get_date() == 2000_tv);
+
+  s.interval->transport(0_tv);
+  REQUIRE(c0->get_date() == 0_tv);
+  REQUIRE(c0->get_offset() == 0_tv);
+  REQUIRE(c1->get_date() == 0_tv);
+  REQUIRE(c1->get_offset() == 0_tv);
+  REQUIRE(c2->get_date() == 0_tv);
+
+  // Seek into c1 and play until c1 ends and c2 starts, then seek back into c0
+  s.interval->transport(7000_tv);
+  REQUIRE(c1->get_offset() == 2000_tv);
+  s.interval->tick(4000_tv, default_request());
+  REQUIRE(e2->get_status() == time_event::status::HAPPENED);
+  REQUIRE(c2->get_date() == 1000_tv);
+
+  s.interval->transport(1000_tv);
+  REQUIRE(c0->get_date() == 1000_tv);
+  REQUIRE(c1->get_date() == 0_tv);
+  REQUIRE(c1->get_offset() == 0_tv);
+  REQUIRE(c2->get_date() == 0_tv);
+  REQUIRE(c2->get_offset() == 0_tv);
+}
+
 TEST_CASE("test_musical_bar", "test_musical_bar")
 {
 
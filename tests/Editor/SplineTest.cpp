@@ -0,0 +1,74 @@
+#include <ossia/editor/automation/tinyspline_util.hpp>
+
+#include "include_catch.hpp"
+
+#include <cmath>
+#include <vector>
+
+// Largest difference between the table and the exact curve,
+// on many more positions than the table has samples
+template <std::size_t N>
+static double max_error(const ts::spline<N>& s)
+{
+  const std::size_t n = 100003;
+  std::vector<double> pos(n);
+  for(std::size_t i = 0; i < n; i++)
+    pos[i] = double(i) / (n - 1);
+
+  std::vector<typename ts::spline<N>::point> batch(n);
+  s.evaluate(pos.data(), batch.data(), n);
+
+  double err = 0.;
+  for(std::size_t i = 0; i < n; i++)
+  {
+    const auto exact = s.evaluate_exact(pos[i]);
+    const auto table = s.evaluate(pos[i]);
+    for(std::size_t k = 0; k < N; k++)
+    {
+      REQUIRE(batch[i][k] == table[k]);
+      err = std::max(err, std::abs(double(table[k] - exact[k])));
+    }
+  }
+  return err;
+}
+
+TEST_CASE("test_spline_table", "test_spline_table")
+{
+  const tsReal points[] = {0., 0., 0.2, 0.9, 0.5, -0.3, 0.7, 1., 1., 0.5, 0.3, 0.2};
+
+  ts::spline<2> s;
+  s.set_points(points, 6);
+  REQUIRE(s);
+  REQUIRE(s.table_size() > 0);
+  REQUIRE(max_error(s) <= s.tolerance());
+
+  s.set_tolerance(1e-3);
+  s.set_points(points, 6);
+  REQUIRE(max_error(s) <= s.tolerance());
+
+  // The ends of the curve are the ends of the control polygon
+  REQUIRE(std::abs(s.evaluate(0.)[0] - 0.) < 1e-9);
+  REQUIRE(std::abs(s.evaluate(1.)[1] - 0.2) < 1e-9);
+}
+
+TEST_CASE("test_spline_table_3d", "test_spline_table_3d")
+{
+  const tsReal points[] = {0., 0., 0., 1., 1., 1., 2., 0., 1., 3., 1., 0., -1., 2., 5.};
+
+  ts::spline<3> s;
+  s.set_tolerance(1e-6);
+  s.set_points(points, 5);
+  REQUIRE(s.table_size() > 0);
+  REQUIRE(max_error(s) <= s.tolerance());
+}
+
+TEST_CASE("test_spline_exact", "test_spline_exact")
+{
+  const tsReal points[] = {0., 0., 1., 2., 2., -1., 3., 0.};
+
+  ts::spline<2> s;
+  s.set_tolerance(0.);
+  s.set_points(points, 4);
+  REQUIRE(s.table_size() == 0);
+  REQUIRE(max_error(s) == 0.);
+}
@@ -8,6 +8,7 @@
 #include <ossia/network/generic/generic_device.hpp>
 #include <ossia/network/value/detail/value_parse_impl.hpp>
 #include <ossia/network/value/value.hpp>
+#include <ossia/network/value/value_array.hpp>
 
 #include "include_catch.hpp"
 
@@ -576,6 +577,41 @@ TEST_CASE("test_link", "test_link")
   }
 }
 
+TEST_CASE("test_numeric_array", "test_numeric_array")
+{
+  using namespace ossia;
+  std::vector<float> floats{0.5f, -1.f, 3.25f};
+  auto list = make_numeric_list(floats);
+  REQUIRE(list == std::vector<value>{0.5f, -1.f, 3.25f});
+  REQUIRE(is_numeric_list(list));
+
+  std::vector<double> doubles;
+  REQUIRE(to_numeric_array(list, doubles));
+  REQUIRE(doubles == std::vector<double>{0.5, -1., 3.25});
+  REQUIRE(make_numeric_list(doubles) == list);
+
+  std::vector<int32_t> ints{1, 2, 3};
+  auto int_list = make_numeric_list(ints);
+  REQUIRE(int_list == std::vector<value>{1, 2, 3});
+
+  // Mixed floats and ints are numeric lists too
+  int_list.push_back(0.5f);
+  REQUIRE(is_numeric_list(int_list));
+  std::vector<float> res;
+  REQUIRE(to_numeric_array(int_list, res));
+  REQUIRE(res == std::vector<float>{1.f, 2.f, 3.f, 0.5f});
+
+  // Other values are not converted
+  int_list.push_back(std::string("foo"));
+  REQUIRE(!is_numeric_list(int_list));
+  REQUIRE(!to_numeric_array(int_list, res));
+  REQUIRE(res == std::vector<float>{1.f, 2.f, 3.f, 0.5f});
+
+  REQUIRE(!is_numeric_list({}));
+  REQUIRE(to_numeric_array({}, res));
+  REQUIRE(res.empty());
+}
+
 /*! test generic */
 TEST_CASE("test_generic", "test_generic")
 {
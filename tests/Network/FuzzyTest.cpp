@@ -2,6 +2,7 @@
 // PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
 #include <ossia/detail/config.hpp>
 
+#include <ossia/network/base/fuzzysearch_index.hpp>
 #include <ossia/network/base/node_functions.hpp>
 #include <ossia/network/domain/domain_base.hpp>
 #include <ossia/network/generic/generic_device.hpp>
@@ -93,3 +94,70 @@ TEST_CASE("Matching")
     }
   }
 }
+
+static std::vector<double> scores(const std::vector<ossia::net::fuzzysearch_result>& res)
+{
+  std::vector<double> s;
+  for(auto& r : res)
+    s.push_back(r.score);
+  return s;
+}
+
+TEST_CASE("test_fuzzysearch_index", "test_fuzzysearch_index")
+{
+  ossia::net::generic_device device{"test"};
+  for(int i = 0; i < 20; i++)
+  {
+    auto n = device.create_child("track." + std::to_string(i));
+    n->create_child("volume")->create_parameter();
+    n->create_child("Pan")->create_parameter();
+    n->create_child("mute")->create_parameter();
+  }
+
+  ossia::net::fuzzysearch_index index{device};
+  REQUIRE(index.size() == 80);
+
+  auto check = [&](std::vector<std::string> patterns, auto opt) {
+    std::vector<ossia::net::fuzzysearch_result> expected, res;
+    ossia::net::fuzzysearch({&device.get_root_node()}, patterns, expected, opt);
+    index.search(patterns, res, opt);
+    REQUIRE(res.size() == expected.size());
+    REQUIRE(scores(res) == scores(expected));
+
+    // The best results are the same with top-k selection
+    opt.max_results = 5;
+    index.search(patterns, res, opt);
+    REQUIRE(res.size() == std::min<std::size_t>(5, expected.size()));
+    for(std::size_t i = 0; i < res.size(); i++)
+      REQUIRE(res[i].score == expected[i].score);
+  };
+
+  ossia::net::fuzzysearch_options opt;
+  check({"pan"}, opt);
+  check({"track.1", "vol"}, opt);
+  opt.case_sensitive = false;
+  check({"pan"}, opt);
+  check({"TRACK.12/MUTE"}, opt);
+
+  // The index follows the changes of the device
+  auto extra = device.create_child("extra");
+  extra->create_child("Reverb")->create_parameter();
+  REQUIRE(index.size() == 82);
+  check({"reverb"}, opt);
+
+  extra->set_name("send");
+  std::vector<ossia::net::fuzzysearch_result> res;
+  index.search({"send/reverb"}, res, opt);
+  REQUIRE(res.size() == 82);
+  REQUIRE(res.front().oscname == "/send/reverb");
+  REQUIRE(res.front().score == 100.);
+  for(auto& r : res)
+    REQUIRE(r.oscname.find("extra") == std::string::npos);
+  check({"send/reverb"}, opt);
+
+  device.get_root_node().remove_child("send");
+  device.get_root_node().remove_child("track.3");
+  REQUIRE(index.size() == 76);
+  check({"reverb"}, opt);
+  check({"track.3"}, opt);
+}
@@ -0,0 +1,89 @@
+#include <ossia/protocols/mqtt/mqtt_codec.hpp>
+
+#include "include_catch.hpp"
+
+using namespace ossia;
+using namespace ossia::net;
+
+static ossia::value round_trip(mqtt5_payload_codec codec, const ossia::value& v)
+{
+  std::string payload;
+  mqtt5_encode(codec, v, payload);
+  return mqtt5_decode(codec, payload, v.get_type());
+}
+
+TEST_CASE("test_mqtt_cbor_round_trip", "test_mqtt_cbor_round_trip")
+{
+  const auto c = mqtt5_payload_codec::cbor;
+  for(int i : {0, 23, 24, 255, 256, 65536, -1, -24, -25, -1000000})
+    REQUIRE(round_trip(c, i) == ossia::value{i});
+
+  REQUIRE(round_trip(c, 1.5f) == ossia::value{1.5f});
+  REQUIRE(round_trip(c, true) == ossia::value{true});
+  REQUIRE(round_trip(c, std::string("hello")) == ossia::value{std::string("hello")});
+  REQUIRE(round_trip(c, std::string(300, 'x')) == ossia::value{std::string(300, 'x')});
+  REQUIRE(round_trip(c, ossia::vec3f{1.f, 2.f, 3.f}) == ossia::vec3f{1.f, 2.f, 3.f});
+
+  const std::vector<ossia::value> list{
+      1, 2.f, std::string("a"), std::vector<ossia::value>{true}};
+  REQUIRE(round_trip(c, list) == ossia::value{list});
+
+  ossia::value_map_type map;
+  map.emplace_back("x", 1);
+  map.emplace_back("y", std::vector<ossia::value>{1.f, 2.f});
+  const auto res = round_trip(c, map);
+  REQUIRE(res.get_type() == ossia::val_type::MAP);
+  REQUIRE(res == ossia::value{map});
+}
+
+TEST_CASE("test_mqtt_cbor_invalid", "test_mqtt_cbor_invalid")
+{
+  const auto c = mqtt5_payload_codec::cbor;
+  const auto none = ossia::val_type::NONE;
+
+  std::string payload;
+  mqtt5_encode(c, std::vector<ossia::value>{1, 2, std::string("abc")}, payload);
+  for(std::size_t i = 0; i < payload.size(); i++)
+    REQUIRE(!mqtt5_decode(c, std::string_view(payload).substr(0, i), none).valid());
+
+  // Truncated float and string
+  REQUIRE(!mqtt5_decode(c, std::string("\xfa\x3f\x80", 3), none).valid());
+  REQUIRE(!mqtt5_decode(c, std::string("\x65hel", 4), none).valid());
+
+  // Tags are skipped
+  REQUIRE(mqtt5_decode(c, std::string("\xc1\xc0\x05", 3), none) == ossia::value{5});
+
+  // A long chain of tags, or of nested arrays, is rejected without overflowing
+  REQUIRE(!mqtt5_decode(c, std::string(1000000, '\xc0') + '\x05', none).valid());
+  REQUIRE(!mqtt5_decode(c, std::string(1000000, '\x81') + '\x05', none).valid());
+}
+
+TEST_CASE("test_mqtt_raw", "test_mqtt_raw")
+{
+  const auto c = mqtt5_payload_codec::raw;
+  REQUIRE(round_trip(c, 123456) == ossia::value{123456});
+  REQUIRE(round_trip(c, -7) == ossia::value{-7});
+  REQUIRE(round_trip(c, 2.5f) == ossia::value{2.5f});
+  REQUIRE(round_trip(c, true) == ossia::value{true});
+  const ossia::vec4f v4{1.f, 2.f, 3.f, 4.f};
+  REQUIRE(round_trip(c, v4) == v4);
+  REQUIRE(round_trip(c, std::string("abc")) == ossia::value{std::string("abc")});
+
+  // Integers of various sizes
+  const auto i = ossia::val_type::INT;
+  REQUIRE(mqtt5_decode(c, std::string("\xfe", 1), i) == ossia::value{-2});
+  REQUIRE(mqtt5_decode(c, std::string("\x01\x02", 2), i) == ossia::value{0x0201});
+  REQUIRE(!mqtt5_decode(c, std::string("\x01\x02\x03", 3), i).valid());
+  REQUIRE(mqtt5_decode(c, std::string("\x01\x00\x00\x00", 4), i) == ossia::value{1});
+  REQUIRE(!mqtt5_decode(c, std::string_view{}, i).valid());
+
+  // Too short for a float
+  REQUIRE(!mqtt5_decode(c, std::string("\x01\x02", 2), ossia::val_type::FLOAT).valid());
+
+  // Missing components of a vector are zero
+  std::string payload;
+  mqtt5_encode(c, 1.f, payload);
+  REQUIRE(
+      mqtt5_decode(c, payload, ossia::val_type::VEC3F)
+      == ossia::value{ossia::vec3f{1.f, 0.f, 0.f}});
+}
@@ -0,0 +1,110 @@
+#include <ossia/network/base/node_functions.hpp>
+#include <ossia/network/base/parameter_inbox.hpp>
+#include <ossia/network/generic/generic_device.hpp>
+#include <ossia/network/generic/generic_parameter.hpp>
+
+#include "include_catch.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace ossia;
+using namespace ossia::net;
+
+// Counts the allocations of the whole test program
+static std::atomic<int64_t> g_allocations{};
+
+void* operator new(std::size_t n)
+{
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  if(void* p = std::malloc(n ? n : 1))
+    return p;
+  throw std::bad_alloc{};
+}
+void operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+void operator delete(void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+namespace
+{
+struct allocation_counter
+{
+  int64_t start = g_allocations.load();
+  int64_t count() const noexcept { return g_allocations.load() - start; }
+};
+
+constexpr int iterations = 100;
+}
+
+TEST_CASE("test_parameter_string_allocations", "test_parameter_string_allocations")
+{
+  generic_device dev{"test"};
+  auto p = create_node(dev.get_root_node(), "/a").create_parameter(val_type::STRING);
+
+  // Callbacks get a reference to the value: they do not copy it
+  std::size_t received = 0;
+  p->add_callback([&](const ossia::value& v) { received += v.get<std::string>().size(); });
+
+  // Longer than the small-string buffer
+  const ossia::value str{std::string(200, 'x')};
+  for(int i = 0; i < 3; i++)
+    p->set_value(str);
+
+  // The current and previous values reuse their buffers:
+  // only the returned copy allocates
+  allocation_counter set;
+  for(int i = 0; i < iterations; i++)
+    p->set_value(str);
+  const auto set_allocations = set.count();
+  REQUIRE(set_allocations <= iterations);
+
+  allocation_counter quiet;
+  for(int i = 0; i < iterations; i++)
+    p->set_value_quiet(str);
+  const auto quiet_allocations = quiet.count();
+  REQUIRE(quiet_allocations <= iterations);
+
+  REQUIRE(received == (iterations + 3) * 200);
+}
+
+TEST_CASE("test_parameter_inbox_allocations", "test_parameter_inbox_allocations")
+{
+  generic_device dev{"test"};
+  auto p = create_node(dev.get_root_node(), "/a").create_parameter(val_type::STRING);
+
+  parameter_inbox inbox{dev};
+  inbox.reg(*p);
+
+  std::size_t received = 0;
+  auto drain = [&] {
+    inbox.drain([&](parameter_base&, tcb::span<ossia::value> values) {
+      for(auto& v : values)
+        received += v.get<std::string>().size();
+    });
+  };
+
+  const ossia::value str{std::string(200, 'x')};
+  for(int i = 0; i < 3; i++)
+  {
+    p->push_value(str);
+    drain();
+  }
+
+  // The entries of the inbox are assigned over the values of the previous
+  // ticks when they are not moved from: only set_value allocates
+  allocation_counter push;
+  for(int i = 0; i < iterations; i++)
+  {
+    p->push_value(str);
+    drain();
+  }
+  const auto push_allocations = push.count();
+  REQUIRE(push_allocations <= iterations);
+  REQUIRE(received == (iterations + 3) * 200);
+}
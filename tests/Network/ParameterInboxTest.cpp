@@ -0,0 +1,193 @@
+#include <ossia/network/base/node_functions.hpp>
+#include <ossia/network/base/parameter_inbox.hpp>
+#include <ossia/network/generic/generic_device.hpp>
+#include <ossia/network/generic/generic_parameter.hpp>
+
+#include "include_catch.hpp"
+
+#include <thread>
+
+using namespace ossia;
+using namespace ossia::net;
+
+static std::vector<int> drain_ints(parameter_inbox& inbox, parameter_base& p)
+{
+  std::vector<int> res;
+  inbox.drain([&](parameter_base& param, tcb::span<ossia::value> values) {
+    REQUIRE(&param == &p);
+    for(auto& v : values)
+      res.push_back(v.get<int>());
+  });
+  return res;
+}
+
+TEST_CASE("test_inbox_order", "test_inbox_order")
+{
+  generic_device dev{"test"};
+  auto p = create_node(dev.get_root_node(), "/a").create_parameter(val_type::INT);
+
+  parameter_inbox inbox{dev};
+  inbox.reg(*p, 4);
+
+  REQUIRE(drain_ints(inbox, *p).empty());
+
+  p->push_value(1);
+  p->push_value(2);
+  p->push_value(3);
+  REQUIRE(drain_ints(inbox, *p) == std::vector<int>{1, 2, 3});
+  REQUIRE(drain_ints(inbox, *p).empty());
+
+  // Overflow: the oldest values are dropped
+  for(int i = 0; i < 10; i++)
+    p->push_value(i);
+  REQUIRE(drain_ints(inbox, *p) == std::vector<int>{6, 7, 8, 9});
+  REQUIRE(inbox.overflow() == 6);
+
+  inbox.unreg(*p);
+  p->push_value(1);
+  REQUIRE(drain_ints(inbox, *p).empty());
+}
+
+TEST_CASE("test_inbox_latest", "test_inbox_latest")
+{
+  generic_device dev{"test"};
+  auto a = create_node(dev.get_root_node(), "/a").create_parameter(val_type::INT);
+  auto b = create_node(dev.get_root_node(), "/b").create_parameter(val_type::INT);
+
+  parameter_inbox inbox{dev};
+  inbox.reg(*a, 1);
+  inbox.reg(*b, 1);
+
+  for(int i = 0; i < 100; i++)
+  {
+    a->push_value(i);
+    b->push_value(-i);
+  }
+
+  int calls = 0;
+  inbox.drain([&](parameter_base& param, tcb::span<ossia::value> values) {
+    calls++;
+    REQUIRE(values.size() == 1);
+    REQUIRE(values[0].get<int>() == (&param == a ? 99 : -99));
+  });
+  REQUIRE(calls == 2);
+
+  // Registering again can only grow the buffer
+  inbox.reg(*a, 3);
+  for(int i = 0; i < 5; i++)
+    a->push_value(i);
+  REQUIRE(drain_ints(inbox, *a) == std::vector<int>{2, 3, 4});
+}
+
+TEST_CASE("test_inbox_unbounded", "test_inbox_unbounded")
+{
+  generic_device dev{"test"};
+  auto a = create_node(dev.get_root_node(), "/a").create_parameter(val_type::INT);
+  auto b = create_node(dev.get_root_node(), "/b").create_parameter(val_type::INT);
+
+  // By default no value is dropped
+  parameter_inbox inbox{dev};
+  inbox.reg(*a);
+
+  std::vector<int> expected;
+  for(int k = 0; k < 3; k++)
+  {
+    expected.clear();
+    for(int i = 0; i < 1000 * (k + 1); i++)
+    {
+      a->push_value(i);
+      expected.push_back(i);
+    }
+    REQUIRE(drain_ints(inbox, *a) == expected);
+  }
+  REQUIRE(inbox.overflow() == 0);
+
+  // A parameter registered once without bound stays unbounded
+  inbox.reg(*b, 2);
+  inbox.reg(*b);
+  inbox.reg(*b, 2);
+  for(int i = 0; i < 100; i++)
+    b->push_value(i);
+  REQUIRE(drain_ints(inbox, *b).size() == 100);
+  REQUIRE(inbox.overflow() == 0);
+}
+
+TEST_CASE("test_inbox_removal", "test_inbox_removal")
+{
+  generic_device dev{"test"};
+  auto& node = create_node(dev.get_root_node(), "/a");
+  auto p = node.create_parameter(val_type::INT);
+
+  parameter_inbox inbox{dev};
+  inbox.reg(*p);
+  p->push_value(1);
+
+  dev.get_root_node().remove_child(node);
+
+  int calls = 0;
+  inbox.drain([&](parameter_base&, tcb::span<ossia::value>) { calls++; });
+  REQUIRE(calls == 0);
+}
+
+TEST_CASE("test_inbox_removal_reg", "test_inbox_removal_reg")
+{
+  generic_device dev{"test"};
+  parameter_inbox inbox{dev};
+
+  for(int k = 0; k < 10; k++)
+  {
+    auto& node = create_node(dev.get_root_node(), "/a");
+    auto p = node.create_parameter(val_type::INT);
+    inbox.reg(*p);
+    inbox.reg(*p);
+    p->push_value(1);
+
+    // Unregistering a removed parameter does nothing
+    dev.get_root_node().remove_child(node);
+    inbox.unreg(*p);
+
+    // A new parameter, possibly at the same address, receives its values
+    auto q = create_node(dev.get_root_node(), "/b").create_parameter(val_type::INT);
+    inbox.reg(*q);
+    q->push_value(k);
+    REQUIRE(drain_ints(inbox, *q) == std::vector<int>{k});
+
+    inbox.unreg(*q);
+    dev.get_root_node().remove_child("b");
+  }
+}
+
+TEST_CASE("test_inbox_threads", "test_inbox_threads")
+{
+  generic_device dev{"test"};
+  auto p = create_node(dev.get_root_node(), "/a").create_parameter(val_type::INT);
+
+  parameter_inbox inbox{dev};
+  inbox.reg(*p, 16);
+
+  std::atomic_bool done{};
+  std::thread t{[&] {
+    for(int i = 0; i < 100000; i++)
+      p->push_value(i);
+    done = true;
+  }};
+
+  int last = -1;
+  int64_t received = 0;
+  auto check = [&](parameter_base&, tcb::span<ossia::value> values) {
+    for(auto& v : values)
+    {
+      // Values arrive in order, possibly with gaps on overflow
+      REQUIRE(v.get<int>() > last);
+      last = v.get<int>();
+      received++;
+    }
+  };
+  while(!done)
+    inbox.drain(check);
+  t.join();
+  inbox.drain(check);
+
+  REQUIRE(last == 99999);
+  REQUIRE(received + inbox.overflow() == 100000);
+}
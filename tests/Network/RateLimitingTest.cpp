@@ -0,0 +1,196 @@
+#include <ossia/detail/algorithms.hpp>
+#include <ossia/network/base/bundle.hpp>
+#include <ossia/network/base/node_attributes.hpp>
+#include <ossia/network/base/node_functions.hpp>
+#include <ossia/network/generic/generic_device.hpp>
+#include <ossia/network/generic/generic_parameter.hpp>
+#include <ossia/network/rate_limiting_protocol.hpp>
+
+#include "include_catch.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+using namespace ossia;
+using namespace ossia::net;
+using namespace std::literals;
+
+namespace
+{
+// Records what the rate limiting protocol sends
+struct recording_protocol final : public ossia::net::protocol_base
+{
+  using protocol_base::push;
+  using protocol_base::push_bundle;
+
+  explicit recording_protocol(bool bundles)
+      : protocol_base{bundles ? flags{SupportsBundles} : flags{}}
+  {
+  }
+
+  bool pull(parameter_base&) override { return false; }
+  bool push_raw(const full_parameter_data&) override { return false; }
+  bool observe(parameter_base&, bool) override { return false; }
+  bool update(node_base&) override { return false; }
+
+  bool push(const parameter_base& p, const ossia::value& v) override
+  {
+    std::lock_guard l{mutex};
+    sent.emplace_back(&p, v);
+    return true;
+  }
+
+  bool push_bundle(tcb::span<ossia::bundle_element> b) override
+  {
+    std::lock_guard l{mutex};
+    bundles.push_back(b.size());
+    for(auto& e : b)
+      sent.emplace_back(e.parameter, e.values);
+    return true;
+  }
+
+  std::vector<ossia::value> values(const parameter_base& p)
+  {
+    std::lock_guard l{mutex};
+    std::vector<ossia::value> res;
+    for(auto& [param, v] : sent)
+      if(param == &p)
+        res.push_back(v);
+    return res;
+  }
+
+  std::mutex mutex;
+  std::vector<std::pair<const parameter_base*, ossia::value>> sent;
+  std::vector<std::size_t> bundles;
+};
+
+struct rate_limited_device
+{
+  explicit rate_limited_device(bool bundles, std::chrono::milliseconds period)
+  {
+    auto p = std::make_unique<recording_protocol>(bundles);
+    proto = p.get();
+    device = std::make_unique<generic_device>(
+        std::make_unique<rate_limiting_protocol>(period, std::move(p)), "test");
+  }
+
+  recording_protocol* proto{};
+  std::unique_ptr<generic_device> device;
+};
+}
+
+TEST_CASE("test_rate_limiting", "test_rate_limiting")
+{
+  rate_limited_device dev{false, 50ms};
+  auto p = create_node(dev.device->get_root_node(), "/a")
+               .create_parameter(val_type::INT);
+
+  for(int i = 0; i < 100; i++)
+    p->push_value(i);
+  std::this_thread::sleep_for(300ms);
+
+  auto sent = dev.proto->values(*p);
+  REQUIRE(!sent.empty());
+  REQUIRE(sent.size() < 10);
+  REQUIRE(sent.back() == ossia::value{99});
+  REQUIRE(dev.proto->bundles.empty());
+}
+
+TEST_CASE("test_rate_limiting_critical", "test_rate_limiting_critical")
+{
+  rate_limited_device dev{false, 50ms};
+  auto p = create_node(dev.device->get_root_node(), "/a")
+               .create_parameter(val_type::INT);
+  p->set_critical(true);
+
+  // Critical parameters are sent synchronously
+  for(int i = 0; i < 100; i++)
+    p->push_value(i);
+  REQUIRE(dev.proto->values(*p).size() == 100);
+}
+
+TEST_CASE("test_rate_limiting_period", "test_rate_limiting_period")
+{
+  rate_limited_device dev{false, 20ms};
+  auto& root = dev.device->get_root_node();
+  auto fast = create_node(root, "/fast").create_parameter(val_type::INT);
+  auto& slow_node = create_node(root, "/slow");
+  auto slow = slow_node.create_parameter(val_type::INT);
+  ossia::net::set_refresh_rate(slow_node, 500);
+
+  const auto end = std::chrono::steady_clock::now() + 600ms;
+  int i = 0;
+  while(std::chrono::steady_clock::now() < end)
+  {
+    fast->push_value(i);
+    slow->push_value(i);
+    i++;
+    std::this_thread::sleep_for(1ms);
+  }
+  std::this_thread::sleep_for(600ms);
+
+  auto fast_sent = dev.proto->values(*fast);
+  auto slow_sent = dev.proto->values(*slow);
+  REQUIRE(slow_sent.size() <= 3);
+  REQUIRE(fast_sent.size() >= 5 * slow_sent.size());
+
+  // The last value is always sent eventually
+  REQUIRE(fast_sent.back() == ossia::value{i - 1});
+  REQUIRE(slow_sent.back() == ossia::value{i - 1});
+}
+
+TEST_CASE("test_rate_limiting_bundle", "test_rate_limiting_bundle")
+{
+  rate_limited_device dev{true, 50ms};
+  auto& root = dev.device->get_root_node();
+  std::vector<parameter_base*> params;
+  for(auto name : {"/a", "/b", "/c"})
+    params.push_back(create_node(root, name).create_parameter(val_type::INT));
+
+  // Values pushed to several parameters during a period are sent together
+  for(int k = 0; k < 10; k++)
+  {
+    for(auto p : params)
+      p->push_value(k);
+    std::this_thread::sleep_for(100ms);
+  }
+
+  for(auto p : params)
+    REQUIRE(dev.proto->values(*p).back() == ossia::value{9});
+
+  std::lock_guard l{dev.proto->mutex};
+  REQUIRE(!dev.proto->bundles.empty());
+  REQUIRE(ossia::any_of(dev.proto->bundles, [](auto sz) { return sz == 3; }));
+}
+
+TEST_CASE("test_rate_limiting_remove", "test_rate_limiting_remove")
+{
+  rate_limited_device dev{true, 1ms};
+  auto& root = dev.device->get_root_node();
+  auto p = create_node(root, "/a").create_parameter(val_type::INT);
+
+  std::atomic_bool running{true};
+  std::thread pusher{[&] {
+    int i = 0;
+    while(running)
+      p->push_value(i++);
+  }};
+
+  // Parameters are added, pushed to and removed while other values are sent
+  for(int k = 0; k < 200; k++)
+  {
+    auto& node = create_node(root, "/tmp");
+    auto tmp = node.create_parameter(val_type::INT);
+    for(int i = 0; i < 10; i++)
+      tmp->push_value(i);
+    if(k % 2)
+      std::this_thread::sleep_for(1ms);
+    node.remove_parameter();
+  }
+
+  running = false;
+  pusher.join();
+  std::this_thread::sleep_for(50ms);
+  REQUIRE(!dev.proto->values(*p).empty());
+}
@@ -0,0 +1,171 @@
+#include <ossia/network/base/node_functions.hpp>
+#include <ossia/network/context.hpp>
+#include <ossia/network/generic/generic_device.hpp>
+#include <ossia/network/generic/generic_parameter.hpp>
+#include <ossia/protocols/shmem/shmem_protocol.hpp>
+
+#include "include_catch.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace ossia;
+using namespace ossia::net;
+
+static shmem_configuration shmem_test_conf()
+{
+  shmem_configuration conf;
+  conf.name = "/ossia_shmem_test";
+  conf.max_parameters = 16;
+  conf.max_value_size = 64;
+  conf.max_clients = 2;
+  conf.ring_size = 4;
+  // The tests call poll() directly
+  conf.interval = {};
+  return conf;
+}
+
+TEST_CASE("test_shmem_mirror", "test_shmem_mirror")
+{
+  auto ctx = std::make_shared<ossia::net::network_context>();
+  const auto conf = shmem_test_conf();
+
+  generic_device server{std::make_unique<shmem_server_protocol>(conf), "server"};
+  auto a = create_node(server.get_root_node(), "/foo/a").create_parameter(val_type::INT);
+  a->push_value(12);
+
+  auto client_proto = std::make_unique<shmem_client_protocol>(ctx, conf);
+  auto& proto = *client_proto;
+  generic_device client{std::move(client_proto), "client"};
+
+  // Existing parameters are mirrored with their current value
+  auto ca = find_node(client.get_root_node(), "/foo/a");
+  REQUIRE(ca);
+  REQUIRE(ca->get_parameter());
+  REQUIRE(ca->get_parameter()->value() == ossia::value{12});
+
+  // Changes
+  a->push_value(34);
+  proto.poll();
+  REQUIRE(ca->get_parameter()->value() == ossia::value{34});
+
+  // New parameters
+  auto b = create_node(server.get_root_node(), "/b").create_parameter(val_type::STRING);
+  b->push_value(std::string("hello"));
+  auto c = create_node(server.get_root_node(), "/c").create_parameter(val_type::LIST);
+  c->push_value(std::vector<ossia::value>{1.f, 2, 3.5f});
+  auto d = create_node(server.get_root_node(), "/d").create_parameter(val_type::VEC3F);
+  d->push_value(ossia::vec3f{1.f, 2.f, 3.f});
+  proto.poll();
+
+  auto cb = find_node(client.get_root_node(), "/b");
+  REQUIRE(cb);
+  REQUIRE(cb->get_parameter()->value() == ossia::value{std::string("hello")});
+  auto cc = find_node(client.get_root_node(), "/c");
+  REQUIRE(cc);
+  REQUIRE(
+      cc->get_parameter()->value()
+      == ossia::value{std::vector<ossia::value>{1.f, 2.f, 3.5f}});
+  auto cd = find_node(client.get_root_node(), "/d");
+  REQUIRE(cd);
+  REQUIRE(cd->get_parameter()->value() == ossia::value{ossia::vec3f{1.f, 2.f, 3.f}});
+
+  // Parameters whose value cannot be published keep their declared type
+  create_node(server.get_root_node(), "/e").create_parameter(val_type::MAP);
+  proto.poll();
+  auto ce = find_node(client.get_root_node(), "/e");
+  REQUIRE(ce);
+  REQUIRE(ce->get_parameter()->get_value_type() == val_type::MAP);
+
+  // More changes than the ring can hold: the latest values are still read
+  for(int i = 0; i < 10; i++)
+    a->push_value(i);
+  b->push_value(std::string("world"));
+  proto.poll();
+  REQUIRE(ca->get_parameter()->value() == ossia::value{9});
+  REQUIRE(cb->get_parameter()->value() == ossia::value{std::string("world")});
+
+  // Values too large for a slot are not published
+  REQUIRE(!b->get_protocol().push(*b, std::string(100, 'x')));
+
+  // Removal
+  server.get_root_node().remove_child("b");
+  proto.poll();
+  REQUIRE(!find_node(client.get_root_node(), "/b"));
+  REQUIRE(find_node(client.get_root_node(), "/c"));
+}
+
+TEST_CASE("test_shmem_clients", "test_shmem_clients")
+{
+  auto ctx = std::make_shared<ossia::net::network_context>();
+  const auto conf = shmem_test_conf();
+
+  generic_device server{std::make_unique<shmem_server_protocol>(conf), "server"};
+  auto a = create_node(server.get_root_node(), "/a").create_parameter(val_type::FLOAT);
+
+  {
+    generic_device c1{std::make_unique<shmem_client_protocol>(ctx, conf), "c1"};
+    generic_device c2{std::make_unique<shmem_client_protocol>(ctx, conf), "c2"};
+    REQUIRE_THROWS(shmem_client_protocol{ctx, conf});
+  }
+
+  // The rings are released with the clients
+  auto client_proto = std::make_unique<shmem_client_protocol>(ctx, conf);
+  auto& proto = *client_proto;
+  generic_device client{std::move(client_proto), "client"};
+
+  a->push_value(0.5f);
+  proto.poll();
+  auto ca = find_node(client.get_root_node(), "/a");
+  REQUIRE(ca);
+  REQUIRE(ca->get_parameter()->value() == ossia::value{0.5f});
+}
+
+TEST_CASE("test_shmem_existing_segment", "test_shmem_existing_segment")
+{
+  const auto conf = shmem_test_conf();
+
+  // The segment of a running server is not replaced
+  {
+    shmem_server_protocol server{conf};
+    REQUIRE_THROWS(shmem_server_protocol{conf});
+  }
+
+  // Neither is a segment which was not created by a server
+  {
+    int fd = ::shm_open(conf.name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    REQUIRE(fd >= 0);
+    REQUIRE(::ftruncate(fd, 4096) == 0);
+    ::close(fd);
+    REQUIRE_THROWS(shmem_server_protocol{conf});
+    ::shm_unlink(conf.name.c_str());
+  }
+
+  // The segment of a server which exited without removing it is replaced
+  const pid_t child = ::fork();
+  REQUIRE(child >= 0);
+  if(child == 0)
+  {
+    try
+    {
+      new shmem_server_protocol{conf};
+    }
+    catch(...)
+    {
+    }
+    ::_exit(0);
+  }
+  ::waitpid(child, nullptr, 0);
+
+  auto ctx = std::make_shared<ossia::net::network_context>();
+  generic_device server{std::make_unique<shmem_server_protocol>(conf), "server"};
+  auto a = create_node(server.get_root_node(), "/a").create_parameter(val_type::INT);
+  a->push_value(5);
+
+  generic_device client{std::make_unique<shmem_client_protocol>(ctx, conf), "client"};
+  auto ca = find_node(client.get_root_node(), "/a");
+  REQUIRE(ca);
+  REQUIRE(ca->get_parameter()->value() == ossia::value{5});
+}
@@ -0,0 +1,161 @@
+#include <ossia/network/common/value_codec.hpp>
+#include <ossia/network/context.hpp>
+#include <ossia/network/sockets/line_framing.hpp>
+#include <ossia/network/sockets/serial_socket.hpp>
+
+#include "include_catch.hpp"
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <limits>
+
+using namespace ossia;
+using namespace ossia::net;
+
+TEST_CASE("test_value_codec_text", "test_value_codec_text")
+{
+  auto c = value_codec::text("SPD %.2f");
+  std::string str;
+  c.encode(1.5f, str);
+  REQUIRE(str == "SPD 1.50");
+
+  ossia::value v;
+  REQUIRE(c.decode("SPD 3.25\r\n", v));
+  REQUIRE(v == ossia::value{3.25f});
+  REQUIRE(!c.decode("SPD x", v));
+  REQUIRE(!c.decode("POS 3", v));
+
+  auto pos = value_codec::text("POS %d,%d %s 100%%");
+  str.clear();
+  pos.encode(std::vector<ossia::value>{12, -3.f, std::string("ok")}, str);
+  REQUIRE(str == "POS 12,-3 ok 100%");
+
+  REQUIRE(pos.decode("POS  7,-8 foo   100%", v));
+  REQUIRE(v == ossia::value{std::vector<ossia::value>{7, -8, std::string("foo")}});
+
+  REQUIRE_THROWS(value_codec::text("%q"));
+}
+
+TEST_CASE("test_value_codec_binary", "test_value_codec_binary")
+{
+  auto c = value_codec::binary(">#02#10 h H f x");
+  std::string str;
+  c.encode(ossia::vec3f{-2.f, 513.f, 1.f}, str);
+  REQUIRE(
+      str
+      == std::string("\x02\x10\xFF\xFE\x02\x01\x3F\x80\x00\x00\x00", 11));
+
+  ossia::value v;
+  REQUIRE(c.decode(str, v));
+  REQUIRE(v == ossia::value{std::vector<ossia::value>{-2, 513, 1.f}});
+
+  // Wrong header or size
+  str[0] = 0x03;
+  REQUIRE(!c.decode(str, v));
+  REQUIRE(!c.decode(std::string_view{str}.substr(0, 4), v));
+
+  auto le = value_codec::binary("<2i 4s");
+  str.clear();
+  le.encode(std::vector<ossia::value>{1, 2, std::string("ab")}, str);
+  REQUIRE(str == std::string("\x01\0\0\0\x02\0\0\0ab\0\0", 12));
+  REQUIRE(le.decode(str, v));
+  REQUIRE(v == ossia::value{std::vector<ossia::value>{1, 2, std::string("ab")}});
+
+  REQUIRE_THROWS(value_codec::binary("<z"));
+  REQUIRE_THROWS(value_codec::binary("#0"));
+}
+
+TEST_CASE("test_value_codec_range", "test_value_codec_range")
+{
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+
+  // Integer fields are saturated, NaN gives 0
+  auto c = value_codec::binary("<b B B h H");
+  std::string str;
+  c.encode(std::vector<ossia::value>{-1000, -1, 300, 70000.f, nan}, str);
+  REQUIRE(str == std::string("\x80\x00\xFF\xFF\x7F\x00\x00", 7));
+
+  auto wide = value_codec::binary("<q Q");
+  str.clear();
+  wide.encode(std::vector<ossia::value>{1e30f, -1}, str);
+  REQUIRE(
+      str
+      == std::string(
+          "\xFF\xFF\xFF\xFF\xFF\xFF\xFF\x7F\x00\x00\x00\x00\x00\x00\x00\x00", 16));
+
+  auto text = value_codec::text("%d %u %x");
+  str.clear();
+  text.encode(std::vector<ossia::value>{nan, -1, 1e30f}, str);
+  REQUIRE(str == "0 0 7fffffffffffffff");
+
+  // Integers which do not fit in an int are read as floats
+  ossia::value v;
+  auto u32 = value_codec::binary("<I q");
+  REQUIRE(u32.decode(std::string("\xFF\xFF\xFF\xFF\xFB\xFF\xFF\xFF\xFF\xFF\xFF\xFF", 12), v));
+  REQUIRE(v == ossia::value{std::vector<ossia::value>{4294967295.f, -5}});
+
+  auto d = value_codec::text("%d");
+  REQUIRE(d.decode("5000000000", v));
+  REQUIRE(v == ossia::value{5e9f});
+  REQUIRE(d.decode("-12", v));
+  REQUIRE(v == ossia::value{-12});
+}
+
+TEST_CASE("test_value_codec_pty", "test_value_codec_pty")
+{
+  // The device side of the link is the master of a pseudo-terminal
+  int master = posix_openpt(O_RDWR | O_NOCTTY);
+  REQUIRE(master >= 0);
+  REQUIRE(grantpt(master) == 0);
+  REQUIRE(unlockpt(master) == 0);
+
+  auto ctx = std::make_shared<ossia::net::network_context>();
+  serial_configuration conf;
+  conf.port = ptsname(master);
+  conf.baud_rate = 115200;
+
+  serial_socket<line_framing> sock{conf, ctx->context};
+  std::strcpy(sock.m_encoder.delimiter, "\r\n");
+  std::strcpy(sock.m_decoder.delimiter, "\r\n");
+  sock.connect();
+
+  auto out = value_codec::text("SPD %.1f");
+  auto in = value_codec::text("POS %d %d");
+
+  // Writing
+  std::string str;
+  out.encode(0.5f, str);
+  sock.write(str.data(), str.size());
+
+  char buf[64]{};
+  std::string written;
+  while(written.size() < 9)
+  {
+    auto n = ::read(master, buf, sizeof(buf));
+    REQUIRE(n > 0);
+    written.append(buf, n);
+  }
+  REQUIRE(written == "SPD 0.5\r\n");
+
+  // Reading
+  std::vector<ossia::value> received;
+  sock.receive([&](const unsigned char* data, std::size_t sz) {
+    ossia::value v;
+    if(in.decode({reinterpret_cast<const char*>(data), sz}, v))
+      received.push_back(std::move(v));
+  });
+
+  const std::string_view messages = "POS 1 2\r\nGARBAGE\r\nPOS 3 4\r\n";
+  REQUIRE(::write(master, messages.data(), messages.size()) == (ssize_t)messages.size());
+  while(received.size() < 2)
+    ctx->context.run_one();
+
+  REQUIRE(received[0] == ossia::value{std::vector<ossia::value>{1, 2}});
+  REQUIRE(received[1] == ossia::value{std::vector<ossia::value>{3, 4}});
+
+  sock.close();
+  ctx->context.poll();
+  ::close(master);
+}
@@ -9,6 +9,8 @@
 
 #include <QCoreApplication>
 #include <QTimer>
+#include <QWebSocket>
+#include <QWebSocketServer>
 
 #include "include_catch.hpp"
 
@@ -47,3 +49,51 @@ TEST_CASE("test_websockets", "test_websockets")
 
   app.exec();
 }
+
+TEST_CASE("test_websockets_codec_no_echo", "test_websockets_codec_no_echo")
+{
+  int argc{};
+  char** argv{};
+  QCoreApplication app(argc, argv);
+
+  QWebSocketServer server{"test", QWebSocketServer::NonSecureMode};
+  REQUIRE(server.listen(QHostAddress::LocalHost));
+
+  // The server sends a message matching the codec and records what it receives
+  int received = 0;
+  QObject::connect(&server, &QWebSocketServer::newConnection, [&] {
+    auto client = server.nextPendingConnection();
+    QObject::connect(
+        client, &QWebSocket::textMessageReceived, [&](const QString&) { received++; });
+    client->sendTextMessage("SPD 2.50");
+  });
+
+  ossia::context context;
+  QByteArray code = R"_(
+import QtQuick 2.0
+import Ossia 1.0
+
+QtObject
+{
+    function onMessage(message) { return [ ]; }
+    function createTree() {
+        return [ { name: "speed", type: Ossia.Float, codec: "SPD %.2f" } ];
+    }
+}
+)_";
+
+  ossia::net::ws_generic_client_device ws_device{
+      std::make_unique<ossia::net::ws_generic_client_protocol>(
+          QString("ws://127.0.0.1:%1").arg(server.serverPort()), code),
+      "test"};
+
+  QTimer::singleShot(2000, [&]() { app.exit(); });
+  app.exec();
+
+  auto node = ossia::net::find_node(ws_device, "/speed");
+  REQUIRE(node);
+  REQUIRE(node->get_parameter()->value() == ossia::value{2.5f});
+
+  // The decoded value must not be sent back to the server
+  REQUIRE(received == 0);
+}